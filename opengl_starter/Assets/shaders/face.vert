@@ -0,0 +1,35 @@
+#version 300 es
+
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+
+// same as the face shader built into Scenes.cpp, loaded from here with --hot-reload
+layout(location = 0) in vec2 aVertexPosition;
+layout(location = 1) in vec3 aVertexColor;
+
+uniform mat3 uModel;
+uniform vec4 uColor;
+
+// has to match OpenGL::FrameUniformsGLSL (FrameUniforms.hpp)
+layout(std140) uniform FrameData
+{
+    mat3  uToNDC;
+    float uTime;
+    float uDeltaTime;
+    vec2  uViewportSize;
+};
+
+out vec3 vColor;
+
+void main()
+{
+    vec3 cam_position = uModel * vec3(aVertexPosition, 1.0);
+    vec3 ndc_position = uToNDC * cam_position;
+    gl_Position = vec4(ndc_position.xy, 0.0, 1.0);
+    vColor = aVertexColor * uColor.rgb;
+}
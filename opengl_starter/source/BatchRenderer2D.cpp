@@ -0,0 +1,149 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "BatchRenderer2D.hpp"
+
+#include "FrameCapture.hpp"
+#include "GLState.hpp"
+#include "Profiler.hpp"
+#include "VertexLayout.hpp"
+#include <GL/glew.h>
+#include <algorithm>
+#include <array>
+#include <gsl/gsl>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+    // positions are already in world space, only uToNDC is left for the gpu
+    constexpr auto batch_vertex_header = R"(#version 300 es
+layout(location = 0) in vec2 aVertexPosition;
+layout(location = 1) in vec3 aVertexColor;
+)";
+
+    constexpr auto batch_vertex_body = R"(out vec3 vColor;
+void main()
+{
+    vec3 ndc_position = uToNDC * vec3(aVertexPosition, 1.0);
+    gl_Position = vec4(ndc_position.xy, 0.0, 1.0);
+    vColor = aVertexColor;
+}
+)";
+
+    constexpr auto batch_fragment_glsl = R"(#version 300 es
+precision mediump float;
+
+in vec3 vColor;
+out vec4 FragColor;
+
+void main()
+{
+    FragColor = vec4(vColor, 1.0);
+}
+)";
+
+    // unit quad, same winding as the face in setup() : 0,1,2 0,2,3
+    constexpr std::array<float, 4> unit_quad_x{ -0.5f, +0.5f, +0.5f, -0.5f };
+    constexpr std::array<float, 4> unit_quad_y{ -0.5f, -0.5f, +0.5f, +0.5f };
+
+    constexpr std::size_t streamed_batches = 4;
+}
+
+namespace OpenGL
+{
+    BatchRenderer2D::BatchRenderer2D(const FrameUniformBuffer& frame_uniforms, std::size_t max_quads_per_batch, StreamStrategy stream_strategy)
+        : maxQuads(std::clamp(max_quads_per_batch, std::size_t{ 1 }, MaxQuadsPerBatch)),
+          // a few full batches, so a wrap rarely finds the gpu still reading
+          vertices(streamed_batches * maxQuads * unit_quad_x.size() * sizeof(Vertex), stream_strategy)
+    {
+        const std::string vertex_glsl = std::string{ batch_vertex_header } + FrameUniformsGLSL + batch_vertex_body;
+        shader                        = CreateShader(std::string_view{ vertex_glsl }, std::string_view{ batch_fragment_glsl });
+        frame_uniforms.Attach(shader);
+        quads.Reserve(maxQuads);
+
+        // the index pattern never changes so build it once for the biggest batch
+        std::vector<unsigned short> indices;
+        indices.reserve(maxQuads * 6);
+        for (std::size_t quad = 0; quad < maxQuads; ++quad)
+        {
+            const auto first = static_cast<unsigned short>(quad * 4);
+            indices.insert(
+                indices.end(), { first, static_cast<unsigned short>(first + 1), static_cast<unsigned short>(first + 2), first, static_cast<unsigned short>(first + 2),
+                                 static_cast<unsigned short>(first + 3) });
+        }
+
+        // VAO 0 first, the element binding belongs to whatever VAO is bound
+        indexBuffer = CreateBuffer(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned short), indices.data());
+
+        vertexArrayObject = CreateVertexArray();
+        BindVertexArray(vertexArrayObject.Get());
+        BindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer.Get());
+        // the vertex attributes get pointed at the stream buffer in flush(), every batch lands somewhere else
+    }
+
+    BatchRenderer2D::~BatchRenderer2D()
+    {
+        DestroyShader(shader);
+    }
+
+    void BatchRenderer2D::BeginScene()
+    {
+        statistics = Statistics{};
+        quads.Clear();
+    }
+
+    void BatchRenderer2D::DrawQuad(const Math::mat3& transform, float r, float g, float b)
+    {
+        if (quads.Size() == maxQuads)
+        {
+            flush();
+        }
+        // transform * vec3(corner, 1.0) happens in flush(), for a whole batch at once
+        quads.Push(transform, r, g, b);
+        ++statistics.Quads;
+    }
+
+    void BatchRenderer2D::DrawQuad(float x, float y, float width, float height, float r, float g, float b)
+    {
+        DrawQuad(Math::mat3{ width, 0.0f, 0.0f, 0.0f, height, 0.0f, x, y, 1.0f }, r, g, b);
+    }
+
+    void BatchRenderer2D::EndScene()
+    {
+        flush();
+        vertices.EndFrame();
+    }
+
+    void BatchRenderer2D::flush()
+    {
+        if (quads.Size() == 0)
+        {
+            return;
+        }
+        PROFILE_GPU_SCOPE("batch flush"); // the same name every flush, so the overlay shows calls per frame
+
+        const std::size_t   vertex_count = quads.Size() * unit_quad_x.size();
+        StreamBuffer::Range range;
+        do // again if the driver lost the mapped vertices
+        {
+            range = vertices.Map(vertex_count * sizeof(Vertex));
+            // whatever Map() hands out is at least float aligned
+            TransformShapes(quads, unit_quad_x, unit_quad_y, reinterpret_cast<Vertex*>(range.Memory));
+        } while (!vertices.Unmap());
+
+        UseProgram(shader.Shader);
+        BindVertexArray(vertexArrayObject.Get());
+        BindBuffer(GL_ARRAY_BUFFER, vertices.GetBuffer());
+        DescribeVertexLayout(GetVertexLayout(VertexFormat::Float), 0, gsl::narrow<std::size_t>(range.Offset));
+
+        const auto index_count = gsl::narrow<GLsizei>(quads.Size() * 6);
+        DrawElements(GL_TRIANGLES, index_count, GL_UNSIGNED_SHORT, 0);
+        ++statistics.DrawCalls;
+        quads.Clear();
+    }
+}
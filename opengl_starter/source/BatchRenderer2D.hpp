@@ -0,0 +1,75 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include "FrameUniforms.hpp"
+#include "GpuResources.hpp"
+#include "Handle.hpp"
+#include "Math.hpp"
+#include "Shader.hpp"
+#include "StreamBuffer.hpp"
+#include "TransformKernel.hpp"
+#include "Vertex.hpp"
+#include <cstddef>
+
+namespace OpenGL
+{
+    // Collects quads into a CPU side array and draws as many of them as fit in one
+    // glDrawElements. The quad corners are transformed on the CPU so every quad in a batch
+    // can share the same uToNDC, which comes from the FrameData uniform block.
+    // The transforms are kept as a TransformBatch and run through the SIMD kernel at flush time,
+    // straight into the memory the StreamBuffer hands out.
+    class BatchRenderer2D
+    {
+    public:
+        // 16 bit indices -> 65536 vertices / 4 vertices per quad
+        static constexpr std::size_t MaxQuadsPerBatch = 16384;
+
+        struct Statistics
+        {
+            int DrawCalls = 0;
+            int Quads     = 0;
+        };
+
+        // stream_strategy : how the vertices get to the gpu, see StreamBuffer.hpp
+        explicit BatchRenderer2D(const FrameUniformBuffer& frame_uniforms, std::size_t max_quads_per_batch = MaxQuadsPerBatch, StreamStrategy stream_strategy = BestStreamStrategy());
+        ~BatchRenderer2D();
+
+        BatchRenderer2D(const BatchRenderer2D&)            = delete;
+        BatchRenderer2D& operator=(const BatchRenderer2D&) = delete;
+
+        void BeginScene();
+        // transform is applied to the unit quad [-0.5,+0.5]x[-0.5,+0.5]
+        void DrawQuad(const Math::mat3& transform, float r, float g, float b);
+        void DrawQuad(float x, float y, float width, float height, float r, float g, float b);
+        // flushes and fences this frame's vertices
+        void EndScene();
+
+        [[nodiscard]] const Statistics& GetStatistics() const noexcept
+        {
+            return statistics;
+        }
+
+        [[nodiscard]] StreamStrategy GetStreamStrategy() const noexcept
+        {
+            return vertices.GetStrategy();
+        }
+
+    private:
+        void flush();
+
+    private:
+        CompiledShader    shader{};
+        std::size_t       maxQuads = 0;
+        StreamBuffer      vertices;
+        BufferHandle      indexBuffer{};
+        VertexArrayHandle vertexArrayObject{};
+        TransformBatch    quads{};
+        Statistics        statistics{};
+    };
+}
@@ -0,0 +1,389 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+
+// cs200_bench : draws one of the scenes for a fixed number of frames into an offscreen framebuffer,
+// then reports cpu / gpu / frame times with percentiles. No window, no vsync, works on CI machines with llvmpipe.
+//
+// cs200_bench [--batch N | --faces N [--instanced]] [--frames N] [--warmup N] [--size W H] [--csv file] [--json file] [--trace file] [--capture file]
+// cs200_bench --record-benchmark [N] : Benchmarks::RunCommandRecordingBenchmark(N) without a window, then quit
+// cs200_bench --queue-benchmark [N] : Benchmarks::RunRenderQueueBenchmark(N), same
+// cs200_bench --atlas-benchmark [N] : Benchmarks::RunTextureAtlasBenchmark(N), same
+// cs200_bench --resource-benchmark [N] : Benchmarks::RunResourceBenchmark(N), same
+// cs200_bench --shape-benchmark [N] : Benchmarks::RunShapeCacheBenchmark(N), same
+//
+// --capture file records every frame, warmup included, for cs200_replay (FrameCapture.hpp).
+// Developer builds also print the profiling scopes (Profiler.hpp) averaged over the measured frames.
+
+#include "Benchmarks.hpp"
+#include "FrameCapture.hpp"
+#include "HeadlessContext.hpp"
+#include "Profiler.hpp"
+#include "Scenes.hpp"
+#include <GL/glew.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+    // results for frame N get read back at frame N + QueryLatency, by then the gpu is done with it
+    // and reading it doesn't stall. It also keeps the cpu from running more than that many frames ahead.
+    constexpr std::size_t QueryLatency = 4;
+
+    // every frame simulates the same step no matter how long it took, so two runs draw the same frames
+    constexpr double SimulatedStep = 1.0 / 60.0;
+
+    struct FrameSample
+    {
+        double CpuMs   = 0.0; // inside draw_frame()
+        double GpuMs   = 0.0; // GL_TIME_ELAPSED around draw_frame()
+        double FrameMs = 0.0; // start of this frame to start of the next
+    };
+
+    struct Summary
+    {
+        double Mean = 0.0;
+        double P50  = 0.0;
+        double P95  = 0.0;
+        double P99  = 0.0;
+        double Min  = 0.0;
+        double Max  = 0.0;
+    };
+
+    // nearest rank
+    [[nodiscard]] double percentile(const std::vector<double>& sorted, double percent)
+    {
+        const auto rank = static_cast<std::size_t>(std::ceil(percent / 100.0 * static_cast<double>(sorted.size())));
+        return sorted[std::clamp(rank, std::size_t{ 1 }, sorted.size()) - 1];
+    }
+
+    [[nodiscard]] Summary summarize(const std::vector<FrameSample>& samples, double FrameSample::*field)
+    {
+        std::vector<double> values;
+        values.reserve(samples.size());
+        for (const auto& sample : samples)
+        {
+            values.push_back(sample.*field);
+        }
+        if (values.empty())
+        {
+            return {};
+        }
+        std::sort(values.begin(), values.end());
+        double total = 0.0;
+        for (const double value : values)
+        {
+            total += value;
+        }
+        return Summary{ total / static_cast<double>(values.size()), percentile(values, 50.0), percentile(values, 95.0), percentile(values, 99.0), values.front(), values.back() };
+    }
+
+    [[nodiscard]] std::string json_escaped(std::string_view text)
+    {
+        std::string escaped;
+        for (const char c : text)
+        {
+            if (c == '"' || c == '\\')
+            {
+                escaped += '\\';
+            }
+            escaped += c;
+        }
+        return escaped;
+    }
+
+    void write_summary_json(std::ostream& out, std::string_view name, const Summary& summary)
+    {
+        out << "  \"" << name << "\": { \"mean\": " << summary.Mean << ", \"p50\": " << summary.P50 << ", \"p95\": " << summary.P95 << ", \"p99\": " << summary.P99
+            << ", \"min\": " << summary.Min << ", \"max\": " << summary.Max << " },\n";
+    }
+
+    void print_summary(std::string_view name, const Summary& summary)
+    {
+        std::cout << name << " ms | mean: " << summary.Mean << " p50: " << summary.P50 << " p95: " << summary.P95 << " p99: " << summary.P99 << " max: " << summary.Max << '\n';
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    int         frames          = 500;
+    int         warmup_frames   = 30;
+    std::string csv_path;
+    std::string json_path;
+    std::string trace_path;
+    std::string capture_path;
+    int         record_objects  = 0; // --record-benchmark
+    int         queue_draws     = 0; // --queue-benchmark
+    int         atlas_images    = 0; // --atlas-benchmark
+    int         resource_meshes = 0; // --resource-benchmark
+    int         shape_count     = 0; // --shape-benchmark
+    // a value that isn't a number is reported like an unknown option instead of ending in std::terminate
+    try
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string_view arg = argv[i];
+            if (parse_scene_option(argc, argv, i))
+            {
+                continue;
+            }
+            if (arg == "--frames" && i + 1 < argc)
+            {
+                frames = std::max(1, parse_int_option(arg, argv[++i]));
+            }
+            else if (arg == "--warmup" && i + 1 < argc)
+            {
+                warmup_frames = std::max(0, parse_int_option(arg, argv[++i]));
+            }
+            else if (arg == "--size" && i + 2 < argc)
+            {
+                gWidth  = std::max(1, parse_int_option(arg, argv[++i]));
+                gHeight = std::max(1, parse_int_option(arg, argv[++i]));
+            }
+            else if (arg == "--csv" && i + 1 < argc)
+            {
+                csv_path = argv[++i];
+            }
+            else if (arg == "--json" && i + 1 < argc)
+            {
+                json_path = argv[++i];
+            }
+            else if (arg == "--trace" && i + 1 < argc)
+            {
+                trace_path = argv[++i];
+            }
+            else if (arg == "--capture" && i + 1 < argc)
+            {
+                capture_path = argv[++i];
+            }
+            else if (arg == "--record-benchmark")
+            {
+                record_objects = (i + 1 < argc) ? std::max(1, parse_int_option(arg, argv[++i])) : 100'000;
+            }
+            else if (arg == "--queue-benchmark")
+            {
+                queue_draws = (i + 1 < argc) ? std::max(1, parse_int_option(arg, argv[++i])) : 50'000;
+            }
+            else if (arg == "--atlas-benchmark")
+            {
+                atlas_images = (i + 1 < argc) ? std::max(1, parse_int_option(arg, argv[++i])) : 2000;
+            }
+            else if (arg == "--resource-benchmark")
+            {
+                resource_meshes = (i + 1 < argc) ? std::max(4, parse_int_option(arg, argv[++i])) : 1000;
+            }
+            else if (arg == "--shape-benchmark")
+            {
+                shape_count = (i + 1 < argc) ? std::max(1, parse_int_option(arg, argv[++i])) : 100'000;
+            }
+            else
+            {
+                std::cout << "unknown option " << arg << '\n';
+                return 1;
+            }
+        }
+    }
+    catch (const std::invalid_argument& e)
+    {
+        std::cout << e.what() << '\n';
+        return 1;
+    }
+
+    try
+    {
+        OpenGL::HeadlessContext context(gWidth, gHeight);
+        const std::string       renderer = context.Describe();
+        std::cout << renderer << '\n';
+        if (record_objects > 0)
+        {
+            Benchmarks::RunCommandRecordingBenchmark(record_objects);
+            return 0;
+        }
+        if (queue_draws > 0)
+        {
+            Benchmarks::RunRenderQueueBenchmark(queue_draws);
+            return 0;
+        }
+        if (atlas_images > 0)
+        {
+            Benchmarks::RunTextureAtlasBenchmark(atlas_images);
+            return 0;
+        }
+        if (resource_meshes > 0)
+        {
+            Benchmarks::RunResourceBenchmark(resource_meshes);
+            return 0;
+        }
+        if (shape_count > 0)
+        {
+            Benchmarks::RunShapeCacheBenchmark(shape_count);
+            return 0;
+        }
+
+        if (!capture_path.empty())
+        {
+            OpenGL::StartCapture(capture_path, warmup_frames + frames);
+        }
+        setup();
+        for (int frame = 0; frame < warmup_frames; ++frame)
+        {
+            update_scene(SimulatedStep);
+            draw_frame();
+        }
+        glFinish();
+
+        // core since 3.3, but some drivers still don't count anything
+        const bool                       has_gpu_timer = GLEW_ARB_timer_query;
+        std::array<GLuint, QueryLatency> queries{};
+        std::vector<FrameSample>         samples(static_cast<std::size_t>(frames));
+        if (has_gpu_timer)
+        {
+            glGenQueries(static_cast<GLsizei>(queries.size()), queries.data());
+        }
+        const auto read_gpu_time = [&](std::size_t frame)
+        {
+            GLuint64 nanoseconds = 0;
+            glGetQueryObjectui64v(queries[frame % QueryLatency], GL_QUERY_RESULT, &nanoseconds);
+            samples[frame].GpuMs = static_cast<double>(nanoseconds) / 1'000'000.0;
+        };
+
+        using clock      = std::chrono::steady_clock;
+        using ms         = std::chrono::duration<double, std::milli>;
+        auto frame_start = clock::now();
+        for (std::size_t frame = 0; frame < samples.size(); ++frame)
+        {
+            PROFILE_BEGIN_FRAME();
+            if (has_gpu_timer)
+            {
+                if (frame >= QueryLatency)
+                {
+                    read_gpu_time(frame - QueryLatency);
+                }
+                glBeginQuery(GL_TIME_ELAPSED, queries[frame % QueryLatency]);
+            }
+            update_scene(SimulatedStep);
+            const auto cpu_start = clock::now();
+            draw_frame();
+            samples[frame].CpuMs = ms(clock::now() - cpu_start).count();
+            if (has_gpu_timer)
+            {
+                glEndQuery(GL_TIME_ELAPSED);
+            }
+            // nothing to swap, flush so the gpu starts on it like SDL_GL_SwapWindow would make it
+            glFlush();
+            PROFILE_END_FRAME();
+
+            const auto next_start  = clock::now();
+            samples[frame].FrameMs = ms(next_start - frame_start).count();
+            frame_start            = next_start;
+        }
+        if (has_gpu_timer)
+        {
+            for (std::size_t frame = samples.size() - std::min(samples.size(), QueryLatency); frame < samples.size(); ++frame)
+            {
+                read_gpu_time(frame);
+            }
+            glDeleteQueries(static_cast<GLsizei>(queries.size()), queries.data());
+        }
+
+        OpenGL::StopCapture();
+
+        const Summary cpu   = summarize(samples, &FrameSample::CpuMs);
+        const Summary gpu   = summarize(samples, &FrameSample::GpuMs);
+        const Summary frame = summarize(samples, &FrameSample::FrameMs);
+        std::cout << scene_label() << ": " << gFrameStats.Objects << " | draw calls: " << gFrameStats.DrawCalls << " | " << frames << " frames at " << gWidth << 'x' << gHeight
+                  << '\n';
+        print_summary("cpu", cpu);
+        if (has_gpu_timer)
+        {
+            print_summary("gpu", gpu);
+        }
+        print_summary("frame", frame);
+#ifdef DEVELOPER_VERSION
+        for (const auto& scope : Profiling::AverageScopes(samples.size()))
+        {
+            std::cout << std::string(static_cast<std::size_t>(scope.Depth) * 2, ' ') << scope.Name << " | calls: " << scope.Calls << " cpu ms: " << scope.CpuMs;
+            if (scope.GpuMs >= 0.0)
+            {
+                std::cout << " gpu ms: " << scope.GpuMs;
+            }
+            std::cout << '\n';
+        }
+        if (!trace_path.empty())
+        {
+            Profiling::WriteChromeTrace(trace_path);
+        }
+#else
+        if (!trace_path.empty())
+        {
+            std::cout << "--trace needs a developer build, the profiling scopes are compiled out\n";
+        }
+#endif
+
+        if (!csv_path.empty())
+        {
+            std::ofstream csv(csv_path);
+            csv << "frame,cpu_ms,gpu_ms,frame_ms\n";
+            for (std::size_t i = 0; i < samples.size(); ++i)
+            {
+                csv << i << ',' << samples[i].CpuMs << ',';
+                if (has_gpu_timer)
+                {
+                    csv << samples[i].GpuMs;
+                }
+                csv << ',' << samples[i].FrameMs << '\n';
+            }
+        }
+        if (!json_path.empty())
+        {
+            std::ofstream json(json_path);
+            json << "{\n";
+            json << "  \"scene\": \"" << scene_label() << "\",\n";
+            json << "  \"renderer\": \"" << json_escaped(renderer) << "\",\n";
+            json << "  \"objects\": " << gFrameStats.Objects << ",\n";
+            json << "  \"draw_calls\": " << gFrameStats.DrawCalls << ",\n";
+            json << "  \"width\": " << gWidth << ",\n";
+            json << "  \"height\": " << gHeight << ",\n";
+            json << "  \"frames\": " << frames << ",\n";
+            write_summary_json(json, "cpu_ms", cpu);
+            if (has_gpu_timer)
+            {
+                write_summary_json(json, "gpu_ms", gpu);
+            }
+            write_summary_json(json, "frame_ms", frame);
+            json << "  \"samples\": [\n";
+            for (std::size_t i = 0; i < samples.size(); ++i)
+            {
+                json << "    { \"cpu_ms\": " << samples[i].CpuMs;
+                if (has_gpu_timer)
+                {
+                    json << ", \"gpu_ms\": " << samples[i].GpuMs;
+                }
+                json << ", \"frame_ms\": " << samples[i].FrameMs << " }" << (i + 1 < samples.size() ? ",\n" : "\n");
+            }
+            json << "  ]\n}\n";
+        }
+
+        shutdown();
+        Profiling::Shutdown();
+    }
+    catch (const std::exception& e)
+    {
+        std::cout << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,1638 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "Benchmarks.hpp"
+
+#include "CommandBuffer.hpp"
+#include "FileLoader.hpp"
+#include "GLState.hpp"
+#include "GpuResources.hpp"
+#include "Image.hpp"
+#include "JobSystem.hpp"
+#include "MappedFile.hpp"
+#include "Math.hpp"
+#include "Mesh.hpp"
+#include "MeshFile.hpp"
+#include "MeshImport.hpp"
+#include "Shader.hpp"
+#include "ShaderHotReload.hpp"
+#include "ShaderLibrary.hpp"
+#include "ShapeCache.hpp"
+#include "SpatialGrid.hpp"
+#include "StreamBuffer.hpp"
+#include "TextureAtlas.hpp"
+#include "TransformKernel.hpp"
+#include "Uniform.hpp"
+#include "VertexLayout.hpp"
+#include <GL/glew.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <numbers>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    using clock = std::chrono::steady_clock;
+
+    [[nodiscard]] double milliseconds_since(clock::time_point start) noexcept
+    {
+        return std::chrono::duration<double, std::milli>(clock::now() - start).count();
+    }
+
+    // runs work until a quarter second went by, returns ms per run
+    template <typename Work>
+    [[nodiscard]] double milliseconds_per_run(Work work)
+    {
+        const auto start = clock::now();
+        int        runs  = 0;
+        double     ms    = 0.0;
+        do
+        {
+            work();
+            ++runs;
+            ms = milliseconds_since(start);
+        } while (ms < 250.0);
+        return ms / runs;
+    }
+
+    // programs are built from a small pool of stages like a real game would,
+    // so program i uses vertex variant i % 8 and fragment variant i / 8 % 8.
+    // salt keeps the driver's own disk cache (mesa has one) from answering for us
+    constexpr int stage_variants = 8;
+
+    [[nodiscard]] std::string synthetic_vertex_glsl(int variant, long long salt)
+    {
+        return "#version 300 es\n// salt " + std::to_string(salt) + R"(
+layout(location = 0) in vec2 aVertexPosition;
+layout(location = 1) in vec3 aVertexColor;
+uniform mat3 uModel;
+uniform mat3 uToNDC;
+out vec3 vColor;
+void main()
+{
+    vec3 position = uModel * vec3(aVertexPosition, 1.0);
+    for (int i = 0; i < )" + std::to_string(variant + 2) + R"(; ++i)
+    {
+        position.xy += 0.01 * sin(position.yx * float(i));
+    }
+    gl_Position = vec4((uToNDC * position).xy, 0.0, 1.0);
+    vColor = aVertexColor * )" + std::to_string(variant + 1) + R"(.0;
+}
+)";
+    }
+
+    [[nodiscard]] std::string synthetic_fragment_glsl(int variant, long long salt)
+    {
+        return "#version 300 es\n// salt " + std::to_string(salt) + R"(
+precision mediump float;
+in vec3 vColor;
+uniform float uTime;
+out vec4 FragColor;
+void main()
+{
+    vec3 color = vColor;
+    for (int i = 0; i < )" + std::to_string(variant + 2) + R"(; ++i)
+    {
+        color = abs(sin(color * 3.0 + uTime * float(i)));
+    }
+    FragColor = vec4(color, 1.0);
+}
+)";
+    }
+
+    // nothing but the vertex fetch : model space is already clip space
+    constexpr auto passthrough_vertex_glsl = R"(#version 300 es
+layout(location = 0) in vec2 aVertexPosition;
+layout(location = 1) in vec3 aVertexColor;
+out vec3 vColor;
+void main()
+{
+    gl_Position = vec4(aVertexPosition, 0.0, 1.0);
+    vColor = aVertexColor;
+}
+)";
+
+    // reads one vec4 per vertex and puts every vertex on the same spot : the draw touches the streamed
+    // memory like a real one would, but nothing gets rasterized
+    constexpr auto stream_vertex_glsl = R"(#version 300 es
+layout(location = 0) in vec4 aValue;
+void main()
+{
+    gl_Position = vec4(aValue.xy * 0.0, 0.0, 1.0);
+}
+)";
+
+    constexpr auto stream_fragment_glsl = R"(#version 300 es
+precision mediump float;
+out vec4 FragColor;
+void main()
+{
+    FragColor = vec4(1.0);
+}
+)";
+
+    constexpr auto passthrough_fragment_glsl = R"(#version 300 es
+precision mediump float;
+in vec3 vColor;
+out vec4 FragColor;
+void main()
+{
+    FragColor = vec4(vColor, 1.0);
+}
+)";
+
+    // random spinning, stretched objects spread over the window
+    [[nodiscard]] OpenGL::TransformBatch random_transform_batch(std::size_t count, std::mt19937& random)
+    {
+        std::uniform_real_distribution<float> position(-400.0f, 400.0f);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        OpenGL::TransformBatch                batch;
+        batch.Reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const auto model = Math::Multiply(
+                Math::TranslationMatrix(position(random), position(random)), Math::Multiply(Math::RotationMatrix(6.28f * unit(random)), Math::ScaleMatrix(1.0f + 31.0f * unit(random), 1.0f + 31.0f * unit(random))));
+            batch.Push(model, unit(random), unit(random), unit(random));
+        }
+        return batch;
+    }
+
+    // largest relative position error of a path against the scalar one, colors have to be exact
+    struct TransformCheck
+    {
+        double MaxError = 0.0;
+        bool   Matches  = true;
+    };
+
+    [[nodiscard]] TransformCheck check_transform_path(const OpenGL::TransformBatch& batch, std::span<const float> shape_x, std::span<const float> shape_y, OpenGL::SimdPath path)
+    {
+        const std::size_t           vertices = batch.Size() * shape_x.size();
+        std::vector<OpenGL::Vertex> expected(vertices);
+        std::vector<OpenGL::Vertex> result(vertices);
+        OpenGL::TransformShapes(batch, shape_x, shape_y, expected.data(), OpenGL::SimdPath::Scalar);
+        OpenGL::TransformShapes(batch, shape_x, shape_y, result.data(), path);
+        // FMA rounds once instead of twice, so allow a little relative error
+        TransformCheck check;
+        bool           colors_ok = true;
+        for (std::size_t v = 0; v < vertices; ++v)
+        {
+            const double scale = 1.0 + std::abs(static_cast<double>(expected[v].x)) + std::abs(static_cast<double>(expected[v].y));
+            check.MaxError     = std::max({ check.MaxError, std::abs(static_cast<double>(result[v].x - expected[v].x)) / scale,
+                                            std::abs(static_cast<double>(result[v].y - expected[v].y)) / scale });
+            colors_ok          = colors_ok && result[v].r == expected[v].r && result[v].g == expected[v].g && result[v].b == expected[v].b;
+        }
+        check.Matches = check.MaxError < 1e-6 && colors_ok;
+        return check;
+    }
+
+    constexpr std::array all_simd_paths{ OpenGL::SimdPath::Scalar, OpenGL::SimdPath::SSE2, OpenGL::SimdPath::AVX2, OpenGL::SimdPath::WasmSimd128 };
+}
+
+namespace Benchmarks
+{
+    void RunShaderLibraryBenchmark(int program_count)
+    {
+        const long long salt = clock::now().time_since_epoch().count();
+
+        std::vector<std::string> vertex_sources;
+        std::vector<std::string> fragment_sources;
+        for (int variant = 0; variant < stage_variants; ++variant)
+        {
+            vertex_sources.push_back(synthetic_vertex_glsl(variant, salt));
+            fragment_sources.push_back(synthetic_fragment_glsl(variant, salt));
+        }
+
+        // serial : what setup() does today, each CreateShader waits for its own compile and link
+        // a different salt so the second pass doesn't get the first one's work for free
+        std::vector<std::string> serial_vertex_sources;
+        std::vector<std::string> serial_fragment_sources;
+        for (int variant = 0; variant < stage_variants; ++variant)
+        {
+            serial_vertex_sources.push_back(synthetic_vertex_glsl(variant, salt + 1));
+            serial_fragment_sources.push_back(synthetic_fragment_glsl(variant, salt + 1));
+        }
+        OpenGL::DisableShaderCache();
+        const auto                          serial_start = clock::now();
+        std::vector<OpenGL::CompiledShader> serial_programs;
+        for (int i = 0; i < program_count; ++i)
+        {
+            const auto v = static_cast<std::size_t>(i % stage_variants);
+            const auto f = static_cast<std::size_t>(i / stage_variants % stage_variants);
+            serial_programs.push_back(OpenGL::CreateShader(std::string_view{ serial_vertex_sources[v] }, std::string_view{ serial_fragment_sources[f] }));
+        }
+        const double serial_ms = milliseconds_since(serial_start);
+        for (auto& program : serial_programs)
+        {
+            OpenGL::DestroyShader(program);
+        }
+
+        // the library does two things at once : it doesn't wait on each program, and it compiles identical stages once.
+        // Timed apart : first with every program's stages made unique so there is nothing to share, then with the same sources
+        // as serial would have used. unique against serial is the waiting, shared against unique is the sharing
+        struct LibraryRun
+        {
+            double                            Ms       = 0.0;
+            double                            SubmitMs = 0.0;
+            OpenGL::ShaderLibrary::Statistics Stats{};
+        };
+        const auto run_library = [program_count](const auto& vertex_source, const auto& fragment_source)
+        {
+            LibraryRun            run;
+            const auto            start = clock::now();
+            OpenGL::ShaderLibrary library;
+            for (int i = 0; i < program_count; ++i)
+            {
+                (void)library.Add(std::string_view{ vertex_source(i) }, std::string_view{ fragment_source(i) });
+            }
+            run.SubmitMs = milliseconds_since(start);
+            library.FinishAll();
+            run.Ms    = milliseconds_since(start);
+            run.Stats = library.GetStatistics();
+            return run;
+        };
+
+        // same shapes of shaders as serial, only the salt changes, so the compiler does the same amount of work
+        std::vector<std::string> unique_vertex_sources;
+        std::vector<std::string> unique_fragment_sources;
+        for (int i = 0; i < program_count; ++i)
+        {
+            unique_vertex_sources.push_back(synthetic_vertex_glsl(i % stage_variants, salt + 2 + i));
+            unique_fragment_sources.push_back(synthetic_fragment_glsl(i / stage_variants % stage_variants, salt + 2 + i));
+        }
+        const auto unique = run_library([&](int i) -> const std::string& { return unique_vertex_sources[static_cast<std::size_t>(i)]; },
+                                        [&](int i) -> const std::string& { return unique_fragment_sources[static_cast<std::size_t>(i)]; });
+
+        const auto shared = run_library([&](int i) -> const std::string& { return vertex_sources[static_cast<std::size_t>(i % stage_variants)]; },
+                                        [&](int i) -> const std::string& { return fragment_sources[static_cast<std::size_t>(i / stage_variants % stage_variants)]; });
+
+        const auto print_run = [](std::string_view name, const LibraryRun& run)
+        {
+            std::cout << "  " << name << run.Ms << " ms (submit " << run.SubmitMs << " ms, " << run.Stats.StagesCompiled << " stage compiles, " << run.Stats.StagesShared
+                      << " shared)\n";
+        };
+        std::cout << "shader library benchmark : " << program_count << " programs, parallel compile " << (OpenGL::ShaderLibrary::HasParallelCompile() ? "on" : "off") << '\n'
+                  << "  serial           : " << serial_ms << " ms (" << program_count * 2 << " stage compiles)\n";
+        print_run("library, unique  : ", unique);
+        print_run("library, shared  : ", shared);
+        std::cout << "  not waiting on each program : x" << serial_ms / unique.Ms << " (serial / unique)\n"
+                  << "  sharing identical stages    : x" << unique.Ms / shared.Ms << " (unique / shared)\n";
+    }
+
+    void RunUniformLookupBenchmark(int set_count)
+    {
+        auto shader = OpenGL::CreateShader(std::string_view{ synthetic_vertex_glsl(0, 0) }, std::string_view{ synthetic_fragment_glsl(0, 0) });
+        OpenGL::UseProgram(shader.Shader);
+
+        // every set gets a different matrix so nothing can be skipped, except in the "same value" run
+        const auto matrix_for = [](int i) { return Math::TranslationMatrix(static_cast<float>(i & 1023), 0.0f); };
+        const auto ns_per_set = [set_count](double ms) { return ms * 1'000'000.0 / set_count; };
+
+        // lookups alone, the sum and the volatile id keep the optimizer from hoisting or throwing them away
+        long long                  checksum = 0;
+        volatile OpenGL::UniformID model_id = OpenGL::UniformIDs::uModel;
+        auto                       start    = clock::now();
+        for (int i = 0; i < set_count; ++i)
+        {
+            checksum += shader.UniformLocations.at("uModel") + 1;
+        }
+        const double map_lookup_ms = milliseconds_since(start);
+        start                      = clock::now();
+        for (int i = 0; i < set_count; ++i)
+        {
+            checksum += shader.UniformSlots[model_id].Location + 1;
+        }
+        const double id_lookup_ms = milliseconds_since(start);
+
+        // lookup + upload
+        start = clock::now();
+        for (int i = 0; i < set_count; ++i)
+        {
+            const auto model = matrix_for(i);
+            glUniformMatrix3fv(shader.UniformLocations.at("uModel"), 1, GL_FALSE, model.data());
+        }
+        const double map_set_ms = milliseconds_since(start);
+
+        OpenGL::GetUniformStatistics() = {};
+        start                          = clock::now();
+        for (int i = 0; i < set_count; ++i)
+        {
+            OpenGL::SetUniform(shader, OpenGL::UniformIDs::uModel, matrix_for(i));
+        }
+        const double id_set_ms = milliseconds_since(start);
+
+        start = clock::now();
+        for (int i = 0; i < set_count; ++i)
+        {
+            OpenGL::SetUniform(shader, OpenGL::UniformIDs::uToNDC, matrix_for(0));
+        }
+        const double id_same_ms = milliseconds_since(start);
+        const auto   uniforms   = OpenGL::GetUniformStatistics();
+
+        OpenGL::DestroyShader(shader);
+
+        std::cout << "uniform lookup benchmark : " << set_count << " sets (checksum " << checksum << ")\n"
+                  << "  lookup only  string map : " << ns_per_set(map_lookup_ms) << " ns/set | id : " << ns_per_set(id_lookup_ms) << " ns/set\n"
+                  << "  mat3 upload  string map : " << ns_per_set(map_set_ms) << " ns/set | id : " << ns_per_set(id_set_ms) << " ns/set\n"
+                  << "  same value   id         : " << ns_per_set(id_same_ms) << " ns/set (" << uniforms.Uploads << " uploads, " << uniforms.Skipped << " skipped)\n";
+    }
+
+    bool RunTransformKernelBenchmark(int object_count)
+    {
+        // same unit quad BatchRenderer2D uses
+        constexpr std::array<float, 4> quad_x{ -0.5f, +0.5f, +0.5f, -0.5f };
+        constexpr std::array<float, 4> quad_y{ -0.5f, -0.5f, +0.5f, +0.5f };
+        const auto                     objects  = static_cast<std::size_t>(object_count);
+        const auto                     vertices = objects * quad_x.size();
+
+        std::mt19937 random{ 200 };
+        const auto   batch     = random_transform_batch(objects, random);
+        bool         all_match = true;
+
+        // the tails : object counts that leave lanes of a 4 and 8 wide path empty, and a shape longer than
+        // the 16 points the kernel does per chunk (BatchRenderer2D only ever sends quads)
+        std::array<float, 37> circle_x{};
+        std::array<float, 37> circle_y{};
+        for (std::size_t j = 0; j < circle_x.size(); ++j)
+        {
+            const float angle = 2.0f * std::numbers::pi_v<float> * static_cast<float>(j) / static_cast<float>(circle_x.size());
+            circle_x[j]       = 0.5f * std::cos(angle);
+            circle_y[j]       = 0.5f * std::sin(angle);
+        }
+        for (const std::size_t count : { std::size_t{ 1 }, std::size_t{ 3 }, std::size_t{ 7 }, std::size_t{ 9 }, std::size_t{ 13 }, std::size_t{ 1001 } })
+        {
+            const auto odd_batch = random_transform_batch(count, random);
+            for (const auto path : all_simd_paths)
+            {
+                if (!OpenGL::IsSimdPathSupported(path))
+                {
+                    continue;
+                }
+                const auto quads   = check_transform_path(odd_batch, quad_x, quad_y, path);
+                const auto circles = check_transform_path(odd_batch, circle_x, circle_y, path);
+                if (!quads.Matches || !circles.Matches)
+                {
+                    all_match = false;
+                    std::cout << "  MISMATCH " << OpenGL::ToString(path) << " : " << count << " objects, max relative error " << quads.MaxError << " for quads, "
+                              << circles.MaxError << " for " << circle_x.size() << " point shapes\n";
+                }
+            }
+        }
+
+        // keeps going until it has at least a quarter second worth, returns vertices per second
+        const auto measure = [&](OpenGL::Vertex* out, OpenGL::SimdPath path)
+        {
+            const auto start  = clock::now();
+            int        rounds = 0;
+            double     ms     = 0.0;
+            do
+            {
+                OpenGL::TransformShapes(batch, quad_x, quad_y, out, path);
+                ++rounds;
+                ms = milliseconds_since(start);
+            } while (ms < 250.0);
+            return static_cast<double>(vertices) * rounds / (ms / 1000.0);
+        };
+
+        std::cout << "transform kernel benchmark : " << objects << " quads, " << vertices << " vertices, best path " << OpenGL::ToString(OpenGL::BestSimdPath()) << '\n';
+        if (all_match)
+        {
+            std::cout << "  1 to 1001 objects, quads and " << circle_x.size() << " point shapes : every path matches scalar\n";
+        }
+        double scalar_rate = 0.0;
+        for (const auto path : all_simd_paths)
+        {
+            if (!OpenGL::IsSimdPathSupported(path))
+            {
+                continue;
+            }
+            const auto                  check = check_transform_path(batch, quad_x, quad_y, path);
+            std::vector<OpenGL::Vertex> result(vertices);
+            const double                rate = measure(result.data(), path);
+            if (path == OpenGL::SimdPath::Scalar)
+            {
+                scalar_rate = rate;
+            }
+            all_match = all_match && check.Matches;
+            std::cout << "  " << OpenGL::ToString(path) << " : " << rate / 1'000'000.0 << " M vertices/s (x" << rate / scalar_rate << ") | "
+                      << (check.Matches ? "matches scalar" : "MISMATCH") << " (max relative error " << check.MaxError << ")\n";
+        }
+
+#if !defined(__EMSCRIPTEN__)
+        // the real destination : write combined memory the driver hands out, no staging copy
+        OpenGL::Handle buffer = 0;
+        glGenBuffers(1, &buffer);
+        OpenGL::BindBuffer(GL_ARRAY_BUFFER, buffer);
+        const auto bytes = static_cast<GLsizeiptr>(vertices * sizeof(OpenGL::Vertex));
+        glBufferData(GL_ARRAY_BUFFER, bytes, nullptr, GL_STREAM_DRAW);
+        const auto mapped_start  = clock::now();
+        int        mapped_rounds = 0;
+        double     mapped_ms     = 0.0;
+        do
+        {
+            auto* out = static_cast<OpenGL::Vertex*>(glMapBufferRange(GL_ARRAY_BUFFER, 0, bytes, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+            if (out == nullptr)
+            {
+                break;
+            }
+            OpenGL::TransformShapes(batch, quad_x, quad_y, out);
+            glUnmapBuffer(GL_ARRAY_BUFFER);
+            ++mapped_rounds;
+            mapped_ms = milliseconds_since(mapped_start);
+        } while (mapped_ms < 250.0);
+        OpenGL::DeleteBuffer(buffer);
+        if (mapped_rounds > 0)
+        {
+            std::cout << "  " << OpenGL::ToString(OpenGL::BestSimdPath()) << " into a mapped buffer : " << static_cast<double>(vertices) * mapped_rounds / (mapped_ms / 1000.0) / 1'000'000.0
+                      << " M vertices/s (map + unmap included)\n";
+        }
+#endif
+        return all_match;
+    }
+
+    void RunVertexFormatBenchmark(int vertex_count)
+    {
+        // grid of small quads covering [-1,1], each quad has its own 4 vertices like the face does
+        const int   side  = std::max(1, static_cast<int>(std::sqrt(static_cast<double>(vertex_count) / 4.0)));
+        const float cell  = 2.0f / static_cast<float>(side);
+        const float inset = 0.25f * cell;
+
+        std::vector<OpenGL::Vertex> vertices;
+        std::vector<std::uint32_t>  indices;
+        vertices.reserve(static_cast<std::size_t>(side * side * 4));
+        indices.reserve(static_cast<std::size_t>(side * side * 6));
+        for (int row = 0; row < side; ++row)
+        {
+            for (int column = 0; column < side; ++column)
+            {
+                const float left   = -1.0f + static_cast<float>(column) * cell + inset;
+                const float bottom = -1.0f + static_cast<float>(row) * cell + inset;
+                const float right  = left + cell - 2.0f * inset;
+                const float top    = bottom + cell - 2.0f * inset;
+                const float r      = static_cast<float>(column) / static_cast<float>(side);
+                const float g      = static_cast<float>(row) / static_cast<float>(side);
+                const auto  first  = static_cast<std::uint32_t>(vertices.size());
+                vertices.insert(vertices.end(), { { left, bottom, r, g, 0.5f }, { right, bottom, r, g, 0.5f }, { right, top, r, g, 0.5f }, { left, top, r, g, 0.5f } });
+                indices.insert(indices.end(), { first, first + 1, first + 2, first, first + 2, first + 3 });
+            }
+        }
+
+        auto shader = OpenGL::CreateShader(std::string_view{ passthrough_vertex_glsl }, std::string_view{ passthrough_fragment_glsl });
+        OpenGL::UseProgram(shader.Shader);
+        const auto index_type = OpenGL::ChooseIndexType(vertices.size());
+        std::cout << "vertex format benchmark : " << vertices.size() << " vertices, " << indices.size() / 3 << " triangles, " << (index_type == GL_UNSIGNED_SHORT ? 16 : 32)
+                  << " bit indices\n";
+
+        double float_rate = 0.0;
+        for (const auto format : OpenGL::AllVertexFormats)
+        {
+            // what the shader will read back, against what we asked for
+            const auto decoded        = OpenGL::DecodeVertices(OpenGL::EncodeVertices(vertices, format), format);
+            double     position_error = 0.0;
+            double     color_error    = 0.0;
+            for (std::size_t v = 0; v < vertices.size(); ++v)
+            {
+                position_error = std::max({ position_error, std::abs(static_cast<double>(decoded[v].x - vertices[v].x)), std::abs(static_cast<double>(decoded[v].y - vertices[v].y)) });
+                color_error    = std::max({ color_error, std::abs(static_cast<double>(decoded[v].r - vertices[v].r)), std::abs(static_cast<double>(decoded[v].g - vertices[v].g)),
+                                            std::abs(static_cast<double>(decoded[v].b - vertices[v].b)) });
+            }
+
+            auto mesh = OpenGL::CreateMesh(vertices, indices, format);
+            OpenGL::DrawMesh(mesh);
+            glFinish(); // first draw pays for the upload
+
+            const auto start = clock::now();
+            int        draws = 0;
+            double     ms    = 0.0;
+            do
+            {
+                for (int i = 0; i < 8; ++i)
+                {
+                    OpenGL::DrawMesh(mesh);
+                }
+                glFinish();
+                draws += 8;
+                ms = milliseconds_since(start);
+            } while (ms < 250.0);
+            const double rate = static_cast<double>(vertices.size()) * draws / (ms / 1000.0);
+            if (format == OpenGL::VertexFormat::Float)
+            {
+                float_rate = rate;
+            }
+
+            std::cout << "  " << OpenGL::ToString(format) << " : " << OpenGL::GetVertexLayout(format).Stride << " bytes/vertex, " << (mesh.VertexBytes + mesh.IndexBytes) / 1024 << " KiB | "
+                      << ms / draws << " ms/draw, " << rate / 1'000'000.0 << " M vertices/s (x" << rate / float_rate << ") | max error position " << position_error << " color "
+                      << color_error << '\n';
+            OpenGL::DestroyMesh(mesh);
+        }
+        OpenGL::DestroyShader(shader);
+    }
+
+    void RunStreamBufferBenchmark(int max_megabytes)
+    {
+        constexpr std::size_t megabyte    = 1024 * 1024;
+        constexpr std::size_t chunk_bytes = megabyte; // one Map() + draw per chunk, like a batch renderer flush
+        constexpr int         min_frames  = 8;
+
+        auto shader = OpenGL::CreateShader(std::string_view{ stream_vertex_glsl }, std::string_view{ stream_fragment_glsl });
+        OpenGL::Handle vertex_array = 0;
+        glGenVertexArrays(1, &vertex_array);
+        std::vector<float> source(chunk_bytes / sizeof(float), 0.5f);
+
+        std::cout << "stream buffer benchmark : up to " << max_megabytes << " MB per frame in " << chunk_bytes / megabyte << " MB chunks, best strategy "
+                  << OpenGL::ToString(OpenGL::BestStreamStrategy()) << '\n';
+        for (std::size_t megabytes = 1; megabytes <= static_cast<std::size_t>(std::max(max_megabytes, 1)); megabytes *= 4)
+        {
+            const std::size_t frame_bytes = megabytes * megabyte;
+            for (const auto strategy : OpenGL::AllStreamStrategies)
+            {
+                if (!OpenGL::IsStreamStrategySupported(strategy))
+                {
+                    std::cout << "  " << OpenGL::ToString(strategy) << " : not supported here\n";
+                    continue;
+                }
+                // 3 frames worth like the uniform ring, wrapping is part of what we measure
+                OpenGL::StreamBuffer stream(3 * frame_bytes, strategy);
+                OpenGL::UseProgram(shader.Shader);
+                OpenGL::BindVertexArray(vertex_array);
+                glEnableVertexAttribArray(0);
+
+                glFinish();
+                const auto start  = clock::now();
+                int        frames = 0;
+                double     ms     = 0.0;
+                [[maybe_unused]] GLintptr last = 0; // where the readback below looks, not on WebGL2
+                do
+                {
+                    for (std::size_t written = 0; written < frame_bytes; written += chunk_bytes)
+                    {
+                        // stamp each chunk with the frame so the readback below can tell fresh from stale
+                        source[0]        = static_cast<float>(frames);
+                        const auto range = stream.Map(chunk_bytes);
+                        std::memcpy(range.Memory, source.data(), chunk_bytes);
+                        stream.Unmap();
+                        OpenGL::BindBuffer(GL_ARRAY_BUFFER, stream.GetBuffer());
+                        glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), reinterpret_cast<void*>(range.Offset));
+                        glDrawArrays(GL_TRIANGLES, 0, 3);
+                        last = range.Offset;
+                    }
+                    stream.EndFrame();
+                    ++frames;
+                    ms = milliseconds_since(start);
+                } while (ms < 250.0 || frames < min_frames);
+                glFinish();
+                ms = milliseconds_since(start);
+
+                std::string check;
+#if !defined(__EMSCRIPTEN__)
+                // no glGetBufferSubData on WebGL2
+                float stamp = -1.0f;
+                OpenGL::BindBuffer(GL_ARRAY_BUFFER, stream.GetBuffer());
+                glGetBufferSubData(GL_ARRAY_BUFFER, last, sizeof(stamp), &stamp);
+                check = (stamp == static_cast<float>(frames - 1)) ? " | data ok" : " | STALE DATA";
+#endif
+                const auto& stats = stream.GetStatistics();
+                std::cout << "  " << megabytes << " MB/frame " << OpenGL::ToString(stream.GetStrategy()) << " : " << ms / frames << " ms/frame, "
+                          << static_cast<double>(stats.BytesStreamed) / (ms / 1000.0) / 1e9 << " GB/s | wraps " << stats.Wraps << ", fence waits " << stats.FenceWaits << check << '\n';
+            }
+        }
+        OpenGL::DeleteVertexArray(vertex_array);
+        OpenGL::DestroyShader(shader);
+    }
+
+    void RunMeshLoadBenchmark(const std::filesystem::path& directory)
+    {
+        std::vector<std::filesystem::path> binary_files;
+        std::vector<std::filesystem::path> text_files;
+        std::uintmax_t                     binary_bytes = 0;
+        std::uintmax_t                     text_bytes   = 0;
+        if (std::filesystem::is_directory(directory))
+        {
+            for (const auto& entry : std::filesystem::recursive_directory_iterator(directory))
+            {
+                const auto extension = entry.path().extension();
+                if (extension == ".mesh")
+                {
+                    binary_files.push_back(entry.path());
+                    binary_bytes += entry.file_size();
+                }
+                else if (extension == ".obj" || extension == ".json")
+                {
+                    text_files.push_back(entry.path());
+                    text_bytes += entry.file_size();
+                }
+            }
+        }
+        if (binary_files.empty() || text_files.empty())
+        {
+            std::cout << "mesh load benchmark : no .mesh and .obj / .json files under " << directory.string() << '\n';
+            return;
+        }
+
+        // the .mesh files are only worth loading if they still say what their sources say
+        int stale = 0;
+        for (const auto& file : binary_files)
+        {
+            for (const auto* extension : { ".obj", ".json" })
+            {
+                auto source = file;
+                source.replace_extension(extension);
+                if (!std::filesystem::exists(source))
+                {
+                    continue;
+                }
+                const auto data     = OpenGL::ImportMesh(source);
+                const auto asset    = OpenGL::LoadMeshFile(file);
+                const auto vertices = OpenGL::EncodeVertices(data.Vertices, asset.GetFormat());
+                const auto indices  = OpenGL::EncodeIndices(data.Indices, asset.Header.IndexType);
+                if (!std::equal(vertices.begin(), vertices.end(), asset.Vertices.begin(), asset.Vertices.end()) ||
+                    !std::equal(indices.begin(), indices.end(), asset.Indices.begin(), asset.Indices.end()))
+                {
+                    std::cout << "  " << file.string() << " is older than " << source.string() << ", run cs200_meshc on it\n";
+                    ++stale;
+                }
+            }
+        }
+
+        // ms per load of the whole set
+        const double binary_ms = milliseconds_per_run(
+            [&binary_files]
+            {
+                for (const auto& file : binary_files)
+                {
+                    const auto asset = OpenGL::LoadMeshFile(file);
+                    auto       mesh  = OpenGL::CreateMesh(asset);
+                    OpenGL::DestroyMesh(mesh);
+                }
+                glFinish();
+                OpenGL::CollectResources(); // one frame per run, the released buffers come back after a few
+            });
+        const double text_ms = milliseconds_per_run(
+            [&text_files]
+            {
+                for (const auto& file : text_files)
+                {
+                    const auto data = OpenGL::ImportMesh(file);
+                    auto       mesh = OpenGL::CreateMesh(data.Vertices, data.Indices, OpenGL::VertexFormat::PackedColor);
+                    OpenGL::DestroyMesh(mesh);
+                }
+                glFinish();
+                OpenGL::CollectResources(); // one frame per run, the released buffers come back after a few
+            });
+
+        const auto megabytes_per_second = [](std::uintmax_t bytes, double ms) { return static_cast<double>(bytes) / (1024.0 * 1024.0) / (ms / 1000.0); };
+        std::cout << "mesh load benchmark : " << directory.string() << (stale == 0 ? ", every .mesh matches its source" : ", STALE .mesh files") << '\n'
+                  << "  binary : " << binary_files.size() << " .mesh files, " << binary_bytes << " bytes | " << binary_ms << " ms per load of all of them, "
+                  << megabytes_per_second(binary_bytes, binary_ms) << " MB/s\n"
+                  << "  text   : " << text_files.size() << " .obj / .json files, " << text_bytes << " bytes | " << text_ms << " ms per load of all of them, "
+                  << megabytes_per_second(text_bytes, text_ms) << " MB/s\n"
+                  << "  binary is x" << text_ms / binary_ms << " faster for the same meshes\n";
+    }
+
+    void RunFileLoadBenchmark(int file_count)
+    {
+        // Assets/shaders copied over and over into a temporary tree, 64 files per folder
+        std::vector<std::filesystem::path> sources;
+        if (std::filesystem::is_directory("Assets/shaders"))
+        {
+            for (const auto& entry : std::filesystem::recursive_directory_iterator("Assets/shaders"))
+            {
+                if (entry.is_regular_file())
+                {
+                    sources.push_back(entry.path());
+                }
+            }
+        }
+        if (sources.empty() || file_count <= 0)
+        {
+            std::cout << "file load benchmark : nothing to copy under Assets/shaders\n";
+            return;
+        }
+
+        const auto                         directory = std::filesystem::temp_directory_path() / "cs200_file_benchmark";
+        std::vector<std::filesystem::path> files;
+        std::uintmax_t                     bytes = 0;
+        std::filesystem::remove_all(directory);
+        for (int i = 0; i < file_count; ++i)
+        {
+            const auto& source = sources[static_cast<std::size_t>(i) % sources.size()];
+            const auto  folder = directory / std::to_string(i / 64);
+            std::filesystem::create_directories(folder);
+            files.push_back(folder / (std::to_string(i) + source.filename().string()));
+            std::filesystem::copy_file(source, files.back());
+            bytes += std::filesystem::file_size(source);
+        }
+
+        // what ReadGLSLFile used to do : a std::string per file, one character at a time through istreambuf_iterator
+        const auto read_per_character = [&files]
+        {
+            std::vector<std::string> texts;
+            for (const auto& file : files)
+            {
+                std::ifstream ifs(file, std::ios::in);
+                std::string   text;
+                std::copy(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>(), std::back_insert_iterator(text));
+                texts.push_back(std::move(text));
+            }
+            return texts;
+        };
+
+        // the views have to say the same as the old way
+        OpenGL::FileArena arena;
+        const auto        expected = read_per_character();
+        const auto        texts    = OpenGL::ReadFiles(files, arena);
+        const bool        same     = std::equal(expected.begin(), expected.end(), texts.begin(), texts.end());
+
+        const double per_character_ms = milliseconds_per_run([&] { static_cast<void>(read_per_character()); });
+        const double read_text_ms     = milliseconds_per_run(
+            [&files]
+            {
+                std::vector<std::string> owned;
+                for (const auto& file : files)
+                {
+                    owned.push_back(OpenGL::ReadTextFile(file));
+                }
+            });
+        const double mapped_ms = milliseconds_per_run(
+            [&files]
+            {
+                // one byte per page so the mapping actually gets read
+                std::size_t touched = 0;
+                for (const auto& file : files)
+                {
+                    const OpenGL::MappedFile mapped(file);
+                    const auto               contents = mapped.GetBytes();
+                    for (std::size_t i = 0; i < contents.size(); i += 4096)
+                    {
+                        touched += std::to_integer<std::size_t>(contents[i]);
+                    }
+                }
+                static_cast<void>(touched);
+            });
+        const double arena_ms = milliseconds_per_run(
+            [&]
+            {
+                arena.Reset();
+                static_cast<void>(OpenGL::ReadFiles(files, arena, 1));
+            });
+        const double threaded_ms = milliseconds_per_run(
+            [&]
+            {
+                arena.Reset();
+                static_cast<void>(OpenGL::ReadFiles(files, arena));
+            });
+
+        const auto report = [&](std::string_view name, double ms)
+        {
+            std::cout << "  " << name << " : " << ms << " ms, " << static_cast<double>(file_count) / (ms / 1000.0) << " files/s, "
+                      << static_cast<double>(bytes) / (1024.0 * 1024.0) / (ms / 1000.0) << " MB/s\n";
+        };
+        std::cout << "file load benchmark : " << file_count << " files, " << bytes << " bytes" << (same ? "" : ", CONTENTS DIFFER") << " (warm page cache)\n";
+        report("istreambuf_iterator per file   ", per_character_ms);
+        report("ReadTextFile per file          ", read_text_ms);
+        report("MappedFile per file            ", mapped_ms);
+        report("ReadFiles into arena, 1 thread ", arena_ms);
+        report("ReadFiles into arena, all cores", threaded_ms);
+        std::filesystem::remove_all(directory);
+    }
+
+    void RunShaderReloadBenchmark()
+    {
+        const auto directory     = std::filesystem::temp_directory_path() / "cs200_reload_benchmark";
+        const auto vertex_path   = directory / "bench.vert";
+        const auto fragment_path = directory / "bench.frag";
+        const auto write_file    = [](const std::filesystem::path& file_path, const std::string& text) { std::ofstream(file_path, std::ios::out | std::ios::trunc) << text; };
+        long long  salt          = clock::now().time_since_epoch().count();
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory);
+        write_file(vertex_path, synthetic_vertex_glsl(0, salt));
+        write_file(fragment_path, synthetic_fragment_glsl(0, salt));
+
+        struct Mode
+        {
+            std::string_view          Name;
+            bool                      Inotify;
+            std::chrono::milliseconds PollInterval;
+        };
+
+        const std::array modes{ Mode{ "inotify", true, std::chrono::milliseconds{ 500 } }, Mode{ "polling every 500 ms", false, std::chrono::milliseconds{ 500 } },
+                                Mode{ "polling every frame", false, std::chrono::milliseconds{ 0 } } };
+        std::cout << "shader reload benchmark\n";
+        for (const auto& mode : modes)
+        {
+            OpenGL::ShaderHotReload reload(mode.Inotify, mode.PollInterval);
+            if (mode.Inotify && !reload.IsUsingInotify())
+            {
+                std::cout << "  " << mode.Name << " : not available here\n";
+                continue;
+            }
+            const auto program = reload.Add(vertex_path, fragment_path);
+
+            // nothing changed : what every frame pays
+            constexpr int idle_updates = 100'000;
+            auto          start        = clock::now();
+            for (int i = 0; i < idle_updates; ++i)
+            {
+                static_cast<void>(reload.Update());
+            }
+            const double idle_ns = milliseconds_since(start) * 1e6 / idle_updates;
+
+            // a save : from the write to the new program being what Get() returns, compile included
+            write_file(vertex_path, synthetic_vertex_glsl(1, ++salt));
+            start = clock::now();
+            while (reload.Update() == 0 && milliseconds_since(start) < 2000.0)
+            {
+            }
+            const double reload_ms = milliseconds_since(start);
+            const bool   reloaded  = reload.GetStatistics().Reloads == 1;
+
+            // a typo : the compile error gets printed and drawing goes on with the program from before
+            const auto before = reload.Get(program).Shader;
+            write_file(fragment_path, "#version 300 es\nthis is not glsl\n");
+            start = clock::now();
+            while (reload.GetStatistics().Failures == 0 && milliseconds_since(start) < 2000.0)
+            {
+                static_cast<void>(reload.Update());
+            }
+            const bool kept = reload.GetStatistics().Failures == 1 && reload.Get(program).Shader == before && glIsProgram(before) == GL_TRUE;
+            write_file(fragment_path, synthetic_fragment_glsl(0, salt));
+
+            std::cout << "  " << mode.Name << " : Update() with nothing changed " << idle_ns << " ns | edit to swap " << reload_ms << " ms" << (reloaded ? "" : " (NEVER RELOADED)")
+                      << " | broken edit " << (kept ? "kept the old program" : "LOST THE PROGRAM") << '\n';
+        }
+        std::filesystem::remove_all(directory);
+    }
+
+    void RunCommandRecordingBenchmark(int object_count)
+    {
+        constexpr int program_count = 4;
+        constexpr int mesh_count    = 4;
+        const auto    objects       = static_cast<std::size_t>(std::max(1, object_count));
+
+        std::vector<OpenGL::CompiledShader> shaders;
+        std::vector<OpenGL::Mesh>           meshes;
+        std::vector<OpenGL::Handle>         vertex_arrays; // the pool is gl thread only, the workers get the names
+        const long long                     salt = clock::now().time_since_epoch().count();
+        for (int p = 0; p < program_count; ++p)
+        {
+            shaders.push_back(OpenGL::CreateShader(std::string_view{ synthetic_vertex_glsl(p, salt) }, std::string_view{ synthetic_fragment_glsl(p, salt) }));
+            OpenGL::UseProgram(shaders.back().Shader);
+            OpenGL::SetUniform(shaders.back(), OpenGL::UniformIDs::uToNDC, Math::IdentityMatrix());
+        }
+        for (int m = 0; m < mesh_count; ++m)
+        {
+            // a quad, a triangle... so each VAO draws something different
+            const float                      c          = 0.25f * static_cast<float>(m + 1);
+            const OpenGL::Vertex             vertices[] = { { -0.5f, -0.5f, c, 1, 0 }, { 0.5f, -0.5f, c, 0, 1 }, { 0.5f, 0.5f, 1, c, 0 }, { -0.5f, 0.5f, 0, c, 1 } };
+            const std::vector<std::uint32_t> indices    = (m % 2 == 0) ? std::vector<std::uint32_t>{ 0, 1, 2, 0, 2, 3 } : std::vector<std::uint32_t>{ 0, 1, 2 };
+            meshes.push_back(OpenGL::CreateMesh(vertices, indices));
+            vertex_arrays.push_back(meshes.back().VertexArray.Get());
+        }
+
+        // which program and mesh each object uses, shuffled so recording order is the worst order for state changes
+        std::vector<std::uint8_t> programs(objects);
+        std::vector<std::uint8_t> mesh_of(objects);
+        std::mt19937              random{ 7 };
+        for (std::size_t i = 0; i < objects; ++i)
+        {
+            programs[i] = static_cast<std::uint8_t>(random() % program_count);
+            mesh_of[i]  = static_cast<std::uint8_t>(random() % mesh_count);
+        }
+
+        // what a worker does per object : place it, a visibility test, a key
+        const auto record = [&](OpenGL::CommandBuffer& buffer, std::size_t begin, std::size_t end)
+        {
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                const float t     = static_cast<float>(i) / static_cast<float>(objects);
+                const float x     = std::sin(t * 97.0f) * 0.9f;
+                const float y     = std::cos(t * 89.0f) * 0.9f;
+                const auto  model = Math::Multiply(Math::TranslationMatrix(x, y), Math::Multiply(Math::RotationMatrix(t * 31.0f), Math::ScaleMatrix(0.01f, 0.01f)));
+                if (std::abs(model[6]) > 1.0f || std::abs(model[7]) > 1.0f)
+                {
+                    continue;
+                }
+                auto&               shader = shaders[programs[i]];
+                const auto&         mesh   = meshes[mesh_of[i]];
+                OpenGL::DrawCommand command;
+                command.Key         = OpenGL::MakeSortKey(0, shader.Shader, vertex_arrays[mesh_of[i]], static_cast<std::uint32_t>(i & 0xFF'FFFFu));
+                command.Shader      = &shader;
+                command.VertexArray = vertex_arrays[mesh_of[i]];
+                command.IndexType   = mesh.IndexType;
+                command.IndexCount  = mesh.IndexCount;
+                command.Model       = model;
+                buffer.Draw(command);
+            }
+        };
+
+        const unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+        std::cout << "command recording benchmark : " << objects << " objects, " << program_count << " programs, " << mesh_count << " meshes, " << cores << " cores\n";
+        std::vector<unsigned> thread_counts;
+        for (unsigned threads = 1; threads < cores; threads *= 2)
+        {
+            thread_counts.push_back(threads);
+        }
+        thread_counts.push_back(cores);
+
+        double                             single_ms = 0.0;
+        std::vector<OpenGL::CommandBuffer> buffers;
+        for (const unsigned threads : thread_counts)
+        {
+            Jobs::JobSystem jobs(threads);
+            buffers.assign(jobs.GetWorkerCount(), OpenGL::CommandBuffer{});
+            const double ms = milliseconds_per_run(
+                [&]
+                {
+                    for (auto& buffer : buffers)
+                    {
+                        buffer.Clear();
+                    }
+                    jobs.ParallelFor(objects, 1024, [&](std::size_t begin, std::size_t end, unsigned worker) { record(buffers[worker], begin, end); });
+                });
+            single_ms = (threads == 1) ? ms : single_ms;
+            std::cout << "  record on " << jobs.GetWorkerCount() << " threads : " << ms << " ms (x" << single_ms / ms << "), " << jobs.GetStatistics().Steals << " chunks stolen\n";
+        }
+
+        // the last recording, drawn as it came out of the workers and then sorted
+        OpenGL::CommandSubmitter submitter;
+        for (const bool sorted : { false, true })
+        {
+            OpenGL::SubmitStatistics submitted{};
+            const double             ms = milliseconds_per_run(
+                [&]
+                {
+                    submitted = submitter.Submit(buffers, OpenGL::SubmitOptions{ sorted, sorted, sorted });
+                    glFinish();
+                });
+            std::cout << "  submit " << (sorted ? "sorted   " : "unsorted ") << ": " << ms << " ms, " << submitted.DrawCalls << " draws, " << submitted.Submitted.Programs << " program changes, "
+                      << submitted.Submitted.VertexArrays << " vertex array changes\n";
+        }
+
+        for (auto& mesh : meshes)
+        {
+            OpenGL::DestroyMesh(mesh);
+        }
+        for (auto& shader : shaders)
+        {
+            OpenGL::DestroyShader(shader);
+        }
+    }
+
+    void RunRenderQueueBenchmark(int draw_count)
+    {
+        constexpr int program_count  = 4;
+        constexpr int mesh_count     = 8;
+        constexpr int material_count = 16;
+        constexpr int grid_cells     = 16; // per side, every mesh is 256 quads drawn as 256 pieces
+        const auto    draws          = static_cast<std::size_t>(std::max(1, draw_count));
+
+        std::vector<OpenGL::CompiledShader> shaders;
+        std::vector<OpenGL::Mesh>           meshes;
+        const long long                     salt = clock::now().time_since_epoch().count();
+        for (int p = 0; p < program_count; ++p)
+        {
+            shaders.push_back(OpenGL::CreateShader(std::string_view{ synthetic_vertex_glsl(p, salt) }, std::string_view{ synthetic_fragment_glsl(p, salt) }));
+            OpenGL::UseProgram(shaders.back().Shader);
+            OpenGL::SetUniform(shaders.back(), OpenGL::UniformIDs::uToNDC, Math::IdentityMatrix());
+        }
+        for (int m = 0; m < mesh_count; ++m)
+        {
+            // a grid of quads, quad i is indices 6i to 6i + 5
+            std::vector<OpenGL::Vertex> vertices;
+            std::vector<std::uint32_t>  indices;
+            const float                 c = static_cast<float>(m + 1) / mesh_count;
+            for (int y = 0; y <= grid_cells; ++y)
+            {
+                for (int x = 0; x <= grid_cells; ++x)
+                {
+                    vertices.push_back(OpenGL::Vertex{ static_cast<float>(x) / grid_cells - 0.5f, static_cast<float>(y) / grid_cells - 0.5f, c, 1.0f - c, 0.5f });
+                }
+            }
+            for (std::uint32_t y = 0; y < grid_cells; ++y)
+            {
+                for (std::uint32_t x = 0; x < grid_cells; ++x)
+                {
+                    const std::uint32_t corner = y * (grid_cells + 1) + x;
+                    indices.insert(indices.end(), { corner, corner + 1, corner + grid_cells + 2, corner, corner + grid_cells + 2, corner + grid_cells + 1 });
+                }
+            }
+            meshes.push_back(OpenGL::CreateMesh(vertices, indices));
+        }
+
+        // a material is a place and a color : draws sharing one can be drawn together
+        std::mt19937                          random{ 11 };
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        std::vector<OpenGL::DrawCommand>      materials(material_count);
+        for (auto& material : materials)
+        {
+            material.Model = Math::Multiply(Math::TranslationMatrix(1.6f * unit(random) - 0.8f, 1.6f * unit(random) - 0.8f), Math::ScaleMatrix(0.3f, 0.3f));
+            material.Color = { unit(random), unit(random), unit(random), 1.0f };
+        }
+
+        // pieces of random meshes with random programs and materials, in random order
+        std::vector<OpenGL::CommandBuffer> buffers(1);
+        buffers.front().Reserve(draws);
+        for (std::size_t i = 0; i < draws; ++i)
+        {
+            const auto  program      = random() % program_count;
+            const auto  mesh         = random() % mesh_count;
+            const auto  material     = static_cast<std::uint32_t>(random() % material_count);
+            const auto  piece        = static_cast<std::uint32_t>(random() % (grid_cells * grid_cells));
+            const auto& source       = materials[material];
+            const auto  vertex_array = meshes[mesh].VertexArray.Get();
+
+            OpenGL::DrawCommand command;
+            command.Key         = OpenGL::MakeSortKey(0, shaders[program].Shader, vertex_array, (material << 16) | piece);
+            command.Shader      = &shaders[program];
+            command.VertexArray = vertex_array;
+            command.IndexType   = meshes[mesh].IndexType;
+            command.IndexCount  = 6;
+            command.FirstIndex  = 6 * piece;
+            command.Model       = source.Model;
+            command.Color       = source.Color;
+            buffers.front().Draw(command);
+        }
+
+        std::cout << "render queue benchmark : " << draws << " draws, " << program_count << " programs, " << mesh_count << " meshes of " << grid_cells * grid_cells << " pieces, "
+                  << material_count << " materials\n";
+        OpenGL::CommandSubmitter submitter;
+        const std::array<std::pair<const char*, OpenGL::SubmitOptions>, 4> modes{ { { "as recorded       ", { false, false, false } },
+                                                                                   { "sorted            ", { true, false, false } },
+                                                                                   { "sorted + merged   ", { true, true, false } },
+                                                                                   { "sorted + multidraw", { true, true, true } } } };
+        for (const auto& [label, options] : modes)
+        {
+            OpenGL::SubmitStatistics submitted{};
+            const double             ms = milliseconds_per_run(
+                [&]
+                {
+                    submitted = submitter.Submit(buffers, options);
+                    glFinish();
+                });
+            const auto& changes = submitted.Submitted;
+            std::cout << "  " << label << " : " << ms << " ms, " << submitted.DrawCalls << " draw calls (" << submitted.Merged << " merged, " << submitted.MultiDraws << " multidraws), state changes "
+                      << changes.Total() << " (" << changes.Programs << " programs, " << changes.VertexArrays << " vertex arrays, " << changes.Uniforms << " uniform sets) against "
+                      << submitted.Recorded.Total() << " as recorded\n";
+        }
+
+        for (auto& mesh : meshes)
+        {
+            OpenGL::DestroyMesh(mesh);
+        }
+        for (auto& shader : shaders)
+        {
+            OpenGL::DestroyShader(shader);
+        }
+    }
+
+    void RunCullingBenchmark()
+    {
+        // same numbers as the --world scene : about 5000 objects on an 800x600 window whatever the map size
+        constexpr float density   = 1.0f / 96.0f;
+        constexpr float cell_size = 32.0f;
+        constexpr int   queries   = 256;
+        const auto      window    = Math::ToNDCMatrix(800, 600);
+
+        std::cout << "culling benchmark : loose grid with " << cell_size << " px cells, 800x600 window, " << queries << " camera positions\n";
+        for (const int object_count : { 10'000, 100'000, 1'000'000 })
+        {
+            const float                           side = std::sqrt(static_cast<float>(object_count) / density);
+            std::mt19937                          random{ 42 };
+            std::uniform_real_distribution<float> position(-0.5f * side, 0.5f * side);
+            std::uniform_real_distribution<float> size(4.0f, 28.0f);
+            std::vector<Spatial::Rect>            bounds(static_cast<std::size_t>(object_count));
+            for (auto& rect : bounds)
+            {
+                const float x    = position(random);
+                const float y    = position(random);
+                const float half = 0.5f * size(random);
+                rect             = Spatial::Rect{ x - half, y - half, x + half, y + half };
+            }
+
+            Spatial::LooseGrid grid(cell_size);
+            auto               start = clock::now();
+            for (const auto& rect : bounds)
+            {
+                grid.Insert(rect);
+            }
+            const double insert_ms = milliseconds_since(start);
+
+            // cameras inside the map, so every window is full
+            std::vector<Spatial::Rect>            views;
+            std::uniform_real_distribution<float> camera(-0.5f * side + 400.0f, 0.5f * side - 400.0f);
+            for (int q = 0; q < queries; ++q)
+            {
+                const float x = (side > 800.0f) ? camera(random) : 0.0f;
+                const float y = (side > 800.0f) ? camera(random) : 0.0f;
+                views.push_back(Spatial::VisibleRect(Math::Multiply(window, Math::TranslationMatrix(-x, -y))));
+            }
+
+            grid.GetStatistics() = {};
+            std::vector<Spatial::LooseGrid::ObjectID> found;
+            std::size_t                               grid_found = 0;
+            start                                                = clock::now();
+            for (const auto& view : views)
+            {
+                found.clear();
+                grid.Query(view, found);
+                grid_found += found.size();
+            }
+            const double grid_us    = 1000.0 * milliseconds_since(start) / queries;
+            const auto   candidates = grid.GetStatistics().Candidates / queries;
+
+            std::size_t scan_found = 0;
+            start                  = clock::now();
+            for (const auto& view : views)
+            {
+                for (const auto& rect : bounds)
+                {
+                    scan_found += Spatial::Overlaps(rect, view) ? 1u : 0u;
+                }
+            }
+            const double scan_us = 1000.0 * milliseconds_since(start) / queries;
+
+            // every 16th object takes a small step, like the scene does every update
+            std::uniform_real_distribution<float> step(-3.0f, 3.0f);
+            std::size_t                           moves = 0;
+            start                                       = clock::now();
+            for (int frame = 0; frame < 16; ++frame)
+            {
+                for (std::size_t i = 0; i < bounds.size(); i += 16, ++moves)
+                {
+                    const float dx = step(random);
+                    const float dy = step(random);
+                    bounds[i]      = Spatial::Rect{ bounds[i].Left + dx, bounds[i].Bottom + dy, bounds[i].Right + dx, bounds[i].Top + dy };
+                    grid.Move(static_cast<Spatial::LooseGrid::ObjectID>(i), bounds[i]);
+                }
+            }
+            const double move_ns = 1'000'000.0 * milliseconds_since(start) / static_cast<double>(moves);
+
+            std::cout << "  " << object_count << " objects (" << static_cast<int>(side) << " px map) : insert " << insert_ms << " ms | query " << grid_us << " us, " << candidates
+                      << " tested, " << grid_found / queries << " drawn of " << object_count << " | every object tested " << scan_us << " us (x" << scan_us / grid_us << ")"
+                      << (grid_found == scan_found ? "" : " MISMATCH") << " | move " << move_ns << " ns, " << grid.GetStatistics().CellChanges << " cell changes\n";
+        }
+    }
+
+    void RunTextureAtlasBenchmark(int sprite_count)
+    {
+        constexpr int page_size = 2048;
+        const auto    count     = static_cast<std::size_t>(std::max(sprite_count, 1));
+
+        // sprite sized images, mostly small with the odd big one, with a pattern so the read back means something
+        std::mt19937                       random{ 42 };
+        std::uniform_int_distribution<int> small(8, 64);
+        std::uniform_int_distribution<int> big(64, 256);
+        std::vector<OpenGL::Image>         images(count);
+        std::size_t                        pixel_bytes = 0;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            auto& image  = images[i];
+            image.Width  = (i % 8 == 0) ? big(random) : small(random);
+            image.Height = (i % 8 == 0) ? big(random) : small(random);
+            image.Pixels.resize(static_cast<std::size_t>(image.Width * image.Height) * 4);
+            for (std::size_t p = 0; p < image.Pixels.size(); ++p)
+            {
+                image.Pixels[p] = static_cast<std::uint8_t>(p * 7 + i * 13);
+            }
+            pixel_bytes += image.Pixels.size();
+        }
+        std::cout << "texture atlas benchmark : " << count << " images, " << static_cast<double>(pixel_bytes) / (1024.0 * 1024.0) << " MB of pixels, " << page_size << " px pages\n";
+
+        // packing alone, in arrival order and tallest first (what an offline packer would do)
+        const auto pack = [&](std::vector<std::size_t> order, std::string_view name)
+        {
+            std::vector<OpenGL::SkylinePacker> pages;
+            const auto                         start = clock::now();
+            for (const auto index : order)
+            {
+                const int width  = images[index].Width + 2 * OpenGL::TextureAtlas::Padding;
+                const int height = images[index].Height + 2 * OpenGL::TextureAtlas::Padding;
+                if (pages.empty() || !std::any_of(pages.begin(), pages.end(), [&](OpenGL::SkylinePacker& page) { return page.Insert(width, height).has_value(); }))
+                {
+                    pages.emplace_back(page_size, page_size);
+                    static_cast<void>(pages.back().Insert(width, height));
+                }
+            }
+            const double  ms      = milliseconds_since(start);
+            std::uint64_t used    = 0;
+            std::uint64_t skyline = 0;
+            for (const auto& page : pages)
+            {
+                used += page.GetUsedArea();
+                skyline += page.GetSkylineArea();
+            }
+            // the last page is only partly filled, the skyline area is what it actually cost
+            std::cout << "  pack " << name << " : " << pages.size() << " pages, " << 100.0 * static_cast<double>(used) / static_cast<double>(skyline) << "% of the area under the skylines, "
+                      << 100.0 * static_cast<double>(used) / (static_cast<double>(pages.size()) * page_size * page_size) << "% of the pages | " << 1'000'000.0 * ms / static_cast<double>(count)
+                      << " ns per image\n";
+        };
+        std::vector<std::size_t> order(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            order[i] = i;
+        }
+        pack(order, "as they come ");
+        std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return images[a].Height > images[b].Height; });
+        pack(order, "tallest first");
+
+        // every sprite read back from its page through a framebuffer, row by row the same as the image
+        OpenGL::Handle framebuffer = 0;
+        glGenFramebuffers(1, &framebuffer);
+        const auto count_wrong = [&](const OpenGL::TextureAtlas& atlas, const std::vector<OpenGL::TextureAtlas::SpriteID>& sprites)
+        {
+            std::size_t               wrong = 0;
+            std::vector<std::uint8_t> readback;
+            glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const auto& region = atlas.Get(sprites[i]);
+                if (region.State != OpenGL::TextureAtlas::SpriteState::Ready)
+                {
+                    ++wrong;
+                    continue;
+                }
+                glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, region.Texture, 0);
+                readback.resize(images[i].Pixels.size());
+                const auto x = static_cast<GLint>(std::lround(region.Left * page_size));
+                const auto y = static_cast<GLint>(std::lround(region.Top * page_size));
+                glReadPixels(x, y, region.Width, region.Height, GL_RGBA, GL_UNSIGNED_BYTE, readback.data());
+                wrong += (readback == images[i].Pixels) ? 0u : 1u;
+            }
+            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            return wrong;
+        };
+
+        // uploads alone : the images are handed over decoded, so every Update() has a full budget to spend
+        for (const std::size_t megabytes : { 1u, 4u, 16u })
+        {
+            OpenGL::TextureAtlas                        atlas(page_size, megabytes << 20);
+            std::vector<OpenGL::TextureAtlas::SpriteID> sprites;
+            for (const auto& image : images)
+            {
+                sprites.push_back(atlas.Add(image));
+            }
+            // the first frame also packs everything and allocates the pages, the rest only upload
+            int        frames   = 0;
+            double     first_ms = 0.0;
+            double     worst_ms = 0.0;
+            const auto start    = clock::now();
+            while (!atlas.IsIdle())
+            {
+                const auto frame_start = clock::now();
+                atlas.Update();
+                glFinish(); // the copy into the texture counts
+                const double frame_ms = milliseconds_since(frame_start);
+                first_ms              = (frames == 0) ? frame_ms : first_ms;
+                worst_ms              = (frames == 0) ? worst_ms : std::max(worst_ms, frame_ms);
+                ++frames;
+            }
+            const double ms         = milliseconds_since(start);
+            const auto&  statistics = atlas.GetStatistics();
+            std::cout << "  " << megabytes << " MB/frame budget : " << frames << " frames, first " << first_ms << " ms, worst of the others " << worst_ms << " ms | " << statistics.Uploads
+                      << " glTexSubImage2D, " << static_cast<double>(statistics.BytesUploaded) / (1024.0 * 1024.0) / (ms / 1000.0) << " MB/s | " << atlas.GetPageCount() << " pages, "
+                      << 100.0 * atlas.GetPackingEfficiency() << "% packed with padding" << (count_wrong(atlas, sprites) == 0 ? "" : ", PIXELS DIFFER") << '\n';
+        }
+
+        // the whole path : .tga files decoded on the atlas' threads while the gl thread packs and uploads what's ready
+        const auto directory = std::filesystem::temp_directory_path() / "cs200_atlas_benchmark";
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory);
+        std::vector<std::filesystem::path> files;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            files.push_back(directory / (std::to_string(i) + ".tga"));
+            const auto    bytes = OpenGL::EncodeTGA(images[i]);
+            std::ofstream out(files.back(), std::ios::binary);
+            out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        }
+        {
+            OpenGL::TextureAtlas                        atlas(page_size);
+            std::vector<OpenGL::TextureAtlas::SpriteID> sprites;
+            const auto                                  start = clock::now();
+            for (const auto& file : files)
+            {
+                sprites.push_back(atlas.Load(file));
+            }
+            while (!atlas.IsIdle())
+            {
+                atlas.Update();
+                std::this_thread::sleep_for(std::chrono::milliseconds(1)); // a frame's worth of other work
+            }
+            glFinish();
+            const double ms = milliseconds_since(start);
+            std::cout << "  " << count << " .tga files loaded, decoded on " << std::max(1u, std::thread::hardware_concurrency() / 2) << " threads and uploaded in " << ms << " ms, "
+                      << static_cast<double>(count) / (ms / 1000.0) << " images/s" << (count_wrong(atlas, sprites) == 0 ? "" : ", PIXELS DIFFER") << '\n';
+        }
+        glDeleteFramebuffers(1, &framebuffer);
+        std::filesystem::remove_all(directory);
+    }
+
+    void RunResourceBenchmark(int mesh_count)
+    {
+        constexpr int frames   = 120;
+        const auto    meshes_n = static_cast<std::size_t>(std::max(4, mesh_count));
+        const auto    replaced = meshes_n / 4;
+
+        // 16 grids of 64 to 4096 vertices, streamed in and out like level chunks
+        struct Source
+        {
+            std::vector<OpenGL::Vertex> Vertices;
+            std::vector<std::uint32_t>  Indices;
+        };
+        std::vector<Source> sources;
+        for (int size = 0; size < 16; ++size)
+        {
+            Source     source;
+            const auto quads = static_cast<std::uint32_t>(16 + size * 67);
+            for (std::uint32_t quad = 0; quad < quads; ++quad)
+            {
+                const float x = -1.0f + 2.0f * static_cast<float>(quad) / static_cast<float>(quads);
+                source.Vertices.insert(source.Vertices.end(), { { x, -0.1f, 1, 0, 0 }, { x + 0.01f, -0.1f, 0, 1, 0 }, { x + 0.01f, 0.1f, 0, 0, 1 }, { x, 0.1f, 1, 1, 1 } });
+                const std::uint32_t first = quad * 4;
+                source.Indices.insert(source.Indices.end(), { first, first + 1, first + 2, first, first + 2, first + 3 });
+            }
+            sources.push_back(std::move(source));
+        }
+        std::mt19937 random{ 11 };
+        const auto   next_source = [&]() -> const Source& { return sources[random() % sources.size()]; };
+
+        // the way Mesh.cpp did it before the pool : a gen, a glBufferData and a delete per object
+        struct RawMesh
+        {
+            OpenGL::Handle VertexBuffer = 0;
+            OpenGL::Handle IndexBuffer  = 0;
+            OpenGL::Handle VertexArray  = 0;
+        };
+        const auto create_raw = [](const Source& source)
+        {
+            const auto vertex_bytes = OpenGL::EncodeVertices(source.Vertices, OpenGL::VertexFormat::Float);
+            const auto index_bytes  = OpenGL::EncodeIndices(source.Indices, OpenGL::ChooseIndexType(source.Vertices.size()));
+            RawMesh    mesh;
+            glGenBuffers(1, &mesh.VertexBuffer);
+            OpenGL::BindBuffer(GL_ARRAY_BUFFER, mesh.VertexBuffer);
+            glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(vertex_bytes.size()), vertex_bytes.data(), GL_STATIC_DRAW);
+            glGenBuffers(1, &mesh.IndexBuffer);
+            OpenGL::BindVertexArray(0);
+            OpenGL::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.IndexBuffer);
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(index_bytes.size()), index_bytes.data(), GL_STATIC_DRAW);
+            glGenVertexArrays(1, &mesh.VertexArray);
+            OpenGL::BindVertexArray(mesh.VertexArray);
+            OpenGL::BindBuffer(GL_ARRAY_BUFFER, mesh.VertexBuffer);
+            OpenGL::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.IndexBuffer);
+            OpenGL::DescribeVertexLayout(OpenGL::GetVertexLayout(OpenGL::VertexFormat::Float));
+            return mesh;
+        };
+        const auto destroy_raw = [](const RawMesh& mesh)
+        {
+            OpenGL::DeleteVertexArray(mesh.VertexArray);
+            OpenGL::DeleteBuffer(mesh.VertexBuffer);
+            OpenGL::DeleteBuffer(mesh.IndexBuffer);
+        };
+
+        std::cout << "gpu resource benchmark : " << meshes_n << " meshes of 64 to 4096 vertices, " << replaced << " of them replaced every frame for " << frames << " frames\n";
+
+        // per object gen / delete
+        {
+            std::vector<RawMesh> live;
+            for (std::size_t i = 0; i < meshes_n; ++i)
+            {
+                live.push_back(create_raw(next_source()));
+            }
+            glFinish();
+            const auto start = clock::now();
+            for (int frame = 0; frame < frames; ++frame)
+            {
+                for (std::size_t i = 0; i < replaced; ++i)
+                {
+                    auto& slot = live[random() % live.size()];
+                    destroy_raw(slot);
+                    slot = create_raw(next_source());
+                }
+                glFinish();
+            }
+            const double ms = milliseconds_since(start) / frames;
+            for (const auto& mesh : live)
+            {
+                destroy_raw(mesh);
+            }
+            std::cout << "  gen / delete per object : " << ms << " ms/frame, " << replaced * 6 << " glGen* + glDelete* calls/frame\n";
+        }
+
+        // through the pool
+        {
+            std::vector<OpenGL::Mesh> live;
+            for (std::size_t i = 0; i < meshes_n; ++i)
+            {
+                const auto& source = next_source();
+                live.push_back(OpenGL::CreateMesh(source.Vertices, source.Indices));
+            }
+            glFinish();
+            OpenGL::CollectResources();
+            OpenGL::GetResourceStatistics() = {};
+            const auto start                = clock::now();
+            for (int frame = 0; frame < frames; ++frame)
+            {
+                for (std::size_t i = 0; i < replaced; ++i)
+                {
+                    const auto& source = next_source();
+                    live[random() % live.size()] = OpenGL::CreateMesh(source.Vertices, source.Indices);
+                }
+                glFinish();
+                OpenGL::CollectResources();
+            }
+            const double ms         = milliseconds_since(start) / frames;
+            const auto   statistics = OpenGL::GetResourceStatistics();
+            const auto   counts     = OpenGL::GetResourceCounts();
+            const auto   megabytes  = [](std::size_t bytes) { return static_cast<double>(bytes) / (1024.0 * 1024.0); };
+            std::cout << "  pooled                  : " << ms << " ms/frame, " << static_cast<double>(statistics.GenCalls + statistics.DeleteCalls) / frames
+                      << " glGen* + glDelete* calls/frame, " << 100.0 * static_cast<double>(statistics.Recycled) / static_cast<double>(2 * replaced * frames)
+                      << "% of the buffers recycled\n"
+                      << "  live : " << counts.Buffers << " buffers, " << counts.VertexArrays << " vertex arrays, " << megabytes(counts.BufferBytes) << " MB asked for, "
+                      << megabytes(counts.BufferCapacity) << " MB allocated (+" << 100.0 * (megabytes(counts.BufferCapacity) / megabytes(counts.BufferBytes) - 1.0)
+                      << "%), " << megabytes(counts.PooledBytes) << " MB pooled\n";
+
+            // leak and use after free checks : keep one mesh past ReleaseAllResources(), it gets reported and its handles go stale
+            auto kept = std::move(live.back());
+            live.clear();
+            OpenGL::CollectResources();
+            const auto after = OpenGL::GetResourceCounts();
+            std::cout << "  after destroying them : " << after.Buffers << " buffers, " << after.VertexArrays << " vertex arrays (1 mesh kept on purpose)\n";
+            std::cout.flush(); // the leak report goes to std::cerr
+            OpenGL::ReleaseAllResources();
+            bool caught = false;
+            try
+            {
+                OpenGL::DrawMesh(kept);
+            }
+            catch (const std::logic_error&)
+            {
+                caught = true;
+            }
+            std::cout << "  drawing the kept mesh afterwards : " << (caught ? "caught as stale" : "NOT CAUGHT") << '\n';
+        }
+    }
+
+    void RunShapeCacheBenchmark(int shape_count)
+    {
+        const auto count = static_cast<std::size_t>(std::max(1, shape_count));
+
+        // a mix like the --shapes scene : 48 prototypes seen at 8 to 400 pixels per unit
+        std::mt19937                                   random{ 5 };
+        std::uniform_real_distribution<float>          unit(0.0f, 1.0f);
+        std::vector<std::vector<std::array<float, 2>>> points;
+        for (int i = 0; i < 16; ++i)
+        {
+            std::vector<std::array<float, 2>> star;
+            for (int corner = 0; corner < 2 * (5 + i % 5); ++corner)
+            {
+                const float angle  = std::numbers::pi_v<float> * static_cast<float>(corner) / static_cast<float>(5 + i % 5);
+                const float radius = (corner % 2 == 0) ? 0.45f : 0.25f;
+                star.push_back({ radius * std::cos(angle), radius * std::sin(angle) });
+            }
+            points.push_back(std::move(star));
+        }
+        std::vector<OpenGL::Shape> prototypes;
+        for (int i = 0; i < 48; ++i)
+        {
+            const OpenGL::Color3 color{ unit(random), unit(random), unit(random) };
+            switch (i % 3)
+            {
+                case 0: prototypes.emplace_back(OpenGL::RoundedRect{ 1.0f, 0.4f + 0.6f * unit(random), 0.05f + 0.15f * unit(random), color }); break;
+                case 1: prototypes.emplace_back(OpenGL::Circle{ 0.5f, color }); break;
+                default: prototypes.emplace_back(OpenGL::Polyline{ points[static_cast<std::size_t>(i / 3)], 0.06f, true, color }); break;
+            }
+        }
+        struct Instance
+        {
+            std::size_t Prototype     = 0;
+            float       PixelsPerUnit = 0.0f;
+        };
+        std::vector<Instance> instances(count);
+        for (auto& instance : instances)
+        {
+            instance.Prototype     = random() % prototypes.size();
+            instance.PixelsPerUnit = 8.0f * std::pow(50.0f, unit(random));
+        }
+        const auto shapes_per_second = [count](double ms) { return static_cast<double>(count) / (ms / 1000.0); };
+
+        // no cache : every shape tessellated every frame. CPU only, uploading it all would come on top
+        OpenGL::ShapeGeometry geometry;
+        const double          tessellate_ms = milliseconds_per_run(
+            [&]
+            {
+                geometry.Vertices.clear();
+                geometry.Indices.clear();
+                for (const auto& instance : instances)
+                {
+                    const auto& shape = prototypes[instance.Prototype];
+                    OpenGL::Tessellate(shape, OpenGL::ShapeSegments(shape, instance.PixelsPerUnit), geometry);
+                }
+            });
+
+        // cold : emptied before every run, so each distinct shape is tessellated and uploaded once
+        OpenGL::ShapeCache cache;
+        const double       cold_ms = milliseconds_per_run(
+            [&]
+            {
+                cache.Clear();
+                for (const auto& instance : instances)
+                {
+                    const auto& shape = prototypes[instance.Prototype];
+                    [[maybe_unused]] const auto range = cache.Get(shape, OpenGL::ShapeSegments(shape, instance.PixelsPerUnit));
+                }
+                glFinish();
+            });
+        const auto unique_shapes = cache.GetShapeCount();
+        const auto cached_vertices = cache.GetVertexCount();
+
+        // warm : every Get() is a hash and a lookup
+        const double warm_ms = milliseconds_per_run(
+            [&]
+            {
+                for (const auto& instance : instances)
+                {
+                    const auto& shape = prototypes[instance.Prototype];
+                    [[maybe_unused]] const auto range = cache.Get(shape, OpenGL::ShapeSegments(shape, instance.PixelsPerUnit));
+                }
+            });
+
+        // held : what the scene does, the range is kept and only the segment count is checked
+        std::vector<OpenGL::ShapeCache::Range> ranges(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const auto& shape = prototypes[instances[i].Prototype];
+            ranges[i]         = cache.Get(shape, OpenGL::ShapeSegments(shape, instances[i].PixelsPerUnit));
+        }
+        std::size_t  refetched = 0;
+        const double held_ms   = milliseconds_per_run(
+            [&]
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    const auto& shape    = prototypes[instances[i].Prototype];
+                    const int   segments = OpenGL::ShapeSegments(shape, instances[i].PixelsPerUnit);
+                    if (!cache.IsCurrent(ranges[i]) || ranges[i].Segments != segments)
+                    {
+                        ranges[i] = cache.Get(shape, segments);
+                        ++refetched;
+                    }
+                }
+            });
+
+        std::cout << "shape cache benchmark : " << count << " shapes from " << prototypes.size() << " prototypes at 8 to 400 pixels per unit\n"
+                  << "  no cache : " << tessellate_ms << " ms, " << shapes_per_second(tessellate_ms) / 1e6 << " M shapes/s, " << geometry.Vertices.size()
+                  << " vertices tessellated every frame\n"
+                  << "  cold     : " << cold_ms << " ms, " << shapes_per_second(cold_ms) / 1e6 << " M shapes/s, " << unique_shapes << " distinct shapes, " << cached_vertices
+                  << " vertices uploaded\n"
+                  << "  warm     : " << warm_ms << " ms, " << shapes_per_second(warm_ms) / 1e6 << " M shapes/s\n"
+                  << "  held     : " << held_ms << " ms, " << shapes_per_second(held_ms) / 1e6 << " M shapes/s, " << refetched << " ranges fetched again\n";
+
+        // level of detail : segments per full circle and how far the chords get from the curve
+        std::cout << "  radius px -> segments (chord error px) :";
+        for (const float radius : { 2.0f, 8.0f, 32.0f, 128.0f, 512.0f, 2048.0f })
+        {
+            const int segments = OpenGL::SegmentsForRadius(radius);
+            std::cout << ' ' << radius << " -> " << segments << " (" << radius * (1.0f - std::cos(std::numbers::pi_v<float> / static_cast<float>(segments))) << ')';
+        }
+        std::cout << '\n';
+
+        // area of what was tessellated against the exact one, the triangles are counter clockwise so no abs()
+        const auto area = [](const OpenGL::Shape& shape, int segments)
+        {
+            OpenGL::ShapeGeometry triangles;
+            OpenGL::Tessellate(shape, segments, triangles);
+            double total = 0.0;
+            for (std::size_t i = 0; i < triangles.Indices.size(); i += 3)
+            {
+                const auto& a = triangles.Vertices[triangles.Indices[i]];
+                const auto& b = triangles.Vertices[triangles.Indices[i + 1]];
+                const auto& c = triangles.Vertices[triangles.Indices[i + 2]];
+                total += 0.5 * static_cast<double>((b.x - a.x) * (c.y - a.y) - (c.x - a.x) * (b.y - a.y));
+            }
+            return total;
+        };
+        const std::array<std::array<float, 2>, 4> square{ { { -0.5f, -0.5f }, { 0.5f, -0.5f }, { 0.5f, 0.5f }, { -0.5f, 0.5f } } };
+        const double                              pi = std::numbers::pi;
+        const double circle_error = std::abs(area(OpenGL::Circle{ 0.5f }, 256) / (0.25 * pi) - 1.0);
+        const double rect_error   = std::abs(area(OpenGL::RoundedRect{ 1.0f, 0.5f, 0.2f }, 256) / (0.5 - (4.0 - pi) * 0.04) - 1.0);
+        const double line_error   = std::abs(area(OpenGL::Polyline{ square, 0.1f, true }, 0) / (1.1 * 1.1 - 0.9 * 0.9) - 1.0);
+        std::cout << "  area error at 256 segments : circle " << 100.0 * circle_error << "%, rounded rect " << 100.0 * rect_error << "%, closed square line "
+                  << 100.0 * line_error << "%\n";
+    }
+}
@@ -0,0 +1,69 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include <filesystem>
+
+// Standalone measurements that run once and print their results, as opposed to the
+// benchmark scenes in main.cpp that measure every frame. All of them need a current GL context.
+namespace Benchmarks
+{
+    // compiles program_count synthetic programs one CreateShader at a time, then again through a ShaderLibrary
+    void RunShaderLibraryBenchmark(int program_count);
+
+    // set_count mat3 uploads through UniformLocations.at("...") versus SetUniform with a UniformID
+    void RunUniformLookupBenchmark(int set_count);
+
+    // object_count quads through every SIMD path of TransformShapes, checked against the scalar path, in vertices/second.
+    // Odd object counts and a shape longer than a chunk are checked too, returns false if any path didn't match
+    [[nodiscard]] bool RunTransformKernelBenchmark(int object_count);
+
+    // a grid mesh of about vertex_count vertices stored in every VertexFormat : bytes per vertex, encoding error and draw throughput
+    void RunVertexFormatBenchmark(int vertex_count);
+
+    // 1, 4, 16... up to max_megabytes streamed per frame through every supported StreamStrategy, in ms per frame and GB/s
+    void RunStreamBufferBenchmark(int max_megabytes);
+
+    // every .mesh under directory mapped and uploaded, against parsing the .obj / .json they came from, in MB/s
+    void RunMeshLoadBenchmark(const std::filesystem::path& directory);
+
+    // Assets/shaders copied into file_count files in a temporary folder, then read back the old way
+    // (istreambuf_iterator), with ReadTextFile, mapped, and through ReadFiles on 1 and every core, in files/s and MB/s
+    void RunFileLoadBenchmark(int file_count);
+
+    // ShaderHotReload with inotify and with polling : cost of an Update() when nothing changed,
+    // time from saving a file to the new program being in use, and a broken save keeping the old program
+    void RunShaderReloadBenchmark();
+
+    // object_count draws spread over a few programs and meshes recorded into CommandBuffers by 1, 2, 4... up to every core,
+    // then submitted in recording order and sorted : ms per record, speedup, state changes and submit time
+    void RunCommandRecordingBenchmark(int object_count);
+
+    // draw_count pieces of meshes with random programs, meshes and materials, submitted as recorded, sorted, sorted and merged
+    // where the index ranges touch, and with glMultiDrawElements for the rest : ms, draw calls and state changes
+    void RunRenderQueueBenchmark(int draw_count);
+
+    // LooseGrid maps of 10k, 100k and 1M objects at the same density : window sized query time, objects found,
+    // cost of moving objects, and the same query done by testing every object. No gl in this one
+    void RunCullingBenchmark();
+
+    // sprite_count images (mostly 8 to 64 px, every 8th up to 256) packed into 2048 px pages in arrival and tallest first order,
+    // then written as .tga files and loaded through a TextureAtlas with a 1, 4 and 16 MB per frame upload budget :
+    // packing efficiency, frames and worst frame until everything is up, upload MB/s, and every sprite read back to check it
+    void RunTextureAtlasBenchmark(int sprite_count);
+
+    // mesh_count meshes with a quarter of them replaced every frame, with a glGen* / glDelete* per object and then through
+    // the resource pool : ms per frame, gl calls, buffers recycled, memory lost to size classes, and a leaked mesh reported
+    // and caught as stale once ReleaseAllResources() ran
+    void RunResourceBenchmark(int mesh_count);
+
+    // shape_count rounded rects, circles and polylines from 48 prototypes at 8 to 400 pixels per unit : shapes/s tessellating
+    // all of them every frame, through an empty ShapeCache, a warm one, and with the ranges kept, plus the level of detail
+    // picked per radius and the area of what was tessellated against the exact one
+    void RunShapeCacheBenchmark(int shape_count);
+}
@@ -0,0 +1,789 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "CaptureReplay.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <gsl/gsl>
+#include <stdexcept>
+
+namespace
+{
+    using OpenGL::CaptureOp;
+    using OpenGL::Handle;
+
+    // walks the records of a mapped capture, everything is copied out since nothing in there is aligned
+    class Reader
+    {
+    public:
+        Reader(std::span<const std::byte> file_bytes, std::size_t start) : bytes(file_bytes), position(start)
+        {
+        }
+
+        [[nodiscard]] std::span<const std::byte> Bytes(std::uint64_t count)
+        {
+            if (count > bytes.size() - position)
+            {
+                throw std::runtime_error("capture is cut short at byte " + std::to_string(position) + '\n');
+            }
+            const auto result = bytes.subspan(position, gsl::narrow<std::size_t>(count));
+            position += result.size();
+            return result;
+        }
+
+        template <typename T>
+        [[nodiscard]] T Read()
+        {
+            T value{};
+            std::memcpy(&value, Bytes(sizeof(T)).data(), sizeof(T));
+            return value;
+        }
+
+        [[nodiscard]] std::span<const std::byte> ReadData()
+        {
+            return Bytes(Read<std::uint64_t>());
+        }
+
+        [[nodiscard]] std::string_view ReadString()
+        {
+            const auto text = Bytes(Read<std::uint32_t>());
+            return { reinterpret_cast<const char*>(text.data()), text.size() };
+        }
+
+        template <typename... Fields>
+        void Skip()
+        {
+            (void)Bytes((sizeof(Fields) + ... + 0));
+        }
+
+        [[nodiscard]] std::size_t Position() const noexcept
+        {
+            return position;
+        }
+
+        [[nodiscard]] bool AtEnd() const noexcept
+        {
+            return position == bytes.size();
+        }
+
+    private:
+        std::span<const std::byte> bytes;
+        std::size_t                position = 0;
+    };
+
+    [[nodiscard]] CaptureOp read_op(Reader& in)
+    {
+        const auto op = in.Read<std::uint8_t>();
+        if (op >= static_cast<std::uint8_t>(CaptureOp::Count))
+        {
+            throw std::runtime_error("unknown capture record " + std::to_string(op) + " at byte " + std::to_string(in.Position() - 1) + '\n');
+        }
+        return static_cast<CaptureOp>(op);
+    }
+
+    [[nodiscard]] bool is_draw(CaptureOp op) noexcept
+    {
+        return op == CaptureOp::DrawElements || op == CaptureOp::DrawElementsInstanced || op == CaptureOp::DrawArrays || op == CaptureOp::DrawArraysInstanced ||
+               op == CaptureOp::MultiDrawElements;
+    }
+
+    // the layouts are listed next to CaptureOp, Frame and Input are read by the caller
+    void skip_fields(CaptureOp op, Reader& in)
+    {
+        using i32 = std::int32_t;
+        using u32 = std::uint32_t;
+        using i64 = std::int64_t;
+        using u64 = std::uint64_t;
+        switch (op)
+        {
+            case CaptureOp::Frame: in.Skip<i32, i32>(); break;
+            case CaptureOp::Input: in.Skip<OpenGL::InputEvent>(); break;
+            case CaptureOp::Program:
+            {
+                in.Skip<u32>();
+                (void)in.ReadString();
+                (void)in.ReadString();
+                const auto count = in.Read<u32>();
+                for (u32 i = 0; i < count; ++i)
+                {
+                    in.Skip<i32>();
+                    (void)in.ReadString();
+                }
+                break;
+            }
+            case CaptureOp::UniformBlockBinding:
+                in.Skip<u32>();
+                (void)in.ReadString();
+                in.Skip<u32>();
+                break;
+            case CaptureOp::DeleteProgram:
+            case CaptureOp::DeleteBuffer:
+            case CaptureOp::DeleteVertexArray:
+            case CaptureOp::DeleteTexture:
+            case CaptureOp::UseProgram:
+            case CaptureOp::BindVertexArray:
+            case CaptureOp::BindTexture2D:
+            case CaptureOp::Clear:
+            case CaptureOp::EnableVertexAttribArray: in.Skip<u32>(); break;
+            case CaptureOp::BindBuffer:
+            case CaptureOp::VertexAttribDivisor:
+            case CaptureOp::TexParameteri:
+            case CaptureOp::UniformInt: in.Skip<u32, u32>(); break;
+            case CaptureOp::BindBufferBase: in.Skip<u32, u32, u32>(); break;
+            case CaptureOp::BindBufferRange: in.Skip<u32, u32, u32, i64, i64>(); break;
+            case CaptureOp::Viewport: in.Skip<i32, i32, i32, i32>(); break;
+            case CaptureOp::ClearColor: in.Skip<std::array<float, 4>>(); break;
+            case CaptureOp::BufferData:
+                in.Skip<u32, i64, u32>();
+                (void)in.ReadData();
+                break;
+            case CaptureOp::BufferSubData:
+            case CaptureOp::BufferWrite:
+                in.Skip<u32, i64>();
+                (void)in.ReadData();
+                break;
+            case CaptureOp::VertexAttribPointer: in.Skip<u32, i32, u32, std::uint8_t, i32, u64>(); break;
+            case CaptureOp::TexImage2D:
+                in.Skip<i32, i32, i32, u32, u32>();
+                (void)in.ReadData();
+                break;
+            case CaptureOp::TexSubImage2D:
+                in.Skip<i32, i32, i32, i32, u32, u32, u64>();
+                (void)in.ReadData();
+                break;
+            case CaptureOp::Uniform:
+                in.Skip<i32>();
+                (void)in.Bytes(in.Read<std::uint8_t>() * sizeof(float));
+                break;
+            case CaptureOp::DrawElements: in.Skip<u32, i32, u32, u64>(); break;
+            case CaptureOp::DrawElementsInstanced: in.Skip<u32, i32, u32, u64, i32>(); break;
+            case CaptureOp::DrawArrays: in.Skip<u32, i32, i32>(); break;
+            case CaptureOp::DrawArraysInstanced: in.Skip<u32, i32, i32, i32>(); break;
+            case CaptureOp::MultiDrawElements:
+            {
+                in.Skip<u32, u32>();
+                const auto count = in.Read<u32>();
+                (void)in.Bytes(std::uint64_t{ count } * (sizeof(i32) + sizeof(u64)));
+                break;
+            }
+            case CaptureOp::Count: break;
+        }
+    }
+
+    [[nodiscard]] const void* as_pointer(std::uint64_t offset)
+    {
+        return reinterpret_cast<const void*>(gsl::narrow<std::uintptr_t>(offset));
+    }
+
+    [[nodiscard]] const void* data_or_null(std::span<const std::byte> data) noexcept
+    {
+        return data.empty() ? nullptr : data.data();
+    }
+
+    [[nodiscard]] GLsizeiptr data_size(std::span<const std::byte> data)
+    {
+        return gsl::narrow<GLsizeiptr>(data.size());
+    }
+
+    // the captured name's replay twin, made the first time it comes up
+    template <typename Generate>
+    [[nodiscard]] Handle map_name(std::unordered_map<Handle, Handle>& names, Handle captured, Generate generate)
+    {
+        if (captured == 0)
+        {
+            return 0;
+        }
+        auto [found, added] = names.try_emplace(captured, 0);
+        if (added)
+        {
+            found->second = generate();
+        }
+        return found->second;
+    }
+
+    [[nodiscard]] Handle compile(GLenum type, std::string_view source)
+    {
+        const Handle  shader = glCreateShader(type);
+        const GLchar* text   = source.data();
+        const auto    length = gsl::narrow<GLint>(source.size());
+        glShaderSource(shader, 1, &text, &length);
+        glCompileShader(shader);
+        GLint compiled = GL_FALSE;
+        glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+        if (compiled == GL_FALSE)
+        {
+            std::string log(1024, '\0');
+            GLsizei     written = 0;
+            glGetShaderInfoLog(shader, gsl::narrow<GLsizei>(log.size()), &written, log.data());
+            log.resize(static_cast<std::size_t>(written));
+            glDeleteShader(shader);
+            throw std::runtime_error("captured shader doesn't compile here\n" + log);
+        }
+        return shader;
+    }
+
+    [[nodiscard]] Handle link(std::string_view vertex_source, std::string_view fragment_source)
+    {
+        const Handle vertex   = compile(GL_VERTEX_SHADER, vertex_source);
+        const Handle fragment = compile(GL_FRAGMENT_SHADER, fragment_source);
+        const Handle program  = glCreateProgram();
+        glAttachShader(program, vertex);
+        glAttachShader(program, fragment);
+        glLinkProgram(program);
+        glDeleteShader(vertex);
+        glDeleteShader(fragment);
+        GLint linked = GL_FALSE;
+        glGetProgramiv(program, GL_LINK_STATUS, &linked);
+        if (linked == GL_FALSE)
+        {
+            glDeleteProgram(program);
+            throw std::runtime_error("captured program doesn't link here\n");
+        }
+        return program;
+    }
+
+    template <typename Delete>
+    void delete_names(std::unordered_map<Handle, Handle>& names, Delete delete_name)
+    {
+        for (const auto& [captured, name] : names)
+        {
+            delete_name(name);
+        }
+        names.clear();
+    }
+}
+
+namespace OpenGL
+{
+    CaptureReplay::CaptureReplay(const std::filesystem::path& path) : file(path), recordCounts(static_cast<std::size_t>(CaptureOp::Count), 0)
+    {
+        const auto bytes = file.GetBytes();
+        Reader     in(bytes, 0);
+        const auto magic = in.Bytes(CaptureMagic.size());
+        if (std::memcmp(magic.data(), CaptureMagic.data(), CaptureMagic.size()) != 0)
+        {
+            throw std::runtime_error(path.string() + " isn't a capture\n");
+        }
+        if (const auto version = in.Read<std::uint32_t>(); version != CaptureVersion)
+        {
+            throw std::runtime_error(path.string() + " is capture version " + std::to_string(version) + ", this replay reads " + std::to_string(CaptureVersion) + '\n');
+        }
+        prologueStart = in.Position();
+        prologueEnd   = bytes.size();
+
+        // one pass to find where each frame is, nothing gets played
+        std::vector<InputEvent> inputs;
+        while (!in.AtEnd())
+        {
+            const std::size_t record = in.Position();
+            const CaptureOp   op     = read_op(in);
+            ++recordCounts[static_cast<std::size_t>(op)];
+            if (op == CaptureOp::Frame)
+            {
+                if (frames.empty())
+                {
+                    prologueEnd = record;
+                }
+                else
+                {
+                    frames.back().End = record;
+                }
+                FrameInfo frame;
+                frame.Width  = in.Read<std::int32_t>();
+                frame.Height = in.Read<std::int32_t>();
+                frame.First  = in.Position();
+                frame.Inputs = std::move(inputs);
+                inputs.clear();
+                frames.push_back(std::move(frame));
+                continue;
+            }
+            if (op == CaptureOp::Input)
+            {
+                inputs.push_back(in.Read<InputEvent>());
+                continue;
+            }
+            skip_fields(op, in);
+            if (is_draw(op) && !frames.empty())
+            {
+                ++frames.back().Draws;
+            }
+        }
+        if (!frames.empty())
+        {
+            frames.back().End = bytes.size();
+        }
+    }
+
+    void CaptureReplay::Restart()
+    {
+        Clear();
+        play(prologueStart, prologueEnd, nullptr, 0);
+    }
+
+    void CaptureReplay::PlayFrame(std::size_t frame, std::vector<DrawTiming>* draw_timings)
+    {
+        const auto& info = frames.at(frame);
+        if (draw_timings != nullptr)
+        {
+            // a timestamp before and after each draw
+            const auto needed = static_cast<std::size_t>(info.Draws) * 2;
+            if (queries.size() < needed)
+            {
+                const auto old_size = queries.size();
+                queries.resize(needed);
+                glGenQueries(gsl::narrow<GLsizei>(needed - old_size), queries.data() + old_size);
+            }
+        }
+        play(info.First, info.End, draw_timings, frame);
+    }
+
+    int CaptureReplay::GetMaxWidth() const noexcept
+    {
+        int width = 1;
+        for (const auto& frame : frames)
+        {
+            width = std::max(width, frame.Width);
+        }
+        return width;
+    }
+
+    int CaptureReplay::GetMaxHeight() const noexcept
+    {
+        int height = 1;
+        for (const auto& frame : frames)
+        {
+            height = std::max(height, frame.Height);
+        }
+        return height;
+    }
+
+    void CaptureReplay::play(std::size_t first, std::size_t end, std::vector<DrawTiming>* draw_timings, std::size_t frame)
+    {
+        Reader            in(file.GetBytes(), first);
+        int               draw_index   = 0;
+        const std::size_t first_timing = draw_timings != nullptr ? draw_timings->size() : 0;
+
+        const auto begin_draw = [&]
+        {
+            if (draw_timings != nullptr)
+            {
+                glQueryCounter(queries[static_cast<std::size_t>(draw_index) * 2], GL_TIMESTAMP);
+            }
+        };
+        const auto end_draw = [&](CaptureOp op, GLsizei count, GLsizei instances)
+        {
+            if (draw_timings != nullptr)
+            {
+                glQueryCounter(queries[static_cast<std::size_t>(draw_index) * 2 + 1], GL_TIMESTAMP);
+                draw_timings->push_back(DrawTiming{ frame, draw_index, op, count, instances, 0.0 });
+            }
+            ++draw_index;
+        };
+
+        while (in.Position() < end)
+        {
+            const CaptureOp op = read_op(in);
+            switch (op)
+            {
+                case CaptureOp::Frame:
+                case CaptureOp::Input:
+                case CaptureOp::Count: skip_fields(op, in); break;
+                case CaptureOp::Program:
+                {
+                    const auto captured        = in.Read<Handle>();
+                    const auto vertex_source   = in.ReadString();
+                    const auto fragment_source = in.ReadString();
+                    const auto count           = in.Read<std::uint32_t>();
+                    Program    program{ link(vertex_source, fragment_source), {} };
+                    for (std::uint32_t i = 0; i < count; ++i)
+                    {
+                        const auto        location = in.Read<GLint>();
+                        const std::string name{ in.ReadString() };
+                        program.Locations.emplace(location, glGetUniformLocation(program.Name, name.c_str()));
+                    }
+                    if (const auto old = programs.find(captured); old != programs.end())
+                    {
+                        glDeleteProgram(old->second.Name);
+                    }
+                    programs.insert_or_assign(captured, std::move(program));
+                    currentProgram = nullptr; // the map may have moved it, UseProgram comes next anyway
+                    break;
+                }
+                case CaptureOp::UniformBlockBinding:
+                {
+                    const auto        captured = in.Read<Handle>();
+                    const std::string name{ in.ReadString() };
+                    const auto        binding = in.Read<GLuint>();
+                    const Handle      program = programs.at(captured).Name;
+                    if (const auto index = glGetUniformBlockIndex(program, name.c_str()); index != GL_INVALID_INDEX)
+                    {
+                        glUniformBlockBinding(program, index, binding);
+                    }
+                    break;
+                }
+                case CaptureOp::DeleteProgram:
+                    if (const auto found = programs.find(in.Read<Handle>()); found != programs.end())
+                    {
+                        glDeleteProgram(found->second.Name);
+                        if (currentProgram == &found->second)
+                        {
+                            currentProgram = nullptr;
+                        }
+                        programs.erase(found);
+                    }
+                    break;
+                case CaptureOp::DeleteBuffer:
+                    if (const auto found = buffers.find(in.Read<Handle>()); found != buffers.end())
+                    {
+                        glDeleteBuffers(1, &found->second);
+                        if (copyWriteBuffer == found->second)
+                        {
+                            copyWriteBuffer = 0;
+                        }
+                        buffers.erase(found);
+                    }
+                    break;
+                case CaptureOp::DeleteVertexArray:
+                    if (const auto found = vertexArrays.find(in.Read<Handle>()); found != vertexArrays.end())
+                    {
+                        glDeleteVertexArrays(1, &found->second);
+                        vertexArrays.erase(found);
+                    }
+                    break;
+                case CaptureOp::DeleteTexture:
+                    if (const auto found = textures.find(in.Read<Handle>()); found != textures.end())
+                    {
+                        glDeleteTextures(1, &found->second);
+                        textures.erase(found);
+                    }
+                    break;
+                case CaptureOp::UseProgram:
+                {
+                    const auto captured = in.Read<Handle>();
+                    currentProgram      = nullptr;
+                    if (captured == 0)
+                    {
+                        glUseProgram(0);
+                        break;
+                    }
+                    const auto found = programs.find(captured);
+                    if (found == programs.end())
+                    {
+                        throw std::runtime_error("program " + std::to_string(captured) + " is used but was never captured, was the capture started before setup()?\n");
+                    }
+                    currentProgram = &found->second;
+                    glUseProgram(currentProgram->Name);
+                    break;
+                }
+                case CaptureOp::BindVertexArray: glBindVertexArray(vertex_array(in.Read<Handle>())); break;
+                case CaptureOp::BindBuffer:
+                {
+                    const auto   target = in.Read<GLenum>();
+                    const Handle name   = buffer(in.Read<Handle>());
+                    glBindBuffer(target, name);
+                    if (target == GL_COPY_WRITE_BUFFER)
+                    {
+                        copyWriteBuffer = name;
+                    }
+                    break;
+                }
+                case CaptureOp::BindBufferBase:
+                {
+                    const auto target = in.Read<GLenum>();
+                    const auto index  = in.Read<GLuint>();
+                    glBindBufferBase(target, index, buffer(in.Read<Handle>()));
+                    break;
+                }
+                case CaptureOp::BindBufferRange:
+                {
+                    const auto   target = in.Read<GLenum>();
+                    const auto   index  = in.Read<GLuint>();
+                    const Handle name   = buffer(in.Read<Handle>());
+                    const auto   offset = in.Read<std::int64_t>();
+                    const auto   size   = in.Read<std::int64_t>();
+                    glBindBufferRange(target, index, name, gsl::narrow<GLintptr>(offset), gsl::narrow<GLsizeiptr>(size));
+                    break;
+                }
+                case CaptureOp::BindTexture2D: glBindTexture(GL_TEXTURE_2D, texture(in.Read<Handle>())); break;
+                case CaptureOp::Viewport:
+                {
+                    const auto viewport = in.Read<std::array<GLint, 4>>();
+                    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+                    break;
+                }
+                case CaptureOp::ClearColor:
+                {
+                    const auto color = in.Read<std::array<float, 4>>();
+                    glClearColor(color[0], color[1], color[2], color[3]);
+                    break;
+                }
+                case CaptureOp::Clear: glClear(in.Read<GLbitfield>()); break;
+                case CaptureOp::BufferData:
+                {
+                    const auto target = in.Read<GLenum>();
+                    const auto size   = in.Read<std::int64_t>();
+                    const auto usage  = in.Read<GLenum>();
+                    const auto data   = in.ReadData();
+                    glBufferData(target, gsl::narrow<GLsizeiptr>(size), data_or_null(data), usage);
+                    break;
+                }
+                case CaptureOp::BufferSubData:
+                {
+                    const auto target = in.Read<GLenum>();
+                    const auto offset = in.Read<std::int64_t>();
+                    const auto data   = in.ReadData();
+                    glBufferSubData(target, gsl::narrow<GLintptr>(offset), data_size(data), data.data());
+                    break;
+                }
+                case CaptureOp::BufferWrite:
+                {
+                    // the captured run wrote through a mapping, any binding will do to write it here
+                    const Handle name   = buffer(in.Read<Handle>());
+                    const auto   offset = in.Read<std::int64_t>();
+                    const auto   data   = in.ReadData();
+                    glBindBuffer(GL_COPY_WRITE_BUFFER, name);
+                    glBufferSubData(GL_COPY_WRITE_BUFFER, gsl::narrow<GLintptr>(offset), data_size(data), data.data());
+                    glBindBuffer(GL_COPY_WRITE_BUFFER, copyWriteBuffer);
+                    break;
+                }
+                case CaptureOp::EnableVertexAttribArray: glEnableVertexAttribArray(in.Read<GLuint>()); break;
+                case CaptureOp::VertexAttribPointer:
+                {
+                    const auto location   = in.Read<GLuint>();
+                    const auto components = in.Read<GLint>();
+                    const auto type       = in.Read<GLenum>();
+                    const auto normalized = in.Read<std::uint8_t>();
+                    const auto stride     = in.Read<GLsizei>();
+                    const auto offset     = in.Read<std::uint64_t>();
+                    glVertexAttribPointer(location, components, type, normalized != 0 ? GL_TRUE : GL_FALSE, stride, as_pointer(offset));
+                    break;
+                }
+                case CaptureOp::VertexAttribDivisor:
+                {
+                    const auto location = in.Read<GLuint>();
+                    glVertexAttribDivisor(location, in.Read<GLuint>());
+                    break;
+                }
+                case CaptureOp::TexParameteri:
+                {
+                    const auto name = in.Read<GLenum>();
+                    glTexParameteri(GL_TEXTURE_2D, name, in.Read<GLint>());
+                    break;
+                }
+                case CaptureOp::TexImage2D:
+                {
+                    const auto internal_format = in.Read<GLint>();
+                    const auto width           = in.Read<GLsizei>();
+                    const auto height          = in.Read<GLsizei>();
+                    const auto format          = in.Read<GLenum>();
+                    const auto type            = in.Read<GLenum>();
+                    const auto data            = in.ReadData();
+                    glTexImage2D(GL_TEXTURE_2D, 0, internal_format, width, height, 0, format, type, data_or_null(data));
+                    break;
+                }
+                case CaptureOp::TexSubImage2D:
+                {
+                    const auto rect   = in.Read<std::array<GLint, 4>>();
+                    const auto format = in.Read<GLenum>();
+                    const auto type   = in.Read<GLenum>();
+                    const auto offset = in.Read<std::uint64_t>();
+                    const auto data   = in.ReadData();
+                    // no data : the pixels come from the unpack buffer the stream bound
+                    const void* pixels = data.empty() ? as_pointer(offset) : data.data();
+                    glTexSubImage2D(GL_TEXTURE_2D, 0, rect[0], rect[1], rect[2], rect[3], format, type, pixels);
+                    break;
+                }
+                case CaptureOp::Uniform:
+                {
+                    const GLint          location = uniform_location(in.Read<GLint>());
+                    const auto           count    = in.Read<std::uint8_t>();
+                    std::array<float, 9> v{};
+                    if (count > v.size())
+                    {
+                        throw std::runtime_error("uniform with " + std::to_string(count) + " floats in the capture\n");
+                    }
+                    std::memcpy(v.data(), in.Bytes(count * sizeof(float)).data(), count * sizeof(float));
+                    switch (count)
+                    {
+                        case 1: glUniform1f(location, v[0]); break;
+                        case 2: glUniform2f(location, v[0], v[1]); break;
+                        case 3: glUniform3f(location, v[0], v[1], v[2]); break;
+                        case 4: glUniform4f(location, v[0], v[1], v[2], v[3]); break;
+                        case 9: glUniformMatrix3fv(location, 1, GL_FALSE, v.data()); break;
+                        default: throw std::runtime_error("uniform with " + std::to_string(count) + " floats in the capture\n");
+                    }
+                    break;
+                }
+                case CaptureOp::UniformInt:
+                {
+                    const GLint location = uniform_location(in.Read<GLint>());
+                    glUniform1i(location, in.Read<GLint>());
+                    break;
+                }
+                case CaptureOp::DrawElements:
+                {
+                    const auto mode   = in.Read<GLenum>();
+                    const auto count  = in.Read<GLsizei>();
+                    const auto type   = in.Read<GLenum>();
+                    const auto offset = in.Read<std::uint64_t>();
+                    begin_draw();
+                    glDrawElements(mode, count, type, as_pointer(offset));
+                    end_draw(op, count, 1);
+                    break;
+                }
+                case CaptureOp::DrawElementsInstanced:
+                {
+                    const auto mode      = in.Read<GLenum>();
+                    const auto count     = in.Read<GLsizei>();
+                    const auto type      = in.Read<GLenum>();
+                    const auto offset    = in.Read<std::uint64_t>();
+                    const auto instances = in.Read<GLsizei>();
+                    begin_draw();
+                    glDrawElementsInstanced(mode, count, type, as_pointer(offset), instances);
+                    end_draw(op, count, instances);
+                    break;
+                }
+                case CaptureOp::DrawArrays:
+                {
+                    const auto mode         = in.Read<GLenum>();
+                    const auto first_vertex = in.Read<GLint>();
+                    const auto count        = in.Read<GLsizei>();
+                    begin_draw();
+                    glDrawArrays(mode, first_vertex, count);
+                    end_draw(op, count, 1);
+                    break;
+                }
+                case CaptureOp::DrawArraysInstanced:
+                {
+                    const auto mode         = in.Read<GLenum>();
+                    const auto first_vertex = in.Read<GLint>();
+                    const auto count        = in.Read<GLsizei>();
+                    const auto instances    = in.Read<GLsizei>();
+                    begin_draw();
+                    glDrawArraysInstanced(mode, first_vertex, count, instances);
+                    end_draw(op, count, instances);
+                    break;
+                }
+                case CaptureOp::MultiDrawElements:
+                {
+                    const auto mode  = in.Read<GLenum>();
+                    const auto type  = in.Read<GLenum>();
+                    const auto count = in.Read<std::uint32_t>();
+                    multiCounts.clear();
+                    multiOffsets.clear();
+                    GLsizei total = 0;
+                    for (std::uint32_t i = 0; i < count; ++i)
+                    {
+                        multiCounts.push_back(in.Read<GLsizei>());
+                        multiOffsets.push_back(as_pointer(in.Read<std::uint64_t>()));
+                        total += multiCounts.back();
+                    }
+                    begin_draw();
+                    glMultiDrawElements(mode, multiCounts.data(), type, multiOffsets.data(), gsl::narrow<GLsizei>(count));
+                    end_draw(op, total, 1);
+                    break;
+                }
+            }
+        }
+
+        if (draw_timings == nullptr)
+        {
+            return;
+        }
+        // waits for the gpu to get through the frame
+        for (std::size_t i = first_timing; i < draw_timings->size(); ++i)
+        {
+            auto&      timing = (*draw_timings)[i];
+            const auto pair   = static_cast<std::size_t>(timing.Index) * 2;
+            GLuint64   start  = 0;
+            GLuint64   finish = 0;
+            glGetQueryObjectui64v(queries[pair], GL_QUERY_RESULT, &start);
+            glGetQueryObjectui64v(queries[pair + 1], GL_QUERY_RESULT, &finish);
+            timing.GpuMs = static_cast<double>(finish - start) / 1'000'000.0;
+        }
+    }
+
+    void CaptureReplay::Clear() noexcept
+    {
+        glUseProgram(0);
+        glBindVertexArray(0);
+        delete_names(buffers, [](Handle name) { glDeleteBuffers(1, &name); });
+        delete_names(vertexArrays, [](Handle name) { glDeleteVertexArrays(1, &name); });
+        delete_names(textures, [](Handle name) { glDeleteTextures(1, &name); });
+        for (const auto& [captured, program] : programs)
+        {
+            glDeleteProgram(program.Name);
+        }
+        programs.clear();
+        currentProgram  = nullptr;
+        copyWriteBuffer = 0;
+        if (!queries.empty())
+        {
+            glDeleteQueries(static_cast<GLsizei>(queries.size()), queries.data());
+            queries.clear();
+        }
+    }
+
+    Handle CaptureReplay::buffer(Handle captured)
+    {
+        return map_name(buffers, captured,
+                        []
+                        {
+                            Handle name = 0;
+                            glGenBuffers(1, &name);
+                            return name;
+                        });
+    }
+
+    Handle CaptureReplay::vertex_array(Handle captured)
+    {
+        return map_name(vertexArrays, captured,
+                        []
+                        {
+                            Handle name = 0;
+                            glGenVertexArrays(1, &name);
+                            return name;
+                        });
+    }
+
+    Handle CaptureReplay::texture(Handle captured)
+    {
+        return map_name(textures, captured,
+                        []
+                        {
+                            Handle name = 0;
+                            glGenTextures(1, &name);
+                            return name;
+                        });
+    }
+
+    GLint CaptureReplay::uniform_location(GLint captured) const
+    {
+        if (currentProgram == nullptr)
+        {
+            return -1;
+        }
+        const auto found = currentProgram->Locations.find(captured);
+        return found != currentProgram->Locations.end() ? found->second : -1;
+    }
+
+    std::string_view CaptureOpName(CaptureOp op) noexcept
+    {
+        // in CaptureOp order
+        constexpr std::array<std::string_view, static_cast<std::size_t>(CaptureOp::Count)> names{
+            "Frame",          "Input",          "Program",         "UniformBlockBinding",     "DeleteProgram",       "DeleteBuffer",          "DeleteVertexArray",
+            "DeleteTexture",  "UseProgram",     "BindVertexArray", "BindBuffer",              "BindBufferBase",      "BindBufferRange",       "BindTexture2D",
+            "Viewport",       "ClearColor",     "Clear",           "BufferData",              "BufferSubData",       "BufferWrite",           "EnableVertexAttribArray",
+            "VertexAttribPointer", "VertexAttribDivisor", "TexParameteri", "TexImage2D",      "TexSubImage2D",       "Uniform",               "UniformInt",
+            "DrawElements",   "DrawElementsInstanced", "DrawArrays", "DrawArraysInstanced",   "MultiDrawElements",
+        };
+        const auto index = static_cast<std::size_t>(op);
+        return index < names.size() ? names[index] : "Unknown";
+    }
+}
@@ -0,0 +1,123 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include "FrameCapture.hpp"
+#include "Handle.hpp"
+#include "MappedFile.hpp"
+#include <GL/glew.h>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace OpenGL
+{
+    // Plays a file written by StartCapture() back, call for call, with no app logic behind it.
+    // The same frames get drawn every time, so two builds (or two drivers) can be timed on exactly the same work.
+    //
+    // The file stays mapped and records are decoded as they are played, a few bytes copied per call.
+    // Gl names of the captured run are mapped to the replay's own the first time they show up, and uniform
+    // locations are looked up again by name in the programs the replay compiled.
+    //
+    // Frames build on each other (buffers written once and drawn for a hundred frames), so Restart() to play
+    // setup, then play them in order starting with frame 0. Opening the file needs no context, playing does.
+    class CaptureReplay
+    {
+    public:
+        struct FrameInfo
+        {
+            int                     Width  = 0;
+            int                     Height = 0;
+            std::size_t             First  = 0; // byte offset of the first record after the Frame one
+            std::size_t             End    = 0;
+            int                     Draws  = 0; // a multi draw counts once
+            std::vector<InputEvent> Inputs{};   // what the app reacted to right before drawing it
+        };
+
+        // one draw call of a frame, when PlayFrame() was asked to time them
+        struct DrawTiming
+        {
+            std::size_t Frame     = 0;
+            int         Index     = 0; // in the frame
+            CaptureOp   Op        = CaptureOp::DrawElements;
+            GLsizei     Count     = 0; // indices or vertices, all ranges of a multi draw together
+            GLsizei     Instances = 1;
+            double      GpuMs     = 0.0;
+        };
+
+        // throws std::runtime_error if the file can't be read, isn't a capture or is cut short
+        explicit CaptureReplay(const std::filesystem::path& path);
+
+        CaptureReplay(const CaptureReplay&)            = delete;
+        CaptureReplay& operator=(const CaptureReplay&) = delete;
+
+        // Clear(), then plays setup
+        void Restart();
+        // deletes every gl object the replay made, do it before the context goes away
+        void Clear() noexcept;
+        // draw_timings gets one entry per draw, timed with GL_TIMESTAMP queries on both sides.
+        // That waits for the gpu at the end of the frame, leave it null to time whole frames
+        void PlayFrame(std::size_t frame, std::vector<DrawTiming>* draw_timings = nullptr);
+
+        [[nodiscard]] const std::vector<FrameInfo>& GetFrames() const noexcept
+        {
+            return frames;
+        }
+
+        // what a framebuffer needs to hold every frame
+        [[nodiscard]] int GetMaxWidth() const noexcept;
+        [[nodiscard]] int GetMaxHeight() const noexcept;
+
+        [[nodiscard]] std::size_t GetFileSize() const noexcept
+        {
+            return file.GetBytes().size();
+        }
+
+        // records of each CaptureOp in the whole file, for --list
+        [[nodiscard]] const std::vector<std::size_t>& GetRecordCounts() const noexcept
+        {
+            return recordCounts;
+        }
+
+    private:
+        struct Program
+        {
+            Handle                           Name = 0;
+            std::unordered_map<GLint, GLint> Locations{}; // captured -> ours, -1 when our compiler dropped it
+        };
+
+        void play(std::size_t first, std::size_t end, std::vector<DrawTiming>* draw_timings, std::size_t frame);
+        [[nodiscard]] Handle buffer(Handle captured);
+        [[nodiscard]] Handle vertex_array(Handle captured);
+        [[nodiscard]] Handle texture(Handle captured);
+        [[nodiscard]] GLint  uniform_location(GLint captured) const;
+
+    private:
+        MappedFile                          file;
+        std::size_t                         prologueStart = 0; // setup : from after the header to the first Frame record
+        std::size_t                         prologueEnd   = 0;
+        std::vector<FrameInfo>              frames{};
+        std::vector<std::size_t>            recordCounts{};
+        std::unordered_map<Handle, Handle>  buffers{};
+        std::unordered_map<Handle, Handle>  vertexArrays{};
+        std::unordered_map<Handle, Handle>  textures{};
+        std::unordered_map<Handle, Program> programs{};
+        const Program*                      currentProgram  = nullptr;
+        Handle                              copyWriteBuffer = 0; // ours, put back after a BufferWrite borrowed the binding
+        std::vector<GLuint>                 queries{};
+        std::vector<GLsizei>                multiCounts{};
+        std::vector<const void*>            multiOffsets{};
+    };
+
+    [[nodiscard]] std::string_view CaptureOpName(CaptureOp op) noexcept;
+}
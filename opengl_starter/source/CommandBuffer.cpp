@@ -0,0 +1,169 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "CommandBuffer.hpp"
+
+#include "FrameCapture.hpp"
+#include "GLState.hpp"
+#include "Uniform.hpp"
+#include "VertexLayout.hpp"
+#include <algorithm>
+#include <array>
+
+namespace
+{
+    // least significant byte first, 8 passes at most. One pass over the keys counts all 8 bytes, and a byte
+    // that is the same in every key (unused layers, the user bits of unsorted draws) costs nothing more
+    template <typename T>
+    void radix_sort_by_key(std::vector<T>& items, std::vector<T>& scratch)
+    {
+        if (items.size() < 2)
+        {
+            return;
+        }
+        std::array<std::array<std::size_t, 256>, 8> counts{};
+        for (const auto& item : items)
+        {
+            for (std::size_t pass = 0; pass < counts.size(); ++pass)
+            {
+                ++counts[pass][(item.Key >> (8 * pass)) & 0xFFu];
+            }
+        }
+        scratch.resize(items.size());
+        for (std::size_t pass = 0; pass < counts.size(); ++pass)
+        {
+            auto&          count = counts[pass];
+            const unsigned shift = 8 * static_cast<unsigned>(pass);
+            if (count[(items.front().Key >> shift) & 0xFFu] == items.size())
+            {
+                continue;
+            }
+            std::size_t offset = 0;
+            for (auto& slot : count)
+            {
+                offset += std::exchange(slot, offset);
+            }
+            // stable : equal bytes keep the order of the previous pass
+            for (const auto& item : items)
+            {
+                scratch[count[(item.Key >> shift) & 0xFFu]++] = item;
+            }
+            items.swap(scratch);
+        }
+    }
+
+    [[nodiscard]] bool same_uniforms(const OpenGL::DrawCommand& a, const OpenGL::DrawCommand& b) noexcept
+    {
+        return a.Model == b.Model && a.Color == b.Color;
+    }
+
+    // everything but the index range is the same, so one draw call can do both
+    [[nodiscard]] bool can_draw_together(const OpenGL::DrawCommand& a, const OpenGL::DrawCommand& b) noexcept
+    {
+        return a.Shader->Shader == b.Shader->Shader && a.VertexArray == b.VertexArray && a.IndexType == b.IndexType && same_uniforms(a, b);
+    }
+
+    void count_changes(OpenGL::StateChanges& changes, const OpenGL::DrawCommand* previous, const OpenGL::DrawCommand& command) noexcept
+    {
+        const bool new_program = previous == nullptr || previous->Shader->Shader != command.Shader->Shader;
+        changes.Programs += new_program ? 1 : 0;
+        changes.VertexArrays += (previous == nullptr || previous->VertexArray != command.VertexArray) ? 1 : 0;
+        changes.Uniforms += (new_program || !same_uniforms(*previous, command)) ? 1 : 0;
+    }
+}
+
+namespace OpenGL
+{
+    SubmitStatistics CommandSubmitter::Submit(std::span<const CommandBuffer> buffers, SubmitOptions options)
+    {
+        SubmitStatistics   statistics{};
+        const DrawCommand* previous = nullptr;
+        order.clear();
+        for (const auto& buffer : buffers)
+        {
+            for (const auto& command : buffer.GetCommands())
+            {
+                order.push_back(Entry{ command.Key, &command });
+                count_changes(statistics.Recorded, previous, command);
+                previous = &command;
+            }
+        }
+        statistics.Commands = static_cast<int>(order.size());
+        if (options.Sorted)
+        {
+            // moves 16 byte entries around instead of whole commands
+            radix_sort_by_key(order, sortScratch);
+        }
+
+        Handle program      = 0;
+        Handle vertex_array = 0;
+        previous            = nullptr;
+        for (std::size_t first = 0; first < order.size();)
+        {
+            const DrawCommand& command = *order[first].Command;
+            count_changes(statistics.Submitted, previous, command);
+            if (command.Shader->Shader != program || previous == nullptr)
+            {
+                program = command.Shader->Shader;
+                UseProgram(program);
+            }
+            if (command.VertexArray != vertex_array || previous == nullptr)
+            {
+                vertex_array = command.VertexArray;
+                BindVertexArray(vertex_array);
+            }
+            SetUniform(*command.Shader, UniformIDs::uModel, command.Model);
+            SetUniform(*command.Shader, UniformIDs::uColor, command.Color[0], command.Color[1], command.Color[2], command.Color[3]);
+
+            // the run of commands that only differ in their index range, each range glued onto the one before when they touch
+            const std::size_t index_size = IndexSize(command.IndexType);
+            drawCounts.clear();
+            drawOffsets.clear();
+            std::size_t   last      = first + 1;
+            std::uint32_t range_end = command.FirstIndex + static_cast<std::uint32_t>(command.IndexCount);
+            drawCounts.push_back(command.IndexCount);
+            drawOffsets.push_back(reinterpret_cast<const void*>(static_cast<std::uintptr_t>(command.FirstIndex) * index_size));
+            for (; last < order.size() && can_draw_together(command, *order[last].Command); ++last)
+            {
+                const DrawCommand& next = *order[last].Command;
+                if (options.Merged && next.FirstIndex == range_end)
+                {
+                    drawCounts.back() += next.IndexCount;
+                    ++statistics.Merged;
+                }
+                else if (options.MultiDraw)
+                {
+                    drawCounts.push_back(next.IndexCount);
+                    drawOffsets.push_back(reinterpret_cast<const void*>(static_cast<std::uintptr_t>(next.FirstIndex) * index_size));
+                }
+                else
+                {
+                    break;
+                }
+                range_end = next.FirstIndex + static_cast<std::uint32_t>(next.IndexCount);
+            }
+            previous = order[last - 1].Command;
+            first    = last;
+
+#if !defined(__EMSCRIPTEN__)
+            if (drawCounts.size() > 1)
+            {
+                MultiDrawElements(GL_TRIANGLES, drawCounts, command.IndexType, drawOffsets);
+                ++statistics.MultiDraws;
+                ++statistics.DrawCalls;
+                continue;
+            }
+#endif
+            for (std::size_t i = 0; i < drawCounts.size(); ++i)
+            {
+                DrawElements(GL_TRIANGLES, drawCounts[i], command.IndexType, reinterpret_cast<std::uintptr_t>(drawOffsets[i]));
+                ++statistics.DrawCalls;
+            }
+        }
+        return statistics;
+    }
+}
@@ -0,0 +1,130 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include "Handle.hpp"
+#include "Math.hpp"
+#include "Shader.hpp"
+#include <GL/glew.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace OpenGL
+{
+    // One glDrawElements and everything it needs, as plain data.
+    // Recording one doesn't touch gl, so any thread can fill a CommandBuffer. Only CommandSubmitter::Submit(),
+    // on the gl thread, looks inside Shader.
+    struct DrawCommand
+    {
+        std::uint64_t        Key         = 0;       // MakeSortKey(), draws go out smallest key first
+        CompiledShader*      Shader      = nullptr; // program and its uniform tables
+        Handle               VertexArray = 0;       // with its element buffer
+        GLenum               IndexType   = GL_UNSIGNED_SHORT;
+        GLsizei              IndexCount  = 0;
+        std::uint32_t        FirstIndex  = 0;
+        Math::mat3           Model       = Math::IdentityMatrix(); // uModel
+        std::array<float, 4> Color{ 1.0f, 1.0f, 1.0f, 1.0f };      // uColor, ignored by programs without it
+    };
+
+    // | layer 8 | program 16 | vertex array 16 | user 24 |
+    // Sorting by it keeps draws with the same program together, then the same VAO, so each bind happens once.
+    // Names past 16 bits share a slot with another one : only the grouping gets worse, Submit() compares the real handles.
+    // user : anything that should decide the order between otherwise equal draws. Usually the material (what uModel
+    // and uColor are) in the high bits, so draws sharing them end up next to each other and can be merged, then
+    // front to back or the first index
+    [[nodiscard]] constexpr std::uint64_t MakeSortKey(std::uint8_t layer, Handle program, Handle vertex_array, std::uint32_t user = 0) noexcept
+    {
+        return (std::uint64_t{ layer } << 56) | (std::uint64_t{ program & 0xFFFFu } << 40) | (std::uint64_t{ vertex_array & 0xFFFFu } << 24) | (user & 0xFF'FFFFu);
+    }
+
+    // the commands of one thread, keep one per worker and Clear() them every frame
+    class CommandBuffer
+    {
+    public:
+        void Reserve(std::size_t command_count)
+        {
+            commands.reserve(command_count);
+        }
+
+        void Clear() noexcept
+        {
+            commands.clear(); // keeps the memory, recording doesn't allocate after the first frames
+        }
+
+        void Draw(const DrawCommand& command)
+        {
+            commands.push_back(command);
+        }
+
+        [[nodiscard]] std::span<const DrawCommand> GetCommands() const noexcept
+        {
+            return commands;
+        }
+
+    private:
+        std::vector<DrawCommand> commands{};
+    };
+
+    // consecutive commands that differ in each of these
+    struct StateChanges
+    {
+        int Programs     = 0;
+        int VertexArrays = 0;
+        int Uniforms     = 0; // uModel or uColor
+
+        [[nodiscard]] int Total() const noexcept
+        {
+            return Programs + VertexArrays + Uniforms;
+        }
+    };
+
+    struct SubmitStatistics
+    {
+        int          Commands   = 0;
+        int          DrawCalls  = 0; // glDrawElements + glMultiDrawElements
+        int          Merged     = 0; // commands whose indices were folded into the command before them
+        int          MultiDraws = 0; // glMultiDrawElements calls, each one stands in for several draws
+        StateChanges Recorded{};     // what the commands would cost in the order they were recorded
+        StateChanges Submitted{};    // what they cost as submitted
+    };
+
+    struct SubmitOptions
+    {
+        bool Sorted    = true; // false replays them in the order of the buffers, to see what the sort saves
+        bool Merged    = true; // one draw for neighbours with the same state whose index ranges touch
+        bool MultiDraw = true; // one glMultiDrawElements for neighbours with the same state, desktop gl only
+    };
+
+    // Replays command buffers on the gl thread.
+    // Every buffer's commands go into one list, radix sorted by Key. The sort is stable, so equal keys keep
+    // the order they were recorded in. Then they go out through the state cache, and uModel / uColor are only
+    // set when they change. Neighbours that also share uModel, uColor, the index type and the VAO are drawn
+    // together : index ranges that follow each other become one glDrawElements, and whatever is left over
+    // one glMultiDrawElements where there is one (not in GLES3 / WebGL2).
+    class CommandSubmitter
+    {
+    public:
+        SubmitStatistics Submit(std::span<const CommandBuffer> buffers, SubmitOptions options = {});
+
+    private:
+        struct Entry
+        {
+            std::uint64_t      Key;
+            const DrawCommand* Command;
+        };
+
+        // kept between frames
+        std::vector<Entry>       order{};
+        std::vector<Entry>       sortScratch{};
+        std::vector<GLsizei>     drawCounts{};
+        std::vector<const void*> drawOffsets{};
+    };
+}
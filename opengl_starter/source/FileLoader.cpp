@@ -0,0 +1,185 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "FileLoader.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <fstream>
+#include <gsl/gsl>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace
+{
+    constexpr std::size_t minimum_block_size = 64 * 1024;
+
+    [[nodiscard]] std::runtime_error cannot_read(const std::filesystem::path& file_path)
+    {
+        return std::runtime_error("Cannot open " + file_path.string());
+    }
+
+    [[nodiscard]] std::size_t size_of_file(const std::filesystem::path& file_path)
+    {
+        std::error_code error;
+        const auto      size = std::filesystem::file_size(file_path, error);
+        if (error)
+        {
+            throw cannot_read(file_path);
+        }
+        return gsl::narrow<std::size_t>(size);
+    }
+
+    // one read for the whole file, a read this big skips the stream's own buffer and goes straight to the os
+    void read_into(const std::filesystem::path& file_path, std::span<char> destination)
+    {
+        std::ifstream ifs(file_path, std::ios::in | std::ios::binary);
+        if (!ifs)
+        {
+            throw cannot_read(file_path);
+        }
+        ifs.read(destination.data(), gsl::narrow<std::streamsize>(destination.size()));
+        if (gsl::narrow<std::size_t>(ifs.gcount()) != destination.size())
+        {
+            throw std::runtime_error(file_path.string() + " : got shorter while it was being read");
+        }
+    }
+
+    // size bytes plus the '\0' after them
+    [[nodiscard]] std::span<char> allocate_text(OpenGL::FileArena& arena, std::size_t size)
+    {
+        const auto memory = arena.Allocate(size + 1);
+        memory[size]      = '\0';
+        return memory.first(size);
+    }
+}
+
+namespace OpenGL
+{
+    FileArena::FileArena(std::size_t initial_capacity)
+    {
+        if (initial_capacity > 0)
+        {
+            blocks.push_back(Block{ std::make_unique<char[]>(initial_capacity), initial_capacity });
+        }
+    }
+
+    std::span<char> FileArena::Allocate(std::size_t bytes)
+    {
+        if (blocks.empty() || blocks.back().Size - offset < bytes)
+        {
+            // doubling, so a batch bigger than the arena only needs a few blocks before Reset() merges them
+            const std::size_t size = std::max({ bytes, minimum_block_size, blocks.empty() ? 0 : 2 * blocks.back().Size });
+            blocks.push_back(Block{ std::make_unique<char[]>(size), size });
+            offset = 0;
+        }
+        const auto memory = std::span{ blocks.back().Memory.get(), blocks.back().Size }.subspan(offset, bytes);
+        offset += bytes;
+        used += bytes;
+        return memory;
+    }
+
+    void FileArena::Reset()
+    {
+        if (blocks.size() > 1)
+        {
+            // next time everything fits in one block
+            const std::size_t size = GetCapacity();
+            blocks.clear();
+            blocks.push_back(Block{ std::make_unique<char[]>(size), size });
+        }
+        offset = 0;
+        used   = 0;
+    }
+
+    std::size_t FileArena::GetCapacity() const noexcept
+    {
+        std::size_t capacity = 0;
+        for (const auto& block : blocks)
+        {
+            capacity += block.Size;
+        }
+        return capacity;
+    }
+
+    std::string_view ReadFile(const std::filesystem::path& file_path, FileArena& arena)
+    {
+        const auto text = allocate_text(arena, size_of_file(file_path));
+        read_into(file_path, text);
+        return { text.data(), text.size() };
+    }
+
+    std::vector<std::string_view> ReadFiles(std::span<const std::filesystem::path> file_paths, FileArena& arena, [[maybe_unused]] unsigned worker_count)
+    {
+        // every allocation happens here, the workers only write into their own span
+        std::vector<std::span<char>>  destinations;
+        std::vector<std::string_view> texts;
+        destinations.reserve(file_paths.size());
+        texts.reserve(file_paths.size());
+        for (const auto& file_path : file_paths)
+        {
+            destinations.push_back(allocate_text(arena, size_of_file(file_path)));
+            texts.emplace_back(destinations.back().data(), destinations.back().size());
+        }
+
+#if defined(__EMSCRIPTEN__)
+        // no pthreads in this build
+        const std::size_t thread_count = 1;
+#else
+        const unsigned    workers      = (worker_count == 0) ? std::max(1u, std::thread::hardware_concurrency()) : worker_count;
+        const std::size_t thread_count = std::min<std::size_t>(workers, file_paths.size());
+#endif
+
+        std::atomic<std::size_t> next{ 0 };
+        std::mutex               error_mutex;
+        std::exception_ptr       first_error;
+        const auto               read_until_done = [&]
+        {
+            for (std::size_t i = next++; i < file_paths.size(); i = next++)
+            {
+                try
+                {
+                    read_into(file_paths[i], destinations[i]);
+                }
+                catch (...)
+                {
+                    const std::lock_guard lock(error_mutex);
+                    if (!first_error)
+                    {
+                        first_error = std::current_exception();
+                    }
+                }
+            }
+        };
+
+        // this thread is one of the workers
+        std::vector<std::thread> threads;
+        for (std::size_t i = 1; i < thread_count; ++i)
+        {
+            threads.emplace_back(read_until_done);
+        }
+        read_until_done();
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        if (first_error)
+        {
+            std::rethrow_exception(first_error);
+        }
+        return texts;
+    }
+
+    std::string ReadTextFile(const std::filesystem::path& file_path)
+    {
+        std::string text(size_of_file(file_path), '\0');
+        read_into(file_path, text);
+        return text;
+    }
+}
@@ -0,0 +1,66 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace OpenGL
+{
+    // Bump allocator for file contents. Loading a batch of assets allocates from big blocks instead of one
+    // std::string per file, and Reset() keeps the memory for the next batch (merged into one block if it had to grow).
+    class FileArena
+    {
+    public:
+        explicit FileArena(std::size_t initial_capacity = 0);
+
+        FileArena(const FileArena&)            = delete;
+        FileArena& operator=(const FileArena&) = delete;
+
+        // valid until Reset() or the arena goes away
+        [[nodiscard]] std::span<char> Allocate(std::size_t bytes);
+        // forgets every allocation, keeps the memory
+        void Reset();
+
+        [[nodiscard]] std::size_t GetUsed() const noexcept
+        {
+            return used;
+        }
+
+        [[nodiscard]] std::size_t GetCapacity() const noexcept;
+
+    private:
+        struct Block
+        {
+            std::unique_ptr<char[]> Memory{};
+            std::size_t             Size = 0;
+        };
+
+        std::vector<Block> blocks{};
+        std::size_t        offset = 0; // in blocks.back()
+        std::size_t        used   = 0; // every allocation since Reset()
+    };
+
+    // Whole file with one read call into the arena (no per character copying).
+    // The text is followed by a '\0' that isn't part of the view, so .data() can still go to C apis.
+    // Throws std::runtime_error when the file can't be read.
+    [[nodiscard]] std::string_view ReadFile(const std::filesystem::path& file_path, FileArena& arena);
+
+    // Same for a batch: sizes are asked for first, so every file gets its spot in the arena up front,
+    // then worker_count threads read them in parallel (0 : one per core, 1 : on this thread, always 1 on the web).
+    // Views come back in the order of file_paths. Throws the first error once every thread is done.
+    [[nodiscard]] std::vector<std::string_view> ReadFiles(std::span<const std::filesystem::path> file_paths, FileArena& arena, unsigned worker_count = 0);
+
+    // for callers that want to own the text
+    [[nodiscard]] std::string ReadTextFile(const std::filesystem::path& file_path);
+}
@@ -0,0 +1,263 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "FrameCapture.hpp"
+
+#include "GLState.hpp"
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+    struct Capture
+    {
+        bool                   Active    = false;
+        std::ofstream          File{};
+        std::filesystem::path  Path{};
+        std::vector<std::byte> Pending{}; // the frame being recorded, written out when the next one starts
+        int                    Frames    = 0;
+        int                    MaxFrames = 0;
+        std::uint64_t          Bytes     = 0;
+    };
+
+    Capture gCapture;
+
+    void flush_pending()
+    {
+        gCapture.File.write(reinterpret_cast<const char*>(gCapture.Pending.data()), static_cast<std::streamsize>(gCapture.Pending.size()));
+        gCapture.Bytes += gCapture.Pending.size();
+        gCapture.Pending.clear();
+    }
+
+    [[nodiscard]] std::uint64_t bytes_per_pixel(GLenum format, GLenum type) noexcept
+    {
+        std::uint64_t components = 4;
+        switch (format)
+        {
+            case GL_RED: components = 1; break;
+            case GL_RG: components = 2; break;
+            case GL_RGB: components = 3; break;
+            default: break;
+        }
+        switch (type)
+        {
+            case GL_FLOAT: return components * 4;
+            case GL_HALF_FLOAT: return components * 2;
+            default: return components;
+        }
+    }
+
+    // client memory pixels go in the file, with an unpack buffer bound they are already in a captured buffer
+    [[nodiscard]] OpenGL::CaptureData pixel_data(GLsizei width, GLsizei height, GLenum format, GLenum type, const void* pixels)
+    {
+        GLint unpack_buffer = 0;
+        glGetIntegerv(GL_PIXEL_UNPACK_BUFFER_BINDING, &unpack_buffer);
+        if (unpack_buffer != 0 || pixels == nullptr)
+        {
+            return {};
+        }
+        return OpenGL::CaptureData{ pixels, static_cast<std::uint64_t>(width) * static_cast<std::uint64_t>(height) * bytes_per_pixel(format, type) };
+    }
+}
+
+namespace OpenGL
+{
+    void StartCapture(const std::filesystem::path& path, int max_frames)
+    {
+        StopCapture();
+        gCapture.File.open(path, std::ios::binary | std::ios::trunc);
+        if (!gCapture.File)
+        {
+            throw std::runtime_error("Unable to write the capture " + path.string() + '\n');
+        }
+        gCapture.Active    = true;
+        gCapture.Path      = path;
+        gCapture.Frames    = 0;
+        gCapture.MaxFrames = max_frames;
+        gCapture.Bytes     = 0;
+        gCapture.Pending.clear();
+        WriteCaptureBytes(CaptureMagic.data(), CaptureMagic.size());
+        WriteCaptureField(CaptureVersion);
+        // whatever the state cache thinks is bound was never written down, the first use of everything has to be
+        InvalidateState();
+    }
+
+    void StopCapture()
+    {
+        if (!gCapture.Active)
+        {
+            return;
+        }
+        flush_pending();
+        gCapture.File.close();
+        gCapture.Active = false;
+        std::cout << "capture : " << gCapture.Frames << " frames, " << static_cast<double>(gCapture.Bytes) / (1024.0 * 1024.0) << " MB written to " << gCapture.Path.string() << '\n';
+    }
+
+    bool IsCapturing() noexcept
+    {
+        return gCapture.Active;
+    }
+
+    void CaptureFrame(int width, int height)
+    {
+        if (!gCapture.Active)
+        {
+            return;
+        }
+        if (gCapture.Frames == gCapture.MaxFrames)
+        {
+            StopCapture();
+            return;
+        }
+        flush_pending();
+        CaptureRecord(CaptureOp::Frame, std::int32_t{ width }, std::int32_t{ height });
+        ++gCapture.Frames;
+    }
+
+    void CaptureInput(const InputEvent& event)
+    {
+        CaptureRecord(CaptureOp::Input, event);
+    }
+
+    void CaptureProgram(Handle program, std::string_view vertex_source, std::string_view fragment_source, const std::unordered_map<std::string, GLint>& uniform_locations)
+    {
+        if (!gCapture.Active)
+        {
+            return;
+        }
+        // the replay's locations can differ, it looks its own up by name
+        CaptureRecord(CaptureOp::Program, program, vertex_source, fragment_source, static_cast<std::uint32_t>(uniform_locations.size()));
+        for (const auto& [name, location] : uniform_locations)
+        {
+            WriteCaptureField(location);
+            WriteCaptureField(std::string_view{ name });
+        }
+    }
+
+    void WriteCaptureBytes(const void* data, std::size_t bytes)
+    {
+        const auto* first = static_cast<const std::byte*>(data);
+        gCapture.Pending.insert(gCapture.Pending.end(), first, first + bytes);
+    }
+
+    void BufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage)
+    {
+        glBufferData(target, size, data, usage);
+        CaptureRecord(CaptureOp::BufferData, target, std::int64_t{ size }, usage, CaptureData{ data, data == nullptr ? 0 : static_cast<std::uint64_t>(size) });
+    }
+
+    void BufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data)
+    {
+        glBufferSubData(target, offset, size, data);
+        CaptureRecord(CaptureOp::BufferSubData, target, std::int64_t{ offset }, CaptureData{ data, static_cast<std::uint64_t>(size) });
+    }
+
+    void CaptureBufferWrite(Handle buffer, GLintptr offset, std::span<const std::byte> data)
+    {
+        CaptureRecord(CaptureOp::BufferWrite, buffer, std::int64_t{ offset }, CaptureData{ data.data(), data.size() });
+    }
+
+    void EnableVertexAttribArray(GLuint location)
+    {
+        glEnableVertexAttribArray(location);
+        CaptureRecord(CaptureOp::EnableVertexAttribArray, location);
+    }
+
+    void VertexAttribPointer(GLuint location, GLint components, GLenum type, bool normalized, GLsizei stride, std::uintptr_t offset)
+    {
+        glVertexAttribPointer(location, components, type, normalized ? GL_TRUE : GL_FALSE, stride, reinterpret_cast<const void*>(offset));
+        CaptureRecord(CaptureOp::VertexAttribPointer, location, components, type, std::uint8_t{ normalized }, stride, std::uint64_t{ offset });
+    }
+
+    void VertexAttribDivisor(GLuint location, GLuint divisor)
+    {
+        glVertexAttribDivisor(location, divisor);
+        CaptureRecord(CaptureOp::VertexAttribDivisor, location, divisor);
+    }
+
+    void TexParameteri(GLenum name, GLint value)
+    {
+        glTexParameteri(GL_TEXTURE_2D, name, value);
+        CaptureRecord(CaptureOp::TexParameteri, name, value);
+    }
+
+    void TexImage2D(GLint internal_format, GLsizei width, GLsizei height, GLenum format, GLenum type, const void* pixels)
+    {
+        glTexImage2D(GL_TEXTURE_2D, 0, internal_format, width, height, 0, format, type, pixels);
+        if (IsCapturing())
+        {
+            CaptureRecord(CaptureOp::TexImage2D, internal_format, width, height, format, type, pixel_data(width, height, format, type, pixels));
+        }
+    }
+
+    void TexSubImage2D(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, const void* pixels)
+    {
+        glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, format, type, pixels);
+        if (IsCapturing())
+        {
+            const auto data = pixel_data(width, height, format, type, pixels);
+            // without data pixels is an offset into the unpack buffer
+            const auto offset = (data.Size == 0) ? std::uint64_t{ reinterpret_cast<std::uintptr_t>(pixels) } : std::uint64_t{ 0 };
+            CaptureRecord(CaptureOp::TexSubImage2D, x, y, width, height, format, type, offset, data);
+        }
+    }
+
+    void Clear(GLbitfield mask)
+    {
+        glClear(mask);
+        CaptureRecord(CaptureOp::Clear, mask);
+    }
+
+    void DrawElements(GLenum mode, GLsizei count, GLenum type, std::uintptr_t offset)
+    {
+        glDrawElements(mode, count, type, reinterpret_cast<const void*>(offset));
+        CaptureRecord(CaptureOp::DrawElements, mode, count, type, std::uint64_t{ offset });
+    }
+
+    void DrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, std::uintptr_t offset, GLsizei instances)
+    {
+        glDrawElementsInstanced(mode, count, type, reinterpret_cast<const void*>(offset), instances);
+        CaptureRecord(CaptureOp::DrawElementsInstanced, mode, count, type, std::uint64_t{ offset }, instances);
+    }
+
+    void DrawArrays(GLenum mode, GLint first, GLsizei count)
+    {
+        glDrawArrays(mode, first, count);
+        CaptureRecord(CaptureOp::DrawArrays, mode, first, count);
+    }
+
+    void DrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instances)
+    {
+        glDrawArraysInstanced(mode, first, count, instances);
+        CaptureRecord(CaptureOp::DrawArraysInstanced, mode, first, count, instances);
+    }
+
+    void MultiDrawElements(GLenum mode, std::span<const GLsizei> counts, GLenum type, std::span<const void* const> offsets)
+    {
+#if !defined(__EMSCRIPTEN__)
+        glMultiDrawElements(mode, counts.data(), type, offsets.data(), static_cast<GLsizei>(counts.size()));
+#else
+        for (std::size_t i = 0; i < counts.size(); ++i)
+        {
+            glDrawElements(mode, counts[i], type, offsets[i]);
+        }
+#endif
+        if (!IsCapturing())
+        {
+            return;
+        }
+        CaptureRecord(CaptureOp::MultiDrawElements, mode, type, static_cast<std::uint32_t>(counts.size()));
+        for (std::size_t i = 0; i < counts.size(); ++i)
+        {
+            WriteCaptureField(counts[i]);
+            WriteCaptureField(std::uint64_t{ reinterpret_cast<std::uintptr_t>(offsets[i]) });
+        }
+    }
+}
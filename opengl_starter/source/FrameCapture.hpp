@@ -0,0 +1,157 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include "Handle.hpp"
+#include <GL/glew.h>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+
+namespace OpenGL
+{
+    // Frame capture : what the renderer sends to gl and the input it reacted to, written to a file that
+    // cs200_replay plays back without the app (ReplayMain.cpp, CaptureReplay.hpp).
+    //
+    // Only what goes through here, the state cache (GLState.hpp), SetUniform (Uniform.hpp), CreateShader and
+    // GLState's deletes is seen. That's the whole renderer, but not Dear ImGui, ShaderLibrary or the benchmarks
+    // that talk to gl directly. Objects made before StartCapture() are unknown to the file, so start it before setup().
+    //
+    // The file is CaptureMagic, CaptureVersion, then records : a CaptureOp byte followed by its fields as they
+    // are in memory (little endian on everything we build for). Data is a 64 bit size and the bytes, strings a
+    // 32 bit size and the characters. Gl names are the ones of the captured run, the replay maps them to its own.
+    // Everything before the first CaptureOp::Frame is setup, each Frame record starts a frame.
+    constexpr std::string_view CaptureMagic   = "CS200CAP";
+    constexpr std::uint32_t    CaptureVersion = 1;
+
+    enum class CaptureOp : std::uint8_t
+    {
+        Frame,                   // width, height
+        Input,                   // InputEvent
+        Program,                 // program, vertex source, fragment source, uniform count, then location + name of each
+        UniformBlockBinding,     // program, block name, binding
+        DeleteProgram,           // program
+        DeleteBuffer,            // buffer
+        DeleteVertexArray,       // vertex array
+        DeleteTexture,           // texture
+        UseProgram,              // program
+        BindVertexArray,         // vertex array
+        BindBuffer,              // target, buffer
+        BindBufferBase,          // target, index, buffer
+        BindBufferRange,         // target, index, buffer, offset, size
+        BindTexture2D,           // texture
+        Viewport,                // x, y, width, height
+        ClearColor,              // r, g, b, a
+        Clear,                   // mask
+        BufferData,              // target, size, usage, data (empty : storage only)
+        BufferSubData,           // target, offset, data
+        BufferWrite,             // buffer, offset, data : went through a mapping, the buffer doesn't have to be bound
+        EnableVertexAttribArray, // location
+        VertexAttribPointer,     // location, components, type, normalized, stride, offset
+        VertexAttribDivisor,     // location, divisor
+        TexParameteri,           // name, value
+        TexImage2D,              // internal format, width, height, format, type, data (empty : storage only)
+        TexSubImage2D,           // x, y, width, height, format, type, unpack buffer offset, data (empty : from the unpack buffer)
+        Uniform,                 // location, float count as a byte (1 to 4, 9 for a mat3), the floats
+        UniformInt,              // location, value
+        DrawElements,            // mode, count, type, offset
+        DrawElementsInstanced,   // mode, count, type, offset, instances
+        DrawArrays,              // mode, first, count
+        DrawArraysInstanced,     // mode, first, count, instances
+        MultiDrawElements,       // mode, type, draw count, counts, offsets
+        Count
+    };
+
+    // what main_loop() reacted to, kept with the frame it happened before
+    struct InputEvent
+    {
+        std::uint32_t Type = 0; // SDL_Event::type
+        std::int32_t  Code = 0; // key sym, window event...
+        std::int32_t  X    = 0; // window size, mouse position...
+        std::int32_t  Y    = 0;
+    };
+
+    // throws std::runtime_error if path can't be written. Stops by itself after max_frames frames
+    void StartCapture(const std::filesystem::path& path, int max_frames = 600);
+    // writes what is left and closes the file, prints what was captured
+    void StopCapture();
+    [[nodiscard]] bool IsCapturing() noexcept;
+
+    // draw_frame() calls it first thing, width and height are what the frame was drawn at
+    void CaptureFrame(int width, int height);
+    void CaptureInput(const InputEvent& event);
+    // CreateShader calls it once the program is linked
+    void CaptureProgram(Handle program, std::string_view vertex_source, std::string_view fragment_source, const std::unordered_map<std::string, GLint>& uniform_locations);
+
+    // a data field : 64 bit size then the bytes
+    struct CaptureData
+    {
+        const void*   Data = nullptr;
+        std::uint64_t Size = 0;
+    };
+
+    void WriteCaptureBytes(const void* data, std::size_t bytes);
+
+    inline void WriteCaptureField(const CaptureData& data)
+    {
+        WriteCaptureBytes(&data.Size, sizeof(data.Size));
+        WriteCaptureBytes(data.Data, static_cast<std::size_t>(data.Size));
+    }
+
+    inline void WriteCaptureField(std::string_view text)
+    {
+        const auto size = static_cast<std::uint32_t>(text.size());
+        WriteCaptureBytes(&size, sizeof(size));
+        WriteCaptureBytes(text.data(), text.size());
+    }
+
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    void WriteCaptureField(const T& value)
+    {
+        WriteCaptureBytes(&value, sizeof(value));
+    }
+
+    // one record, does nothing when not capturing. Give the fields the exact type CaptureOp says they have,
+    // the replay reads them back with those sizes
+    template <typename... Fields>
+    void CaptureRecord(CaptureOp op, const Fields&... fields)
+    {
+        if (!IsCapturing())
+        {
+            return;
+        }
+        WriteCaptureField(op);
+        (WriteCaptureField(fields), ...);
+    }
+
+    // The gl calls the renderer makes outside of the state cache. Each one is the gl call, plus its record while capturing.
+    // Textures are GL_TEXTURE_2D level 0, offsets are what gl takes as a pointer when a buffer is bound
+    void BufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage);
+    void BufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data);
+    // data was written through a mapping of buffer, call it before unmapping
+    void CaptureBufferWrite(Handle buffer, GLintptr offset, std::span<const std::byte> data);
+    void EnableVertexAttribArray(GLuint location);
+    void VertexAttribPointer(GLuint location, GLint components, GLenum type, bool normalized, GLsizei stride, std::uintptr_t offset);
+    void VertexAttribDivisor(GLuint location, GLuint divisor);
+    void TexParameteri(GLenum name, GLint value);
+    void TexImage2D(GLint internal_format, GLsizei width, GLsizei height, GLenum format, GLenum type, const void* pixels);
+    void TexSubImage2D(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, const void* pixels);
+    void Clear(GLbitfield mask);
+    void DrawElements(GLenum mode, GLsizei count, GLenum type, std::uintptr_t offset);
+    void DrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, std::uintptr_t offset, GLsizei instances);
+    void DrawArrays(GLenum mode, GLint first, GLsizei count);
+    void DrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instances);
+    // one draw per range on GLES3 / WebGL2, they don't have it
+    void MultiDrawElements(GLenum mode, std::span<const GLsizei> counts, GLenum type, std::span<const void* const> offsets);
+}
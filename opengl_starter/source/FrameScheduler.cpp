@@ -0,0 +1,120 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "FrameScheduler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // a breakpoint or a dragged window shouldn't turn into minutes of catching up
+    constexpr double max_frame_seconds = 0.25;
+
+    // sleep is only good to a millisecond or so, the rest of the wait is spent spinning
+    constexpr auto spin_margin = std::chrono::microseconds{ 1500 };
+
+    using milliseconds = std::chrono::duration<double, std::milli>;
+}
+
+namespace Timing
+{
+    FrameScheduler::FrameScheduler() : FrameScheduler(Settings{})
+    {
+    }
+
+    FrameScheduler::FrameScheduler(Settings frame_settings) : settings(frame_settings), lastTick(clock::now()), nextFrame(lastTick)
+    {
+    }
+
+    bool FrameScheduler::Tick(const std::function<void(double)>& update, const std::function<void(double)>& render)
+    {
+        const auto wait_start = clock::now();
+        if (!wait_for_frame_cap())
+        {
+            return false;
+        }
+        const auto now     = clock::now();
+        statistics.WaitMs  = milliseconds(now - wait_start).count();
+        statistics.FrameMs = milliseconds(now - lastTick).count();
+        accumulator += std::min(std::chrono::duration<double>(now - lastTick).count(), max_frame_seconds);
+        lastTick = now;
+
+        const double step  = 1.0 / std::max(settings.UpdateHz, 1.0);
+        statistics.Updates = 0;
+        while (accumulator >= step && statistics.Updates < settings.MaxCatchUpSteps)
+        {
+            update(step);
+            accumulator -= step;
+            ++statistics.Updates;
+        }
+        if (accumulator >= step)
+        {
+            // too far behind, run slow instead of spiraling
+            const double dropped = std::floor(accumulator / step);
+            statistics.DroppedSteps += static_cast<std::uint64_t>(dropped);
+            accumulator -= dropped * step;
+        }
+        const auto render_start = clock::now();
+        statistics.UpdateMs     = milliseconds(render_start - now).count();
+
+        render(accumulator / step);
+        statistics.RenderMs = milliseconds(clock::now() - render_start).count();
+
+        history[historyNext] = static_cast<float>(statistics.FrameMs);
+        historyNext          = (historyNext + 1) % HistorySize;
+        historyCount         = std::min(historyCount + 1, HistorySize);
+        return true;
+    }
+
+    double FrameScheduler::FrameTimePercentile(double percent) const
+    {
+        if (historyCount == 0)
+        {
+            return 0.0;
+        }
+        // only the filled part, before the ring wraps that's the front
+        std::vector<float> sorted(history.begin(), history.begin() + static_cast<std::ptrdiff_t>(historyCount));
+        std::sort(sorted.begin(), sorted.end());
+        const auto rank = static_cast<std::size_t>(std::ceil(percent / 100.0 * static_cast<double>(sorted.size())));
+        return static_cast<double>(sorted[std::clamp(rank, std::size_t{ 1 }, sorted.size()) - 1]);
+    }
+
+    bool FrameScheduler::wait_for_frame_cap()
+    {
+        if (settings.FrameCapHz <= 0.0)
+        {
+            return true;
+        }
+        const auto period = std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(1.0 / settings.FrameCapHz));
+        auto       now    = clock::now();
+#if defined(__EMSCRIPTEN__)
+        // can't block the browser, skip this callback and try again on the next one
+        if (now < nextFrame)
+        {
+            return false;
+        }
+#else
+        if (now < nextFrame)
+        {
+            if (nextFrame - now > spin_margin)
+            {
+                std::this_thread::sleep_for(nextFrame - now - spin_margin);
+            }
+            while (clock::now() < nextFrame)
+            {
+            }
+            now = clock::now();
+        }
+#endif
+        // a late frame starts a new schedule instead of rushing the following ones
+        nextFrame = (now - nextFrame > period) ? now + period : nextFrame + period;
+        return true;
+    }
+}
@@ -0,0 +1,94 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace Timing
+{
+    // Runs the simulation at a fixed rate and renders once per Tick(), decoupled from each other.
+    //  - the real time since the last tick goes into an accumulator
+    //  - update(step) runs while a whole step fits in it, at most MaxCatchUpSteps times, whatever is left over past that is dropped
+    //  - render(alpha) runs once, alpha = leftover / step so the drawing can blend the last two simulated states
+    //
+    // Tick() is one main_loop() call, so it works from the native while loop and from emscripten_set_main_loop alike.
+    class FrameScheduler
+    {
+    public:
+        using clock = std::chrono::steady_clock;
+
+        // frames kept for the histogram
+        static constexpr std::size_t HistorySize = 240;
+
+        struct Settings
+        {
+            double UpdateHz        = 60.0;
+            int    MaxCatchUpSteps = 5;
+            double FrameCapHz      = 0.0; // 0 : no cap. Meant for vsync off, with vsync on the swap already paces us
+        };
+
+        struct Statistics
+        {
+            int           Updates      = 0;   // steps run last frame
+            std::uint64_t DroppedSteps = 0;   // since the start, steps thrown away because we fell too far behind
+            double        UpdateMs     = 0.0; // cpu time in update() last frame
+            double        RenderMs     = 0.0; // cpu time in render() last frame
+            double        WaitMs       = 0.0; // time spent holding the frame cap last frame
+            double        FrameMs      = 0.0; // tick to tick
+        };
+
+        FrameScheduler();
+        explicit FrameScheduler(Settings frame_settings);
+
+        // false when the frame cap says it's too early, only under emscripten : the browser calls us back anyway, native sleeps instead
+        bool Tick(const std::function<void(double step_seconds)>& update, const std::function<void(double alpha)>& render);
+
+        [[nodiscard]] Settings& GetSettings() noexcept
+        {
+            return settings;
+        }
+
+        [[nodiscard]] const Statistics& GetStatistics() const noexcept
+        {
+            return statistics;
+        }
+
+        // FrameMs of the last HistorySize frames as a ring, the oldest one at GetHistoryOffset().
+        // That's the layout ImGui::PlotHistogram / PlotLines take.
+        [[nodiscard]] const std::array<float, HistorySize>& GetFrameTimeHistory() const noexcept
+        {
+            return history;
+        }
+
+        [[nodiscard]] std::size_t GetHistoryOffset() const noexcept
+        {
+            return historyNext;
+        }
+
+        // over the frames in the history, 0 when there are none yet
+        [[nodiscard]] double FrameTimePercentile(double percent) const;
+
+    private:
+        // true when it's time for the next frame
+        bool wait_for_frame_cap();
+
+    private:
+        Settings                       settings{};
+        Statistics                     statistics{};
+        clock::time_point              lastTick{};
+        clock::time_point              nextFrame{};
+        double                         accumulator = 0.0; // seconds of simulation owed
+        std::array<float, HistorySize> history{};
+        std::size_t                    historyNext  = 0;
+        std::size_t                    historyCount = 0;
+    };
+}
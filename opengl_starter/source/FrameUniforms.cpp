@@ -0,0 +1,154 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "FrameUniforms.hpp"
+
+#include "FrameCapture.hpp"
+#include "GLState.hpp"
+#include <cstring>
+#include <gsl/gsl>
+
+namespace
+{
+    // std140 : a mat3 is stored as 3 vec4 columns, then the floats pack tightly, vec2 aligns to 8
+    struct Std140FrameData
+    {
+        float ToNDC[3][4];
+        float Time;
+        float DeltaTime;
+        float ViewportSize[2];
+    };
+
+    static_assert(sizeof(Std140FrameData) == 64);
+
+    [[nodiscard]] Std140FrameData to_std140(const OpenGL::FrameUniforms& uniforms) noexcept
+    {
+        Std140FrameData data{};
+        for (std::size_t column = 0; column < 3; ++column)
+        {
+            for (std::size_t row = 0; row < 3; ++row)
+            {
+                data.ToNDC[column][row] = uniforms.ToNDC[column * 3 + row];
+            }
+        }
+        data.Time            = uniforms.Time;
+        data.DeltaTime       = uniforms.DeltaTime;
+        data.ViewportSize[0] = uniforms.ViewportWidth;
+        data.ViewportSize[1] = uniforms.ViewportHeight;
+        return data;
+    }
+
+    // one second, after that something is badly wrong and we'd rather overwrite than hang
+    constexpr GLuint64 fence_timeout_ns = 1'000'000'000;
+}
+
+namespace OpenGL
+{
+    FrameUniformBuffer::FrameUniformBuffer([[maybe_unused]] bool allow_persistent_mapping)
+    {
+        GLint alignment = 0;
+        glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+        const auto align = static_cast<std::size_t>(std::max(alignment, 1));
+        stride           = (sizeof(Std140FrameData) + align - 1) / align * align;
+        const auto bytes = gsl::narrow<GLsizeiptr>(stride * FramesInFlight);
+
+        glGenBuffers(1, &uniformBuffer);
+        BindBuffer(GL_UNIFORM_BUFFER, uniformBuffer);
+#if !defined(__EMSCRIPTEN__)
+        if (allow_persistent_mapping && GLEW_ARB_buffer_storage)
+        {
+            // coherent : our writes show up for the gpu without explicit flushes, the fences handle the rest
+            constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+            glBufferStorage(GL_UNIFORM_BUFFER, bytes, nullptr, flags);
+            CaptureRecord(CaptureOp::BufferData, GLenum{ GL_UNIFORM_BUFFER }, std::int64_t{ bytes }, GLenum{ GL_DYNAMIC_DRAW }, CaptureData{}); // same storage for a replay
+            mappedMemory = static_cast<std::byte*>(glMapBufferRange(GL_UNIFORM_BUFFER, 0, bytes, flags));
+            if (mappedMemory != nullptr)
+            {
+                return;
+            }
+            // storage is immutable now, start over with a fresh buffer
+            DeleteBuffer(uniformBuffer);
+            glGenBuffers(1, &uniformBuffer);
+            BindBuffer(GL_UNIFORM_BUFFER, uniformBuffer);
+        }
+#endif
+        BufferData(GL_UNIFORM_BUFFER, bytes, nullptr, GL_DYNAMIC_DRAW);
+    }
+
+    FrameUniformBuffer::~FrameUniformBuffer()
+    {
+        for (auto& fence : fences)
+        {
+            if (fence != nullptr)
+            {
+                glDeleteSync(fence);
+            }
+        }
+        if (mappedMemory != nullptr)
+        {
+            BindBuffer(GL_UNIFORM_BUFFER, uniformBuffer);
+            glUnmapBuffer(GL_UNIFORM_BUFFER);
+        }
+        DeleteBuffer(uniformBuffer);
+    }
+
+    void FrameUniformBuffer::Attach(const CompiledShader& shader) const
+    {
+        BindUniformBufferToShader(shader.Shader, FrameUniformsBinding, uniformBuffer, FrameUniformsBlockName);
+    }
+
+    void FrameUniformBuffer::Update(const FrameUniforms& uniforms)
+    {
+        current      = (current + 1) % FramesInFlight;
+        auto& fence  = fences[current];
+        if (fence != nullptr)
+        {
+#if !defined(__EMSCRIPTEN__)
+            // usually long done, the first check doesn't wait at all
+            GLenum status = glClientWaitSync(fence, 0, 0);
+            if (status == GL_TIMEOUT_EXPIRED)
+            {
+                ++statistics.FenceWaits;
+                status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, fence_timeout_ns);
+            }
+            if (status == GL_TIMEOUT_EXPIRED || status == GL_WAIT_FAILED)
+            {
+                ++statistics.FenceTimeouts;
+                // the gpu may still be reading this slot. glBufferSubData takes care of that itself, a mapped write doesn't
+                if (mappedMemory != nullptr)
+                {
+                    glFinish();
+                }
+            }
+#endif
+            // WebGL2 can't block on a fence (its timeout has to be 0), and glBufferSubData is always safe there anyway
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+
+        const auto data   = to_std140(uniforms);
+        const auto offset = current * stride;
+        if (mappedMemory != nullptr)
+        {
+            std::memcpy(mappedMemory + offset, &data, sizeof(data));
+            CaptureBufferWrite(uniformBuffer, gsl::narrow<GLintptr>(offset), std::as_bytes(std::span{ &data, 1 }));
+        }
+        else
+        {
+            BindBuffer(GL_UNIFORM_BUFFER, uniformBuffer);
+            BufferSubData(GL_UNIFORM_BUFFER, gsl::narrow<GLintptr>(offset), sizeof(data), &data);
+        }
+        statistics.BytesUploaded += sizeof(data);
+
+        BindBufferRange(GL_UNIFORM_BUFFER, FrameUniformsBinding, uniformBuffer, gsl::narrow<GLintptr>(offset), sizeof(data));
+    }
+
+    void FrameUniformBuffer::EndFrame()
+    {
+        fences[current] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+}
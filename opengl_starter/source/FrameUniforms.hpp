@@ -0,0 +1,92 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include "Handle.hpp"
+#include "Math.hpp"
+#include "Shader.hpp"
+#include <GL/glew.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace OpenGL
+{
+    // Per frame data every program shares through one std140 uniform block instead of
+    // each program getting its own glUniformMatrix3fv(uToNDC) every frame.
+    // The block has no instance name, so shaders keep using uToNDC / uTime as if they were plain uniforms.
+    constexpr GLuint FrameUniformsBinding   = 0;
+    constexpr auto   FrameUniformsBlockName = "FrameData";
+    constexpr auto   FrameUniformsGLSL      = R"(layout(std140) uniform FrameData
+{
+    mat3  uToNDC;
+    float uTime;
+    float uDeltaTime;
+    vec2  uViewportSize;
+};
+)";
+
+    struct FrameUniforms
+    {
+        Math::mat3 ToNDC          = Math::IdentityMatrix();
+        float      Time           = 0.0f; // seconds since start
+        float      DeltaTime      = 0.0f;
+        float      ViewportWidth  = 0.0f;
+        float      ViewportHeight = 0.0f;
+    };
+
+    // Ring of FramesInFlight copies of the block in one buffer. Each frame writes the next copy and binds
+    // just that range, and a fence placed at the end of the frame tells us when the gpu is done reading it,
+    // so the cpu never writes over a copy that is still in use.
+    // Writes go through a persistent coherent mapping when the driver has ARB_buffer_storage, glBufferSubData otherwise (WebGL2).
+    class FrameUniformBuffer
+    {
+    public:
+        static constexpr std::size_t FramesInFlight = 3;
+
+        struct Statistics
+        {
+            std::uint64_t BytesUploaded = 0; // this frame
+            int           FenceWaits    = 0; // times the cpu had to wait for the gpu this frame
+            int           FenceTimeouts = 0; // of those, the ones that timed out or failed
+        };
+
+        explicit FrameUniformBuffer(bool allow_persistent_mapping = true);
+        ~FrameUniformBuffer();
+
+        FrameUniformBuffer(const FrameUniformBuffer&)            = delete;
+        FrameUniformBuffer& operator=(const FrameUniformBuffer&) = delete;
+
+        // points the program's FrameData block at FrameUniformsBinding (through BindUniformBufferToShader)
+        void Attach(const CompiledShader& shader) const;
+
+        // start of the frame : write into the next free copy and bind it
+        void Update(const FrameUniforms& uniforms);
+        // end of the frame, after the last draw that reads the block
+        void EndFrame();
+
+        [[nodiscard]] bool IsPersistentlyMapped() const noexcept
+        {
+            return mappedMemory != nullptr;
+        }
+
+        // reset with GetStatistics() = {}
+        [[nodiscard]] Statistics& GetStatistics() noexcept
+        {
+            return statistics;
+        }
+
+    private:
+        Handle                             uniformBuffer = 0;
+        std::size_t                        stride        = 0; // block size rounded up to GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT
+        std::size_t                        current       = 0;
+        std::array<GLsync, FramesInFlight> fences{};
+        std::byte*                         mappedMemory = nullptr;
+        Statistics                         statistics{};
+    };
+}
@@ -0,0 +1,314 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "GLState.hpp"
+
+#include "FrameCapture.hpp"
+#include <array>
+#include <limits>
+#include <unordered_map>
+
+namespace
+{
+    // no valid name looks like this, so it never matches and the next bind always goes through
+    constexpr OpenGL::Handle unknown = std::numeric_limits<OpenGL::Handle>::max();
+
+    // GL ES 3.0 guarantees 24 uniform buffer bindings, anything above is passed through untracked
+    constexpr GLuint tracked_uniform_bindings = 24;
+
+    // what an indexed uniform buffer binding point holds, size -1 for the whole buffer (glBindBufferBase)
+    struct IndexedBinding
+    {
+        OpenGL::Handle Buffer = unknown;
+        GLintptr       Offset = 0;
+        GLsizeiptr     Size   = -1;
+
+        bool operator==(const IndexedBinding&) const = default;
+    };
+
+    struct ShadowState
+    {
+        OpenGL::Handle                                       Program       = unknown;
+        OpenGL::Handle                                       VertexArray   = unknown;
+        OpenGL::Handle                                       ArrayBuffer   = unknown;
+        OpenGL::Handle                                       UniformBuffer = unknown; // generic GL_UNIFORM_BUFFER binding
+        OpenGL::Handle                                       PixelUnpack   = unknown; // glTexSubImage2D reads from it when it isn't 0
+        OpenGL::Handle                                       Texture2D     = unknown;
+        std::array<IndexedBinding, tracked_uniform_bindings> UniformBindings{};
+        std::unordered_map<OpenGL::Handle, OpenGL::Handle>   ElementBuffers{}; // VAO -> its element buffer
+        std::array<GLint, 4>                                 Viewport{ -1, -1, -1, -1 };
+        std::array<float, 4>                                 ClearColor{};
+        bool                                                 ClearColorKnown = false;
+        OpenGL::StateStatistics                              Statistics{};
+    };
+
+    ShadowState gState;
+
+    // returns true when the caller has to make the gl call
+    [[nodiscard]] bool update(OpenGL::Handle& shadow, OpenGL::Handle value) noexcept
+    {
+        if (shadow == value)
+        {
+            ++gState.Statistics.Elided;
+            return false;
+        }
+        shadow = value;
+        ++gState.Statistics.Issued;
+        return true;
+    }
+}
+
+namespace OpenGL
+{
+    void UseProgram(Handle program)
+    {
+        if (update(gState.Program, program))
+        {
+            glUseProgram(program);
+            CaptureRecord(CaptureOp::UseProgram, program);
+        }
+    }
+
+    void BindVertexArray(Handle vertex_array)
+    {
+        if (update(gState.VertexArray, vertex_array))
+        {
+            glBindVertexArray(vertex_array);
+            CaptureRecord(CaptureOp::BindVertexArray, vertex_array);
+        }
+    }
+
+    void BindBuffer(GLenum target, Handle buffer)
+    {
+        switch (target)
+        {
+            case GL_ARRAY_BUFFER:
+                if (update(gState.ArrayBuffer, buffer))
+                {
+                    glBindBuffer(target, buffer);
+                    CaptureRecord(CaptureOp::BindBuffer, target, buffer);
+                }
+                return;
+            case GL_ELEMENT_ARRAY_BUFFER:
+                {
+                    // first time we see this VAO we don't know what it has, so emplace as unknown
+                    auto& element_buffer = gState.ElementBuffers.try_emplace(gState.VertexArray, unknown).first->second;
+                    if (gState.VertexArray == unknown)
+                    {
+                        element_buffer = unknown;
+                    }
+                    if (update(element_buffer, buffer))
+                    {
+                        glBindBuffer(target, buffer);
+                        CaptureRecord(CaptureOp::BindBuffer, target, buffer);
+                    }
+                }
+                return;
+            case GL_UNIFORM_BUFFER:
+                if (update(gState.UniformBuffer, buffer))
+                {
+                    glBindBuffer(target, buffer);
+                    CaptureRecord(CaptureOp::BindBuffer, target, buffer);
+                }
+                return;
+            case GL_PIXEL_UNPACK_BUFFER:
+                if (update(gState.PixelUnpack, buffer))
+                {
+                    glBindBuffer(target, buffer);
+                    CaptureRecord(CaptureOp::BindBuffer, target, buffer);
+                }
+                return;
+            default:
+                ++gState.Statistics.Issued;
+                glBindBuffer(target, buffer);
+                CaptureRecord(CaptureOp::BindBuffer, target, buffer);
+                return;
+        }
+    }
+
+    void BindBufferBase(GLenum target, GLuint index, Handle buffer)
+    {
+        if (target != GL_UNIFORM_BUFFER || index >= tracked_uniform_bindings)
+        {
+            ++gState.Statistics.Issued;
+            glBindBufferBase(target, index, buffer);
+            CaptureRecord(CaptureOp::BindBufferBase, target, index, buffer);
+            return;
+        }
+        const IndexedBinding binding{ buffer, 0, -1 };
+        if (gState.UniformBindings[index] == binding)
+        {
+            ++gState.Statistics.Elided;
+            return;
+        }
+        gState.UniformBindings[index] = binding;
+        ++gState.Statistics.Issued;
+        glBindBufferBase(target, index, buffer);
+        CaptureRecord(CaptureOp::BindBufferBase, target, index, buffer);
+        // glBindBufferBase binds the generic target too
+        gState.UniformBuffer = buffer;
+    }
+
+    void BindBufferRange(GLenum target, GLuint index, Handle buffer, GLintptr offset, GLsizeiptr size)
+    {
+        if (target != GL_UNIFORM_BUFFER || index >= tracked_uniform_bindings)
+        {
+            ++gState.Statistics.Issued;
+            glBindBufferRange(target, index, buffer, offset, size);
+            CaptureRecord(CaptureOp::BindBufferRange, target, index, buffer, std::int64_t{ offset }, std::int64_t{ size });
+            return;
+        }
+        const IndexedBinding binding{ buffer, offset, size };
+        if (gState.UniformBindings[index] == binding)
+        {
+            ++gState.Statistics.Elided;
+            return;
+        }
+        gState.UniformBindings[index] = binding;
+        ++gState.Statistics.Issued;
+        glBindBufferRange(target, index, buffer, offset, size);
+        CaptureRecord(CaptureOp::BindBufferRange, target, index, buffer, std::int64_t{ offset }, std::int64_t{ size });
+        // same as glBindBufferBase, the generic target follows
+        gState.UniformBuffer = buffer;
+    }
+
+    void BindTexture2D(Handle texture)
+    {
+        if (update(gState.Texture2D, texture))
+        {
+            glBindTexture(GL_TEXTURE_2D, texture);
+            CaptureRecord(CaptureOp::BindTexture2D, texture);
+        }
+    }
+
+    void Viewport(GLint x, GLint y, GLsizei width, GLsizei height)
+    {
+        const std::array<GLint, 4> viewport{ x, y, width, height };
+        if (viewport == gState.Viewport)
+        {
+            ++gState.Statistics.Elided;
+            return;
+        }
+        gState.Viewport = viewport;
+        ++gState.Statistics.Issued;
+        glViewport(x, y, width, height);
+        CaptureRecord(CaptureOp::Viewport, x, y, width, height);
+    }
+
+    void ClearColor(float r, float g, float b, float a)
+    {
+        const std::array<float, 4> color{ r, g, b, a };
+        if (gState.ClearColorKnown && color == gState.ClearColor)
+        {
+            ++gState.Statistics.Elided;
+            return;
+        }
+        gState.ClearColor      = color;
+        gState.ClearColorKnown = true;
+        ++gState.Statistics.Issued;
+        glClearColor(r, g, b, a);
+        CaptureRecord(CaptureOp::ClearColor, color);
+    }
+
+    void DeleteProgram(Handle program)
+    {
+        glDeleteProgram(program);
+        CaptureRecord(CaptureOp::DeleteProgram, program);
+        if (gState.Program == program)
+        {
+            gState.Program = unknown;
+        }
+    }
+
+    void DeleteBuffer(Handle buffer)
+    {
+        DeleteBuffers({ &buffer, 1 });
+    }
+
+    void DeleteBuffers(std::span<const Handle> buffers)
+    {
+        if (buffers.empty())
+        {
+            return;
+        }
+        glDeleteBuffers(static_cast<GLsizei>(buffers.size()), buffers.data());
+        // gl only unbinds them from the current VAO, but the names can come back for new buffers,
+        // so no VAO is allowed to claim them anymore
+        for (const Handle buffer : buffers)
+        {
+            CaptureRecord(CaptureOp::DeleteBuffer, buffer);
+            for (auto* binding : { &gState.ArrayBuffer, &gState.UniformBuffer, &gState.PixelUnpack })
+            {
+                if (*binding == buffer)
+                {
+                    *binding = unknown;
+                }
+            }
+            for (auto& binding : gState.UniformBindings)
+            {
+                if (binding.Buffer == buffer)
+                {
+                    binding = IndexedBinding{};
+                }
+            }
+            for (auto& [vertex_array, element_buffer] : gState.ElementBuffers)
+            {
+                if (element_buffer == buffer)
+                {
+                    element_buffer = unknown;
+                }
+            }
+        }
+    }
+
+    void DeleteVertexArray(Handle vertex_array)
+    {
+        DeleteVertexArrays({ &vertex_array, 1 });
+    }
+
+    void DeleteVertexArrays(std::span<const Handle> vertex_arrays)
+    {
+        if (vertex_arrays.empty())
+        {
+            return;
+        }
+        glDeleteVertexArrays(static_cast<GLsizei>(vertex_arrays.size()), vertex_arrays.data());
+        for (const Handle vertex_array : vertex_arrays)
+        {
+            CaptureRecord(CaptureOp::DeleteVertexArray, vertex_array);
+            gState.ElementBuffers.erase(vertex_array);
+            if (gState.VertexArray == vertex_array)
+            {
+                // gl falls back to VAO 0
+                gState.VertexArray = 0;
+            }
+        }
+    }
+
+    void DeleteTexture(Handle texture)
+    {
+        glDeleteTextures(1, &texture);
+        CaptureRecord(CaptureOp::DeleteTexture, texture);
+        if (gState.Texture2D == texture)
+        {
+            // gl falls back to texture 0
+            gState.Texture2D = 0;
+        }
+    }
+
+    void InvalidateState()
+    {
+        const auto statistics = gState.Statistics;
+        gState                = ShadowState{};
+        gState.Statistics     = statistics;
+    }
+
+    StateStatistics& GetStateStatistics() noexcept
+    {
+        return gState.Statistics;
+    }
+}
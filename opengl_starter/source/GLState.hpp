@@ -0,0 +1,56 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include "Handle.hpp"
+#include <GL/glew.h>
+#include <cstdint>
+#include <span>
+
+namespace OpenGL
+{
+    // Shadow copy of the bits of gl state we touch every frame.
+    // Each call only reaches the driver if it would actually change something, so callers can
+    // just say what they need ("use this program, this VAO") without unbinding afterwards.
+    //
+    // It only works if everyone goes through here. Code that calls gl directly (Dear ImGui for example)
+    // has to be followed by InvalidateState().
+    //
+    // The element array buffer belongs to the VAO, so it is remembered per VAO.
+    // Bind VAO 0 before binding an element buffer just to upload to it, or you'll change the VAO that's bound.
+    void UseProgram(Handle program);
+    void BindVertexArray(Handle vertex_array);
+    void BindBuffer(GLenum target, Handle buffer);
+    void BindBufferBase(GLenum target, GLuint index, Handle buffer);
+    void BindBufferRange(GLenum target, GLuint index, Handle buffer, GLintptr offset, GLsizeiptr size);
+    // GL_TEXTURE_2D of texture unit 0, the only one we use
+    void BindTexture2D(Handle texture);
+    void Viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+    void ClearColor(float r, float g, float b, float a);
+
+    // delete and forget, so a recycled name doesn't look like it's still bound
+    void DeleteProgram(Handle program);
+    void DeleteBuffer(Handle buffer);
+    void DeleteVertexArray(Handle vertex_array);
+    // one glDelete* call for all of them
+    void DeleteBuffers(std::span<const Handle> buffers);
+    void DeleteVertexArrays(std::span<const Handle> vertex_arrays);
+    void DeleteTexture(Handle texture);
+
+    // forget everything, the next call of each kind always reaches the driver
+    void InvalidateState();
+
+    struct StateStatistics
+    {
+        std::uint64_t Issued = 0; // calls that reached the driver
+        std::uint64_t Elided = 0; // calls dropped because nothing would change
+    };
+
+    // read it once a frame and reset with GetStateStatistics() = {}
+    [[nodiscard]] StateStatistics& GetStateStatistics() noexcept;
+}
@@ -0,0 +1,362 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "GpuResources.hpp"
+
+#include "FrameCapture.hpp"
+#include "GLState.hpp"
+#include <bit>
+#include <deque>
+#include <gsl/gsl>
+#include <iostream>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t   buffer_name_block       = 32; // names per glGenBuffers
+    constexpr std::size_t   vertex_array_name_block = 16; // names per glGenVertexArrays
+    constexpr std::size_t   smallest_buffer_class   = 256;
+    constexpr std::uint64_t recycle_after_frames    = 3;          // same as FrameUniformBuffer::FramesInFlight, the gpu is done with it by then
+    constexpr std::uint64_t pooled_frames           = 600;        // a pooled buffer nobody wanted for this long gets deleted
+    constexpr std::size_t   max_pooled_bytes        = 64u << 20u; // released buffers past this get deleted instead of kept
+
+    struct Slot
+    {
+        OpenGL::Handle       Name       = 0;
+        std::uint32_t        Generation = 1;
+        OpenGL::ResourceKind Kind       = OpenGL::ResourceKind::Buffer;
+        bool                 Live       = false;
+        bool                 Element    = false; // buffers : made for GL_ELEMENT_ARRAY_BUFFER
+        GLenum               Usage      = GL_STATIC_DRAW;
+        std::size_t          Bytes      = 0;
+        std::size_t          Capacity   = 0;
+    };
+
+    // a released buffer waiting for a new owner of the same class
+    struct PooledBuffer
+    {
+        OpenGL::Handle Name          = 0;
+        std::size_t    Capacity      = 0;
+        std::uint64_t  ReleasedFrame = 0;
+    };
+
+    struct Pool
+    {
+        std::vector<Slot>                                           Slots{};
+        std::vector<std::uint32_t>                                  FreeSlots{};
+        std::vector<OpenGL::Handle>                                 BufferNames{};      // generated, not handed out yet
+        std::vector<OpenGL::Handle>                                 VertexArrayNames{}; // same
+        std::vector<OpenGL::Handle>                                 DeadBuffers{};      // deleted by the next CollectResources()
+        std::vector<OpenGL::Handle>                                 DeadVertexArrays{};
+        std::vector<OpenGL::Handle>                                 DeadPrograms{};
+        std::unordered_map<std::uint64_t, std::deque<PooledBuffer>> Pooled{}; // buffer_key() -> oldest first
+        std::uint64_t                                               Frame = 0;
+        OpenGL::ResourceCounts                                      Counts{};
+        OpenGL::ResourceStatistics                                  Statistics{};
+    };
+
+    // never destroyed : handles living in globals die after every other global, and still need somewhere to go
+    Pool& pool()
+    {
+        static Pool* const instance = new Pool{};
+        return *instance;
+    }
+
+    // 256, then 4 steps per power of two : 320, 384, 448, 512, 640... never more than 25% wasted
+    [[nodiscard]] std::size_t size_class(std::size_t bytes) noexcept
+    {
+        if (bytes <= smallest_buffer_class)
+        {
+            return smallest_buffer_class;
+        }
+        const std::size_t step = std::bit_floor(bytes) / 4;
+        return (bytes + step - 1) / step * step;
+    }
+
+    // usages are all 0x88Ex, the low 16 bits are enough to tell them apart
+    [[nodiscard]] std::uint64_t buffer_key(std::size_t capacity, bool element, GLenum usage) noexcept
+    {
+        return (std::uint64_t{ capacity } << 17u) | (std::uint64_t{ element } << 16u) | (usage & 0xFFFFu);
+    }
+
+    // names are generated a block at a time, generate is glGenBuffers or glGenVertexArrays
+    template <typename Generate>
+    [[nodiscard]] OpenGL::Handle take_name(std::vector<OpenGL::Handle>& names, std::size_t block, Generate generate)
+    {
+        if (names.empty())
+        {
+            names.resize(block);
+            generate(gsl::narrow<GLsizei>(block), names.data());
+            ++pool().Statistics.GenCalls;
+        }
+        const OpenGL::Handle name = names.back();
+        names.pop_back();
+        return name;
+    }
+
+    // a live slot for name, returns {slot, generation}
+    [[nodiscard]] std::pair<std::uint32_t, std::uint32_t> open_slot(OpenGL::ResourceKind kind, OpenGL::Handle name)
+    {
+        auto&         p = pool();
+        std::uint32_t index;
+        if (p.FreeSlots.empty())
+        {
+            index = gsl::narrow<std::uint32_t>(p.Slots.size());
+            p.Slots.emplace_back();
+        }
+        else
+        {
+            index = p.FreeSlots.back();
+            p.FreeSlots.pop_back();
+        }
+        Slot& slot = p.Slots[index];
+        slot.Name  = name;
+        slot.Kind  = kind;
+        slot.Live  = true;
+        ++p.Statistics.Created;
+        switch (kind)
+        {
+            case OpenGL::ResourceKind::Buffer: ++p.Counts.Buffers; break;
+            case OpenGL::ResourceKind::VertexArray: ++p.Counts.VertexArrays; break;
+            case OpenGL::ResourceKind::Program: ++p.Counts.Programs; break;
+        }
+        return { index, slot.Generation };
+    }
+
+    // the slot is free again and every handle still pointing at it is stale
+    void close_slot(std::uint32_t index) noexcept
+    {
+        auto& p    = pool();
+        Slot& slot = p.Slots[index];
+        switch (slot.Kind)
+        {
+            case OpenGL::ResourceKind::Buffer:
+                --p.Counts.Buffers;
+                p.Counts.BufferBytes -= slot.Bytes;
+                p.Counts.BufferCapacity -= slot.Capacity;
+                break;
+            case OpenGL::ResourceKind::VertexArray: --p.Counts.VertexArrays; break;
+            case OpenGL::ResourceKind::Program: --p.Counts.Programs; break;
+        }
+        slot.Live = false;
+        slot.Name = 0;
+        if (++slot.Generation == 0)
+        {
+            slot.Generation = 1; // 0 means an empty handle
+        }
+        p.FreeSlots.push_back(index);
+    }
+
+    void delete_dead()
+    {
+        auto& p = pool();
+        if (!p.DeadBuffers.empty())
+        {
+            OpenGL::DeleteBuffers(p.DeadBuffers);
+            ++p.Statistics.DeleteCalls;
+            p.DeadBuffers.clear();
+        }
+        if (!p.DeadVertexArrays.empty())
+        {
+            OpenGL::DeleteVertexArrays(p.DeadVertexArrays);
+            ++p.Statistics.DeleteCalls;
+            p.DeadVertexArrays.clear();
+        }
+        // no batched version of this one
+        for (const OpenGL::Handle program : p.DeadPrograms)
+        {
+            OpenGL::DeleteProgram(program);
+            ++p.Statistics.DeleteCalls;
+        }
+        p.DeadPrograms.clear();
+    }
+}
+
+namespace OpenGL
+{
+    Handle GetResourceName(std::uint32_t slot, std::uint32_t generation, ResourceKind kind)
+    {
+        auto& p = pool();
+        if (slot >= p.Slots.size() || p.Slots[slot].Generation != generation || !p.Slots[slot].Live || p.Slots[slot].Kind != kind)
+        {
+            ++p.Statistics.StaleAccesses;
+            throw std::logic_error("gpu resource used after it was released");
+        }
+        return p.Slots[slot].Name;
+    }
+
+    std::size_t GetBufferCapacity(std::uint32_t slot, std::uint32_t generation)
+    {
+        [[maybe_unused]] const Handle name = GetResourceName(slot, generation, ResourceKind::Buffer); // throws if it is stale
+        return pool().Slots[slot].Capacity;
+    }
+
+    void ReleaseResource(std::uint32_t slot, std::uint32_t generation) noexcept
+    {
+        auto& p = pool();
+        if (slot >= p.Slots.size() || p.Slots[slot].Generation != generation || !p.Slots[slot].Live)
+        {
+            return; // already gone, ReleaseAllResources() got to it first
+        }
+        const Slot released = p.Slots[slot];
+        close_slot(slot);
+        switch (released.Kind)
+        {
+            case ResourceKind::Buffer:
+                if (p.Counts.PooledBytes + released.Capacity <= max_pooled_bytes)
+                {
+                    p.Pooled[buffer_key(released.Capacity, released.Element, released.Usage)].push_back(PooledBuffer{ released.Name, released.Capacity, p.Frame });
+                    ++p.Counts.PooledBuffers;
+                    p.Counts.PooledBytes += released.Capacity;
+                }
+                else
+                {
+                    p.DeadBuffers.push_back(released.Name);
+                }
+                break;
+            case ResourceKind::VertexArray: p.DeadVertexArrays.push_back(released.Name); break;
+            case ResourceKind::Program: p.DeadPrograms.push_back(released.Name); break;
+        }
+    }
+
+    BufferHandle CreateBuffer(GLenum target, std::size_t bytes, const void* data, GLenum usage)
+    {
+        auto&             p        = pool();
+        const bool        element  = target == GL_ELEMENT_ARRAY_BUFFER;
+        const std::size_t capacity = size_class(bytes);
+        Handle            name     = 0;
+        bool              recycled = false;
+        if (const auto found = p.Pooled.find(buffer_key(capacity, element, usage)); found != p.Pooled.end() && !found->second.empty() &&
+                                                                                    found->second.front().ReleasedFrame + recycle_after_frames <= p.Frame)
+        {
+            name = found->second.front().Name;
+            found->second.pop_front();
+            --p.Counts.PooledBuffers;
+            p.Counts.PooledBytes -= capacity;
+            recycled = true;
+            ++p.Statistics.Recycled;
+        }
+        else
+        {
+            name = take_name(p.BufferNames, buffer_name_block, [](GLsizei count, GLuint* names) { glGenBuffers(count, names); });
+        }
+
+        // the element binding belongs to the VAO, upload with none bound. Everything else goes through GL_ARRAY_BUFFER,
+        // WebGL2 lets a buffer used there be bound to any other non element target later
+        const GLenum upload_target = element ? GL_ELEMENT_ARRAY_BUFFER : GL_ARRAY_BUFFER;
+        if (element)
+        {
+            BindVertexArray(0);
+        }
+        BindBuffer(upload_target, name);
+        if (!recycled)
+        {
+            BufferData(upload_target, gsl::narrow<GLsizeiptr>(capacity), bytes == capacity ? data : nullptr, usage);
+        }
+        if (data != nullptr && (recycled || bytes != capacity))
+        {
+            BufferSubData(upload_target, 0, gsl::narrow<GLsizeiptr>(bytes), data);
+        }
+
+        const auto [slot, generation] = open_slot(ResourceKind::Buffer, name);
+        Slot& opened                  = p.Slots[slot];
+        opened.Element                = element;
+        opened.Usage                  = usage;
+        opened.Bytes                  = bytes;
+        opened.Capacity               = capacity;
+        p.Counts.BufferBytes += bytes;
+        p.Counts.BufferCapacity += capacity;
+        return BufferHandle{ slot, generation };
+    }
+
+    VertexArrayHandle CreateVertexArray()
+    {
+        const Handle name = take_name(pool().VertexArrayNames, vertex_array_name_block, [](GLsizei count, GLuint* names) { glGenVertexArrays(count, names); });
+        const auto [slot, generation] = open_slot(ResourceKind::VertexArray, name);
+        return VertexArrayHandle{ slot, generation };
+    }
+
+    ProgramHandle AdoptProgram(Handle program)
+    {
+        if (program == 0)
+        {
+            return ProgramHandle{};
+        }
+        const auto [slot, generation] = open_slot(ResourceKind::Program, program);
+        return ProgramHandle{ slot, generation };
+    }
+
+    void CollectResources()
+    {
+        auto& p = pool();
+        ++p.Frame;
+        for (auto& [key, buffers] : p.Pooled)
+        {
+            while (!buffers.empty() && buffers.front().ReleasedFrame + pooled_frames < p.Frame)
+            {
+                p.DeadBuffers.push_back(buffers.front().Name);
+                --p.Counts.PooledBuffers;
+                p.Counts.PooledBytes -= buffers.front().Capacity;
+                buffers.pop_front();
+            }
+        }
+        delete_dead();
+    }
+
+    void ReleaseAllResources()
+    {
+        auto&                p      = pool();
+        const ResourceCounts leaked = p.Counts;
+        for (std::uint32_t index = 0; index < p.Slots.size(); ++index)
+        {
+            const Slot slot = p.Slots[index];
+            if (!slot.Live)
+            {
+                continue;
+            }
+            close_slot(index);
+            switch (slot.Kind)
+            {
+                case ResourceKind::Buffer: p.DeadBuffers.push_back(slot.Name); break;
+                case ResourceKind::VertexArray: p.DeadVertexArrays.push_back(slot.Name); break;
+                case ResourceKind::Program: p.DeadPrograms.push_back(slot.Name); break;
+            }
+        }
+        for (auto& [key, buffers] : p.Pooled)
+        {
+            for (const auto& buffer : buffers)
+            {
+                p.DeadBuffers.push_back(buffer.Name);
+            }
+        }
+        p.Pooled.clear();
+        p.DeadBuffers.insert(p.DeadBuffers.end(), p.BufferNames.begin(), p.BufferNames.end());
+        p.DeadVertexArrays.insert(p.DeadVertexArrays.end(), p.VertexArrayNames.begin(), p.VertexArrayNames.end());
+        p.BufferNames.clear();
+        p.VertexArrayNames.clear();
+        delete_dead();
+        p.Counts = ResourceCounts{};
+
+        if (leaked.Buffers + leaked.VertexArrays + leaked.Programs > 0)
+        {
+            std::cerr << "gpu resources still alive at shutdown : " << leaked.Buffers << " buffers (" << leaked.BufferCapacity << " bytes), " << leaked.VertexArrays
+                      << " vertex arrays, " << leaked.Programs << " programs\n";
+        }
+    }
+
+    ResourceCounts GetResourceCounts() noexcept
+    {
+        return pool().Counts;
+    }
+
+    ResourceStatistics& GetResourceStatistics() noexcept
+    {
+        return pool().Statistics;
+    }
+}
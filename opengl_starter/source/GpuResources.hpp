@@ -0,0 +1,153 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include "Handle.hpp"
+#include <GL/glew.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace OpenGL
+{
+    // Owning handles for the gl objects that get created and thrown away the most (buffers, VAOs, programs).
+    //
+    // A handle doesn't hold the gl name itself but a slot in one pool plus the generation of that slot,
+    // so a handle whose object is already gone is caught by Get() instead of quietly using a name that
+    // may belong to something else by now. Handles are move only and give their object back when they die.
+    //
+    // Nothing is deleted right away : released objects wait for CollectResources(), once a frame, which
+    // deletes them with one glDelete* per kind. New names are generated in blocks for the same reason.
+    // Buffers are rounded up to a size class, and a released buffer is kept for a new one of the same class
+    // (and target, and usage) once the gpu can't be reading it anymore, so a mesh replacing another one
+    // costs a glBufferSubData instead of a delete, a gen and a glBufferData.
+    //
+    // gl thread only, like the state cache.
+    enum class ResourceKind : std::uint8_t
+    {
+        Buffer,
+        VertexArray,
+        Program
+    };
+
+    // the pool side of a handle, use the typed handles below
+    [[nodiscard]] Handle      GetResourceName(std::uint32_t slot, std::uint32_t generation, ResourceKind kind);
+    [[nodiscard]] std::size_t GetBufferCapacity(std::uint32_t slot, std::uint32_t generation);
+    void                      ReleaseResource(std::uint32_t slot, std::uint32_t generation) noexcept;
+
+    template <ResourceKind Kind>
+    class [[nodiscard]] ResourceHandle
+    {
+    public:
+        ResourceHandle() noexcept = default;
+
+        ResourceHandle(std::uint32_t pool_slot, std::uint32_t pool_generation) noexcept : slot(pool_slot), generation(pool_generation)
+        {
+        }
+
+        ResourceHandle(ResourceHandle&& other) noexcept : slot(other.slot), generation(other.generation)
+        {
+            other.generation = 0;
+        }
+
+        ResourceHandle& operator=(ResourceHandle&& other) noexcept
+        {
+            if (this != &other)
+            {
+                Reset();
+                slot             = other.slot;
+                generation       = other.generation;
+                other.generation = 0;
+            }
+            return *this;
+        }
+
+        ResourceHandle(const ResourceHandle&)            = delete;
+        ResourceHandle& operator=(const ResourceHandle&) = delete;
+
+        ~ResourceHandle()
+        {
+            Reset();
+        }
+
+        // the gl name, throws std::logic_error if the object was released already (ReleaseAllResources() for example)
+        [[nodiscard]] Handle Get() const
+        {
+            return generation == 0 ? 0 : GetResourceName(slot, generation, Kind);
+        }
+
+        // bytes of storage the buffer really has, at least what was asked for. Orphan with this size, not less,
+        // the next owner of a recycled buffer may write all of it
+        [[nodiscard]] std::size_t GetCapacity() const
+            requires(Kind == ResourceKind::Buffer)
+        {
+            return generation == 0 ? 0 : GetBufferCapacity(slot, generation);
+        }
+
+        // gives the object back to the pool, does nothing if it's already gone
+        void Reset() noexcept
+        {
+            if (generation != 0)
+            {
+                ReleaseResource(slot, generation);
+                generation = 0;
+            }
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return generation != 0;
+        }
+
+    private:
+        std::uint32_t slot       = 0;
+        std::uint32_t generation = 0; // 0 : empty
+    };
+
+    using BufferHandle      = ResourceHandle<ResourceKind::Buffer>;
+    using VertexArrayHandle = ResourceHandle<ResourceKind::VertexArray>;
+    using ProgramHandle     = ResourceHandle<ResourceKind::Program>;
+
+    // bytes of storage, filled with data if it isn't null. GL_ELEMENT_ARRAY_BUFFER ones are uploaded with VAO 0 bound
+    // and are only ever recycled as element buffers (WebGL2 won't bind them to anything else)
+    BufferHandle      CreateBuffer(GLenum target, std::size_t bytes, const void* data = nullptr, GLenum usage = GL_STATIC_DRAW);
+    VertexArrayHandle CreateVertexArray();
+    // takes ownership of a program made with glCreateProgram / glProgramBinary
+    ProgramHandle AdoptProgram(Handle program);
+
+    // once a frame, after the frame's draws : deletes what was released and lets recycled buffers age
+    void CollectResources();
+    // before the context goes away : deletes everything, reports what was still alive to std::cerr.
+    // Handles left over after that are stale, destroying them is fine, Get() throws
+    void ReleaseAllResources();
+
+    // what exists right now
+    struct ResourceCounts
+    {
+        int         Buffers        = 0;
+        int         VertexArrays   = 0;
+        int         Programs       = 0;
+        std::size_t BufferBytes    = 0; // what the live buffers asked for
+        std::size_t BufferCapacity = 0; // what they really have, after rounding up to a size class
+        int         PooledBuffers  = 0; // released buffers kept for recycling
+        std::size_t PooledBytes    = 0;
+    };
+
+    [[nodiscard]] ResourceCounts GetResourceCounts() noexcept;
+
+    // what happened, reset with GetResourceStatistics() = {}
+    struct ResourceStatistics
+    {
+        std::uint64_t GenCalls      = 0; // glGenBuffers / glGenVertexArrays
+        std::uint64_t DeleteCalls   = 0; // glDeleteBuffers / glDeleteVertexArrays / glDeleteProgram
+        std::uint64_t Created       = 0; // handles handed out
+        std::uint64_t Recycled      = 0; // buffers that came out of the pool instead of a new glBufferData
+        std::uint64_t StaleAccesses = 0; // Get() on a handle whose object was gone
+    };
+
+    [[nodiscard]] ResourceStatistics& GetResourceStatistics() noexcept;
+}
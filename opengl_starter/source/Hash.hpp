@@ -0,0 +1,30 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace Hash
+{
+    // 64 bit FNV-1a, simple and constexpr friendly. Good for cache keys, not for security
+    constexpr std::uint64_t FNV1aOffset = 14695981039346656037ull;
+    constexpr std::uint64_t FNV1aPrime  = 1099511628211ull;
+
+    // pass the previous result as seed to hash several pieces as if they were one
+    constexpr std::uint64_t FNV1a(std::string_view text, std::uint64_t seed = FNV1aOffset) noexcept
+    {
+        std::uint64_t hash = seed;
+        for (const char c : text)
+        {
+            hash ^= static_cast<std::uint8_t>(c);
+            hash *= FNV1aPrime;
+        }
+        return hash;
+    }
+}
@@ -0,0 +1,153 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "HeadlessContext.hpp"
+
+#include <GL/glew.h>
+// no X11 types in the egl headers, we never talk to a display server
+#define EGL_NO_X11
+#define MESA_EGL_NO_X11_HEADERS
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <stdexcept>
+
+namespace
+{
+    [[nodiscard]] EGLDisplay open_display()
+    {
+#if defined(EGL_PLATFORM_SURFACELESS_MESA)
+        // surfaceless needs neither a display server nor a gpu device node
+        const auto get_platform_display = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+        if (get_platform_display != nullptr)
+        {
+            if (EGLDisplay display = get_platform_display(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr); display != EGL_NO_DISPLAY)
+            {
+                if (eglInitialize(display, nullptr, nullptr) == EGL_TRUE)
+                {
+                    return display;
+                }
+            }
+        }
+#endif
+        EGLDisplay display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+        if (display == EGL_NO_DISPLAY || eglInitialize(display, nullptr, nullptr) != EGL_TRUE)
+        {
+            throw std::runtime_error("Unable to open an EGL display");
+        }
+        return display;
+    }
+}
+
+namespace OpenGL
+{
+    HeadlessContext::HeadlessContext(int width, int height)
+    {
+        // no destructor after a constructor throws, the display and context egl already gave us go back here
+        try
+        {
+            create(width, height);
+        }
+        catch (...)
+        {
+            release();
+            throw;
+        }
+    }
+
+    HeadlessContext::~HeadlessContext()
+    {
+        release();
+    }
+
+    void HeadlessContext::create(int width, int height)
+    {
+        EGLDisplay egl_display = open_display();
+        display                = egl_display;
+        if (eglBindAPI(EGL_OPENGL_API) != EGL_TRUE)
+        {
+            throw std::runtime_error("EGL has no desktop OpenGL");
+        }
+
+        constexpr EGLint config_attributes[] = { EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_SURFACE_TYPE, EGL_PBUFFER_BIT, EGL_NONE };
+        EGLConfig        config              = nullptr;
+        EGLint           config_count        = 0;
+        if (eglChooseConfig(egl_display, config_attributes, &config, 1, &config_count) != EGL_TRUE || config_count == 0)
+        {
+            throw std::runtime_error("No EGL config can render OpenGL");
+        }
+
+        // same as what SDL asks for on desktop
+        constexpr EGLint context_attributes[] = { EGL_CONTEXT_MAJOR_VERSION, 3, EGL_CONTEXT_MINOR_VERSION, 3, EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT, EGL_NONE };
+        EGLContext       egl_context          = eglCreateContext(egl_display, config, EGL_NO_CONTEXT, context_attributes);
+        if (egl_context == EGL_NO_CONTEXT)
+        {
+            throw std::runtime_error("Unable to create an OpenGL 3.3 core context");
+        }
+        context = egl_context;
+        // no surface at all (EGL_KHR_surfaceless_context), the framebuffer object below is all we draw into
+        if (eglMakeCurrent(egl_display, EGL_NO_SURFACE, EGL_NO_SURFACE, egl_context) != EGL_TRUE)
+        {
+            throw std::runtime_error("Unable to make the headless context current");
+        }
+
+        glewExperimental      = GL_TRUE;
+        const auto glew_error = glewInit();
+#if defined(GLEW_ERROR_NO_GLX_DISPLAY)
+        // a GLX build of glew still loads the gl functions, it only complains that there is no X display
+        if (glew_error != GLEW_OK && glew_error != GLEW_ERROR_NO_GLX_DISPLAY)
+#else
+        if (glew_error != GLEW_OK)
+#endif
+        {
+            throw std::runtime_error("Unable to load the OpenGL functions");
+        }
+
+        glGenRenderbuffers(1, &renderbuffer);
+        glBindRenderbuffer(GL_RENDERBUFFER, renderbuffer);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+        glGenFramebuffers(1, &framebuffer);
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, renderbuffer);
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        {
+            throw std::runtime_error("Headless framebuffer is incomplete");
+        }
+    }
+
+    void HeadlessContext::release() noexcept
+    {
+        if (context != nullptr)
+        {
+            // only made once the gl functions were loaded
+            if (framebuffer != 0)
+            {
+                glDeleteFramebuffers(1, &framebuffer);
+                framebuffer = 0;
+            }
+            if (renderbuffer != 0)
+            {
+                glDeleteRenderbuffers(1, &renderbuffer);
+                renderbuffer = 0;
+            }
+            eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+            eglDestroyContext(display, context);
+            context = nullptr;
+        }
+        if (display != nullptr)
+        {
+            eglTerminate(display);
+            display = nullptr;
+        }
+    }
+
+    std::string HeadlessContext::Describe() const
+    {
+        const auto* renderer = reinterpret_cast<const char*>(glGetString(GL_RENDERER));
+        const auto* version  = reinterpret_cast<const char*>(glGetString(GL_VERSION));
+        return std::string{ renderer != nullptr ? renderer : "?" } + " | " + (version != nullptr ? version : "?");
+    }
+}
@@ -0,0 +1,42 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include "Handle.hpp"
+#include <string>
+
+namespace OpenGL
+{
+    // OpenGL 3.3 core context with no window behind it, for machines without a display (CI).
+    // EGL picks the Mesa surfaceless platform when it's there, so software rendering (llvmpipe) works without a gpu.
+    // Everything gets drawn into an RGBA8 framebuffer object that stays bound, there is nothing to present and no vsync.
+    class HeadlessContext
+    {
+    public:
+        // throws std::runtime_error when no context could be made
+        HeadlessContext(int width, int height);
+        ~HeadlessContext();
+
+        HeadlessContext(const HeadlessContext&)            = delete;
+        HeadlessContext& operator=(const HeadlessContext&) = delete;
+
+        // GL_RENDERER + GL_VERSION, so results can be told apart
+        [[nodiscard]] std::string Describe() const;
+
+    private:
+        void create(int width, int height);
+        // gives back whatever create() got so far, so it also cleans up after a constructor that threw
+        void release() noexcept;
+
+    private:
+        void*  display      = nullptr; // EGLDisplay / EGLContext, kept out of the header
+        void*  context      = nullptr;
+        Handle framebuffer  = 0;
+        Handle renderbuffer = 0;
+    };
+}
@@ -0,0 +1,163 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "Image.hpp"
+
+#include "MappedFile.hpp"
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+    // the 18 byte header, little endian
+    constexpr std::size_t header_size = 18;
+    // 16384 x 16384, 1 GB of rgba. Run length data can claim a lot of pixels in few bytes
+    constexpr std::size_t max_rle_pixels = std::size_t{ 16384 } * 16384;
+
+    enum : std::uint8_t
+    {
+        tga_truecolor     = 2,
+        tga_gray          = 3,
+        tga_rle_truecolor = 10,
+        tga_rle_gray      = 11
+    };
+
+    [[nodiscard]] std::uint8_t byte_at(std::span<const std::byte> bytes, std::size_t offset)
+    {
+        if (offset >= bytes.size())
+        {
+            throw std::runtime_error("TGA file is cut short");
+        }
+        return static_cast<std::uint8_t>(bytes[offset]);
+    }
+
+    [[nodiscard]] int word_at(std::span<const std::byte> bytes, std::size_t offset)
+    {
+        return byte_at(bytes, offset) | (byte_at(bytes, offset + 1) << 8);
+    }
+}
+
+namespace OpenGL
+{
+    Image DecodeTGA(std::span<const std::byte> bytes)
+    {
+        const std::uint8_t id_length       = byte_at(bytes, 0);
+        const std::uint8_t color_map_type  = byte_at(bytes, 1);
+        const std::uint8_t image_type      = byte_at(bytes, 2);
+        const int          width           = word_at(bytes, 12);
+        const int          height          = word_at(bytes, 14);
+        const std::uint8_t bits_per_pixel  = byte_at(bytes, 16);
+        const std::uint8_t descriptor      = byte_at(bytes, 17);
+        const bool         gray            = image_type == tga_gray || image_type == tga_rle_gray;
+        const bool         run_length      = image_type == tga_rle_truecolor || image_type == tga_rle_gray;
+        const bool         top_left_origin = (descriptor & 0x20) != 0;
+        if (color_map_type != 0 || (!gray && image_type != tga_truecolor && !run_length))
+        {
+            throw std::runtime_error("TGA image type " + std::to_string(image_type) + " isn't supported, only true color and gray");
+        }
+        if ((gray && bits_per_pixel != 8) || (!gray && bits_per_pixel != 24 && bits_per_pixel != 32) || width == 0 || height == 0)
+        {
+            throw std::runtime_error("TGA with " + std::to_string(bits_per_pixel) + " bits per pixel isn't supported");
+        }
+
+        const std::size_t pixel_bytes = bits_per_pixel / 8u;
+        const std::size_t pixel_count = static_cast<std::size_t>(width) * static_cast<std::size_t>(height);
+        std::size_t       offset      = header_size + id_length;
+        // check the header against the file before allocating what it asks for, a bad_alloc isn't a load error
+        const std::size_t remaining   = bytes.size() > offset ? bytes.size() - offset : 0;
+        if (!run_length && remaining / pixel_bytes < pixel_count)
+        {
+            throw std::runtime_error("TGA file is cut short");
+        }
+        // a packet is a header byte and at least one pixel, and covers at most 128 pixels
+        if (run_length && (pixel_count > max_rle_pixels || remaining / (1 + pixel_bytes) < (pixel_count + 127) / 128))
+        {
+            throw std::runtime_error("TGA run length data is too short for " + std::to_string(width) + "x" + std::to_string(height));
+        }
+        Image image{ width, height, std::vector<std::uint8_t>(pixel_count * 4) };
+
+        // pixels come in file order, bottom row first unless the descriptor says otherwise
+        const auto store = [&](std::size_t pixel, std::size_t from)
+        {
+            const std::size_t column = pixel % static_cast<std::size_t>(width);
+            const std::size_t row    = pixel / static_cast<std::size_t>(width);
+            const std::size_t top    = top_left_origin ? row : static_cast<std::size_t>(height) - 1 - row;
+            std::uint8_t*     rgba   = image.Pixels.data() + (top * static_cast<std::size_t>(width) + column) * 4;
+            if (gray)
+            {
+                rgba[0] = rgba[1] = rgba[2] = byte_at(bytes, from);
+                rgba[3]                     = 255;
+                return;
+            }
+            rgba[0] = byte_at(bytes, from + 2);
+            rgba[1] = byte_at(bytes, from + 1);
+            rgba[2] = byte_at(bytes, from);
+            rgba[3] = (pixel_bytes == 4) ? byte_at(bytes, from + 3) : std::uint8_t{ 255 };
+        };
+
+        for (std::size_t pixel = 0; pixel < pixel_count;)
+        {
+            if (!run_length)
+            {
+                store(pixel++, offset);
+                offset += pixel_bytes;
+                continue;
+            }
+            // packet header : high bit set, one pixel repeated, otherwise that many raw pixels
+            const std::uint8_t packet = byte_at(bytes, offset++);
+            const std::size_t  count  = std::min<std::size_t>((packet & 0x7Fu) + 1u, pixel_count - pixel);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                store(pixel++, (packet & 0x80) != 0 ? offset : offset + i * pixel_bytes);
+            }
+            offset += (packet & 0x80) != 0 ? pixel_bytes : count * pixel_bytes;
+        }
+        return image;
+    }
+
+    std::vector<std::byte> EncodeTGA(const Image& image)
+    {
+        // the header goes through an array, gcc can't tell a vector of header_size + n bytes isn't empty
+        std::array<std::byte, header_size> header{};
+        header[2]  = std::byte{ tga_truecolor };
+        header[12] = static_cast<std::byte>(image.Width & 0xFF);
+        header[13] = static_cast<std::byte>(image.Width >> 8);
+        header[14] = static_cast<std::byte>(image.Height & 0xFF);
+        header[15] = static_cast<std::byte>(image.Height >> 8);
+        header[16] = std::byte{ 32 };
+        header[17] = std::byte{ 0x28 }; // top left origin, 8 alpha bits
+        std::vector<std::byte> bytes(header.begin(), header.end());
+        bytes.resize(header_size + image.Pixels.size());
+        for (std::size_t i = 0; i < image.Pixels.size(); i += 4)
+        {
+            bytes[header_size + i]     = static_cast<std::byte>(image.Pixels[i + 2]);
+            bytes[header_size + i + 1] = static_cast<std::byte>(image.Pixels[i + 1]);
+            bytes[header_size + i + 2] = static_cast<std::byte>(image.Pixels[i]);
+            bytes[header_size + i + 3] = static_cast<std::byte>(image.Pixels[i + 3]);
+        }
+        return bytes;
+    }
+
+    Image LoadImage(const std::filesystem::path& file_path)
+    {
+        if (file_path.extension() != ".tga")
+        {
+            throw std::runtime_error("Can't load " + file_path.string() + ", only .tga images are supported");
+        }
+        try
+        {
+            const MappedFile file(file_path);
+            return DecodeTGA(file.GetBytes());
+        }
+        catch (const std::runtime_error& error)
+        {
+            throw std::runtime_error(file_path.string() + " : " + error.what());
+        }
+    }
+}
@@ -0,0 +1,34 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+namespace OpenGL
+{
+    // 8 bit RGBA, top row first, ready for glTexSubImage2D
+    struct Image
+    {
+        int                       Width  = 0;
+        int                       Height = 0;
+        std::vector<std::uint8_t> Pixels{}; // Width * Height * 4
+    };
+
+    // Truevision TGA : uncompressed or RLE, 8 bit gray, 24 bit BGR or 32 bit BGRA, either origin.
+    // Throws std::runtime_error for anything else or a truncated file
+    [[nodiscard]] Image DecodeTGA(std::span<const std::byte> bytes);
+    // uncompressed 32 bit with a top left origin
+    [[nodiscard]] std::vector<std::byte> EncodeTGA(const Image& image);
+
+    // .tga only for now, mapped then decoded. Safe to call from any thread
+    [[nodiscard]] Image LoadImage(const std::filesystem::path& file_path);
+}
@@ -0,0 +1,112 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "InstancedMesh.hpp"
+
+#include "FrameCapture.hpp"
+#include "GLState.hpp"
+#include "VertexLayout.hpp"
+#include <GL/glew.h>
+#include <algorithm>
+#include <cstddef>
+#include <gsl/gsl>
+#include <string>
+
+namespace
+{
+    // instanced variant of the vertex shader in setup() : uModel became a per instance attribute
+    // a mat3 attribute takes 3 locations, one per column
+    constexpr auto instanced_vertex_header = R"(#version 300 es
+layout(location = 0) in vec2 aVertexPosition;
+layout(location = 1) in vec3 aVertexColor;
+layout(location = 2) in mat3 aModel;
+layout(location = 5) in vec3 aInstanceColor;
+)";
+
+    constexpr auto instanced_vertex_body = R"(out vec3 vColor;
+void main()
+{
+    vec3 cam_position = aModel * vec3(aVertexPosition, 1.0);
+    vec3 ndc_position = uToNDC * cam_position;
+    gl_Position = vec4(ndc_position.xy, 0.0, 1.0);
+    vColor = aVertexColor * aInstanceColor;
+}
+)";
+
+    constexpr auto instanced_fragment_glsl = R"(#version 300 es
+precision mediump float;
+
+in vec3 vColor;
+out vec4 FragColor;
+
+void main()
+{
+    FragColor = vec4(vColor, 1.0);
+}
+)";
+
+    constexpr GLuint model_location = 2;
+    constexpr GLuint color_location = 5;
+}
+
+namespace OpenGL
+{
+    InstancedMesh::InstancedMesh(const FrameUniformBuffer& frame_uniforms, const Mesh& mesh, std::size_t max_instances)
+        : indexCount(mesh.IndexCount), indexType(mesh.IndexType), maxInstances(std::max(max_instances, std::size_t{ 1 }))
+    {
+        const std::string vertex_glsl = std::string{ instanced_vertex_header } + FrameUniformsGLSL + instanced_vertex_body;
+        shader                        = CreateShader(std::string_view{ vertex_glsl }, std::string_view{ instanced_fragment_glsl });
+        frame_uniforms.Attach(shader);
+
+        instanceBuffer    = CreateBuffer(GL_ARRAY_BUFFER, maxInstances * sizeof(InstanceData), nullptr, GL_STREAM_DRAW);
+        vertexArrayObject = CreateVertexArray();
+        BindVertexArray(vertexArrayObject.Get());
+
+        // per vertex data, same as the mesh's own VAO
+        BindBuffer(GL_ARRAY_BUFFER, mesh.VertexBuffer.Get());
+        BindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.IndexBuffer.Get());
+        DescribeVertexLayout(GetVertexLayout(mesh.Format));
+
+        // per instance data, divisor 1 : advance once per instance instead of once per vertex
+        BindBuffer(GL_ARRAY_BUFFER, instanceBuffer.Get());
+        for (GLuint column = 0; column < 3; ++column)
+        {
+            const std::uintptr_t offset = offsetof(InstanceData, Model) + column * 3 * sizeof(float);
+            EnableVertexAttribArray(model_location + column);
+            VertexAttribPointer(model_location + column, 3, GL_FLOAT, false, sizeof(InstanceData), offset);
+            VertexAttribDivisor(model_location + column, 1);
+        }
+        const std::uintptr_t color_offset = offsetof(InstanceData, r);
+        EnableVertexAttribArray(color_location);
+        VertexAttribPointer(color_location, 3, GL_FLOAT, false, sizeof(InstanceData), color_offset);
+        VertexAttribDivisor(color_location, 1);
+    }
+
+    InstancedMesh::~InstancedMesh()
+    {
+        DestroyShader(shader);
+    }
+
+    int InstancedMesh::Draw(std::span<const InstanceData> instances)
+    {
+        const auto count = std::min(instances.size(), maxInstances);
+        if (count == 0)
+        {
+            return 0;
+        }
+
+        // orphan then upload, the gpu can keep reading last frame's instances
+        BindBuffer(GL_ARRAY_BUFFER, instanceBuffer.Get());
+        BufferData(GL_ARRAY_BUFFER, gsl::narrow<GLsizeiptr>(instanceBuffer.GetCapacity()), nullptr, GL_STREAM_DRAW);
+        BufferSubData(GL_ARRAY_BUFFER, 0, gsl::narrow<GLsizeiptr>(count * sizeof(InstanceData)), instances.data());
+
+        UseProgram(shader.Shader);
+        BindVertexArray(vertexArrayObject.Get());
+        DrawElementsInstanced(GL_TRIANGLES, indexCount, indexType, 0, gsl::narrow<GLsizei>(count));
+        return 1;
+    }
+}
@@ -0,0 +1,55 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include "FrameUniforms.hpp"
+#include "GpuResources.hpp"
+#include "Handle.hpp"
+#include "Math.hpp"
+#include "Mesh.hpp"
+#include "Shader.hpp"
+#include <cstddef>
+#include <span>
+
+namespace OpenGL
+{
+    // what every copy of the mesh gets on its own, fed through divisor 1 attributes
+    // location 2,3,4 : model matrix columns, location 5 : rgb tint
+    struct InstanceData
+    {
+        Math::mat3 Model;
+        float      r;
+        float      g;
+        float      b;
+    };
+
+    // Draws one shared mesh many times with glDrawElementsInstanced.
+    // The mesh's buffers are borrowed (any VertexFormat and index type), the per instance buffer
+    // is owned and streamed every Draw() call.
+    class InstancedMesh
+    {
+    public:
+        InstancedMesh(const FrameUniformBuffer& frame_uniforms, const Mesh& mesh, std::size_t max_instances);
+        ~InstancedMesh();
+
+        InstancedMesh(const InstancedMesh&)            = delete;
+        InstancedMesh& operator=(const InstancedMesh&) = delete;
+
+        // draws min(instances.size(), max_instances) copies, returns the number of draw calls issued
+        // uToNDC comes from the FrameData block, so FrameUniformBuffer::Update() has to run first
+        int Draw(std::span<const InstanceData> instances);
+
+    private:
+        CompiledShader    shader{};
+        BufferHandle      instanceBuffer{};
+        VertexArrayHandle vertexArrayObject{};
+        GLsizei           indexCount   = 0;
+        GLenum            indexType    = GL_UNSIGNED_SHORT;
+        std::size_t       maxInstances = 0;
+    };
+}
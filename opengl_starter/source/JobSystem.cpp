@@ -0,0 +1,171 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "JobSystem.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace Jobs
+{
+    JobSystem::JobSystem([[maybe_unused]] unsigned thread_count)
+    {
+#if defined(__EMSCRIPTEN__)
+        // no pthreads in this build
+        const unsigned count = 1;
+#else
+        const unsigned count = (thread_count == 0) ? std::max(1u, std::thread::hardware_concurrency()) : thread_count;
+#endif
+        for (unsigned i = 0; i < count; ++i)
+        {
+            queues.push_back(std::make_unique<Queue>());
+        }
+        // worker 0 is whoever calls ParallelFor()
+        for (unsigned worker = 1; worker < count; ++worker)
+        {
+            threads.emplace_back([this, worker] { worker_loop(worker); });
+        }
+    }
+
+    JobSystem::~JobSystem()
+    {
+        {
+            const std::lock_guard lock(wakeMutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    void JobSystem::ParallelFor(std::size_t count, std::size_t grain, const RangeWork& work)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+        grain                     = std::max<std::size_t>(1, grain);
+        const std::size_t chunks  = (count + grain - 1) / grain;
+        const std::size_t workers = queues.size();
+        if (workers == 1 || chunks == 1)
+        {
+            // nobody to share with, skip the queues
+            for (std::size_t begin = 0; begin < count; begin += grain)
+            {
+                work(begin, std::min(count, begin + grain), 0);
+            }
+            chunksRun.fetch_add(chunks, std::memory_order_relaxed);
+            return;
+        }
+
+        current    = &work;
+        firstError = nullptr;
+        remaining.store(chunks, std::memory_order_release);
+        // neighbouring chunks go to the same worker, it walks its run front to back
+        for (std::size_t worker = 0; worker < workers; ++worker)
+        {
+            const std::size_t     first = chunks * worker / workers;
+            const std::size_t     last  = chunks * (worker + 1) / workers;
+            const std::lock_guard lock(queues[worker]->Mutex);
+            for (std::size_t chunk = first; chunk < last; ++chunk)
+            {
+                queues[worker]->Chunks.push_back(Chunk{ chunk * grain, std::min(count, (chunk + 1) * grain) });
+            }
+        }
+        {
+            // taking the lock orders the store above with a worker checking it before going to sleep
+            const std::lock_guard lock(wakeMutex);
+        }
+        wake.notify_all();
+
+        while (remaining.load(std::memory_order_acquire) > 0)
+        {
+            if (!run_one(0))
+            {
+                std::this_thread::yield(); // the last chunks are running on other threads
+            }
+        }
+        current = nullptr;
+        if (firstError)
+        {
+            std::rethrow_exception(std::exchange(firstError, nullptr));
+        }
+    }
+
+    bool JobSystem::run_one(unsigned worker)
+    {
+        Chunk chunk{};
+        bool  found = false;
+        {
+            auto&                 own = *queues[worker];
+            const std::lock_guard lock(own.Mutex);
+            if (!own.Chunks.empty())
+            {
+                chunk = own.Chunks.front();
+                own.Chunks.pop_front();
+                found = true;
+            }
+        }
+        // steal from the far end, the owner is busy near the front
+        for (std::size_t i = 1; !found && i < queues.size(); ++i)
+        {
+            auto&                 victim = *queues[(worker + i) % queues.size()];
+            const std::lock_guard lock(victim.Mutex);
+            if (!victim.Chunks.empty())
+            {
+                chunk = victim.Chunks.back();
+                victim.Chunks.pop_back();
+                found = true;
+                steals.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        if (!found)
+        {
+            return false;
+        }
+
+        try
+        {
+            (*current)(chunk.Begin, chunk.End, worker);
+        }
+        catch (...)
+        {
+            const std::lock_guard lock(errorMutex);
+            if (!firstError)
+            {
+                firstError = std::current_exception();
+            }
+        }
+        chunksRun.fetch_add(1, std::memory_order_relaxed);
+        remaining.fetch_sub(1, std::memory_order_acq_rel);
+        return true;
+    }
+
+    void JobSystem::worker_loop(unsigned worker)
+    {
+        while (true)
+        {
+            {
+                std::unique_lock lock(wakeMutex);
+                wake.wait(lock, [this] { return stopping || remaining.load(std::memory_order_acquire) > 0; });
+                if (stopping)
+                {
+                    return;
+                }
+            }
+            while (remaining.load(std::memory_order_acquire) > 0)
+            {
+                if (!run_one(worker))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }
+    }
+}
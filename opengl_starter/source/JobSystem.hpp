@@ -0,0 +1,93 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Jobs
+{
+    // Worker threads that split loops between them.
+    // ParallelFor() cuts the range into chunks and hands each worker a run of them in its own queue. A worker takes
+    // from the front of its queue, and once it runs dry it steals from the back of another one, so threads that got
+    // cheap chunks help the ones that got expensive ones. The calling thread is worker 0 and works too.
+    // The web build has no pthreads, everything runs on the calling thread there.
+    class JobSystem
+    {
+    public:
+        // [begin, end) : one chunk of the range. worker : 0..GetWorkerCount()-1, no two threads run with the same one at once,
+        // so it can index per worker scratch (a CommandBuffer each, ...) without locks
+        using RangeWork = std::function<void(std::size_t begin, std::size_t end, unsigned worker)>;
+
+        struct Statistics
+        {
+            std::uint64_t Chunks = 0; // ran
+            std::uint64_t Steals = 0; // ran by a worker that took them from someone else's queue
+        };
+
+        // thread_count counts the calling thread, 0 : one per core
+        explicit JobSystem(unsigned thread_count = 0);
+        ~JobSystem();
+
+        JobSystem(const JobSystem&)            = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        // work over [0, count) in chunks of grain items (the last one shorter), returns once every chunk ran.
+        // One ParallelFor at a time, from one thread. The first exception a chunk throws comes out of here
+        void ParallelFor(std::size_t count, std::size_t grain, const RangeWork& work);
+
+        [[nodiscard]] unsigned GetWorkerCount() const noexcept
+        {
+            return static_cast<unsigned>(queues.size());
+        }
+
+        [[nodiscard]] Statistics GetStatistics() const noexcept
+        {
+            return Statistics{ chunksRun.load(std::memory_order_relaxed), steals.load(std::memory_order_relaxed) };
+        }
+
+    private:
+        struct Chunk
+        {
+            std::size_t Begin = 0;
+            std::size_t End   = 0;
+        };
+
+        struct Queue
+        {
+            std::mutex        Mutex;
+            std::deque<Chunk> Chunks;
+        };
+
+        // one chunk from our own queue or someone else's, false if every queue was empty
+        bool run_one(unsigned worker);
+        void worker_loop(unsigned worker);
+
+    private:
+        std::vector<std::unique_ptr<Queue>> queues{}; // one per worker
+        std::vector<std::thread>            threads{};
+        std::mutex                          wakeMutex{};
+        std::condition_variable             wake{};
+        bool                                stopping = false; // guarded by wakeMutex
+        const RangeWork*                    current  = nullptr;
+        std::atomic<std::size_t>            remaining{ 0 }; // chunks of the current ParallelFor not finished yet
+        std::mutex                          errorMutex{};
+        std::exception_ptr                  firstError{};
+        std::atomic<std::uint64_t>          chunksRun{ 0 };
+        std::atomic<std::uint64_t>          steals{ 0 };
+    };
+}
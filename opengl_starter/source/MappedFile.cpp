@@ -0,0 +1,176 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "MappedFile.hpp"
+
+#include <fstream>
+#include <gsl/gsl>
+#include <stdexcept>
+#include <utility>
+
+#if defined(_WIN32)
+#    define WIN32_LEAN_AND_MEAN
+#    define NOMINMAX
+#    include <windows.h>
+#elif !defined(__EMSCRIPTEN__)
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+namespace
+{
+    [[nodiscard]] std::runtime_error cannot_open(const std::filesystem::path& file_path)
+    {
+        return std::runtime_error("Cannot open " + file_path.string());
+    }
+
+    [[nodiscard]] std::vector<std::byte> read_whole_file(const std::filesystem::path& file_path)
+    {
+        std::ifstream ifs(file_path, std::ios::in | std::ios::binary);
+        if (!ifs)
+        {
+            throw cannot_open(file_path);
+        }
+        std::vector<std::byte> bytes(gsl::narrow<std::size_t>(std::filesystem::file_size(file_path)));
+        ifs.read(reinterpret_cast<char*>(bytes.data()), gsl::narrow<std::streamsize>(bytes.size()));
+        if (!ifs)
+        {
+            throw cannot_open(file_path);
+        }
+        return bytes;
+    }
+}
+
+namespace OpenGL
+{
+    MappedFile::MappedFile(const std::filesystem::path& file_path)
+    {
+#if defined(__EMSCRIPTEN__)
+        copy = read_whole_file(file_path);
+        data = copy.data();
+        size = copy.size();
+#elif defined(_WIN32)
+        fileHandle = CreateFileW(file_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (fileHandle == INVALID_HANDLE_VALUE)
+        {
+            fileHandle = nullptr;
+            throw cannot_open(file_path);
+        }
+        LARGE_INTEGER file_size{};
+        GetFileSizeEx(fileHandle, &file_size);
+        size = gsl::narrow<std::size_t>(file_size.QuadPart);
+        if (size == 0)
+        {
+            return; // can't map an empty file, and there's nothing to map
+        }
+        mappingHandle = CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        mapping       = (mappingHandle != nullptr) ? MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        if (mapping == nullptr)
+        {
+            // same as below, still works, just with a copy
+            release();
+            copy = read_whole_file(file_path);
+            data = copy.data();
+            size = copy.size();
+            return;
+        }
+        data = static_cast<const std::byte*>(mapping);
+#else
+        const int file = open(file_path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (file < 0)
+        {
+            throw cannot_open(file_path);
+        }
+        struct stat status{};
+        if (fstat(file, &status) != 0)
+        {
+            close(file);
+            throw cannot_open(file_path);
+        }
+        size = gsl::narrow<std::size_t>(status.st_size);
+        if (size > 0)
+        {
+            void* const view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+            if (view != MAP_FAILED)
+            {
+                mapping = view;
+                data    = static_cast<const std::byte*>(view);
+                // we read these front to back, once
+                madvise(view, size, MADV_SEQUENTIAL);
+            }
+        }
+        // the mapping keeps the file alive on its own
+        close(file);
+        if (size > 0 && mapping == nullptr)
+        {
+            // some filesystems can't be mapped, a plain read still works
+            copy = read_whole_file(file_path);
+            data = copy.data();
+            size = copy.size();
+        }
+#endif
+    }
+
+    MappedFile::~MappedFile()
+    {
+        release();
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+    {
+        *this = std::move(other);
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            data    = std::exchange(other.data, nullptr);
+            size    = std::exchange(other.size, 0);
+            mapping = std::exchange(other.mapping, nullptr);
+            copy    = std::move(other.copy);
+            // moving a vector keeps its buffer, data still points at the right bytes
+#if defined(_WIN32)
+            fileHandle    = std::exchange(other.fileHandle, nullptr);
+            mappingHandle = std::exchange(other.mappingHandle, nullptr);
+#endif
+        }
+        return *this;
+    }
+
+    void MappedFile::release() noexcept
+    {
+#if defined(_WIN32)
+        if (mapping != nullptr)
+        {
+            UnmapViewOfFile(mapping);
+        }
+        if (mappingHandle != nullptr)
+        {
+            CloseHandle(mappingHandle);
+        }
+        if (fileHandle != nullptr)
+        {
+            CloseHandle(fileHandle);
+        }
+        fileHandle    = nullptr;
+        mappingHandle = nullptr;
+#elif !defined(__EMSCRIPTEN__)
+        if (mapping != nullptr)
+        {
+            munmap(mapping, size);
+        }
+#endif
+        mapping = nullptr;
+        data    = nullptr;
+        size    = 0;
+        copy.clear();
+    }
+}
@@ -0,0 +1,56 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+namespace OpenGL
+{
+    // Read only view of a whole file. Desktop maps it (mmap / MapViewOfFile) so nothing gets copied
+    // until someone touches the pages. Emscripten's --embed-file filesystem already lives in memory and
+    // its mmap would copy anyway, so there the file is simply read into a vector.
+    class MappedFile
+    {
+    public:
+        // throws std::runtime_error if the file can't be opened, falls back to reading it when it can't be mapped
+        explicit MappedFile(const std::filesystem::path& file_path);
+        ~MappedFile();
+
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+        MappedFile(const MappedFile&)            = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        [[nodiscard]] std::span<const std::byte> GetBytes() const noexcept
+        {
+            return { data, size };
+        }
+
+        // false when the bytes were read into memory instead
+        [[nodiscard]] bool IsMapped() const noexcept
+        {
+            return mapping != nullptr;
+        }
+
+    private:
+        void release() noexcept;
+
+    private:
+        const std::byte*       data    = nullptr;
+        std::size_t            size    = 0;
+        void*                  mapping = nullptr; // the mapped view, null when reading into copy
+        std::vector<std::byte> copy{};
+#if defined(_WIN32)
+        void* fileHandle    = nullptr;
+        void* mappingHandle = nullptr;
+#endif
+    };
+}
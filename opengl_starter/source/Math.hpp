@@ -0,0 +1,87 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include <array>
+#include <cmath>
+
+namespace Math
+{
+    // same layout glsl expects for a mat3 : column order
+    // { m00, m10, m20,   // column 0
+    //   m01, m11, m21,   // column 1
+    //   m02, m12, m22 }  // column 2
+    using mat3 = std::array<float, 9>;
+
+    constexpr mat3 IdentityMatrix() noexcept
+    {
+        return mat3{ 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f };
+    }
+
+    constexpr mat3 TranslationMatrix(float x, float y) noexcept
+    {
+        return mat3{ 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, x, y, 1.0f };
+    }
+
+    constexpr mat3 ScaleMatrix(float sx, float sy) noexcept
+    {
+        return mat3{ sx, 0.0f, 0.0f, 0.0f, sy, 0.0f, 0.0f, 0.0f, 1.0f };
+    }
+
+    inline mat3 RotationMatrix(float radians) noexcept
+    {
+        const float c = std::cos(radians);
+        const float s = std::sin(radians);
+        return mat3{ c, s, 0.0f, -s, c, 0.0f, 0.0f, 0.0f, 1.0f };
+    }
+
+    // a * b, so b is applied first
+    constexpr mat3 Multiply(const mat3& a, const mat3& b) noexcept
+    {
+        mat3 result{};
+        for (int column = 0; column < 3; ++column)
+        {
+            for (int row = 0; row < 3; ++row)
+            {
+                float sum = 0.0f;
+                for (int k = 0; k < 3; ++k)
+                {
+                    sum += a[static_cast<std::size_t>(k * 3 + row)] * b[static_cast<std::size_t>(column * 3 + k)];
+                }
+                result[static_cast<std::size_t>(column * 3 + row)] = sum;
+            }
+        }
+        return result;
+    }
+
+    // m * (x, y, 1), the point part of a 2d transform
+    constexpr std::array<float, 2> TransformPoint(const mat3& m, float x, float y) noexcept
+    {
+        return { m[0] * x + m[3] * y + m[6], m[1] * x + m[4] * y + m[7] };
+    }
+
+    // inverse of a 2d transform whose last row is 0 0 1 (everything built from the functions above)
+    constexpr mat3 AffineInverse(const mat3& m) noexcept
+    {
+        const float inverse_determinant = 1.0f / (m[0] * m[4] - m[3] * m[1]);
+        const float i00                 = m[4] * inverse_determinant;
+        const float i10                 = -m[1] * inverse_determinant;
+        const float i01                 = -m[3] * inverse_determinant;
+        const float i11                 = m[0] * inverse_determinant;
+        return mat3{ i00, i10, 0.0f, i01, i11, 0.0f, -(i00 * m[6] + i01 * m[7]), -(i10 * m[6] + i11 * m[7]), 1.0f };
+    }
+
+    // pixels (origin at the center of the window) -> NDC
+    // 2/w 0 0
+    // 0 2/h 0
+    // 0  0  1
+    constexpr mat3 ToNDCMatrix(int width, int height) noexcept
+    {
+        return ScaleMatrix(2.0f / static_cast<float>(width), 2.0f / static_cast<float>(height));
+    }
+}
@@ -0,0 +1,62 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "Mesh.hpp"
+
+#include "FrameCapture.hpp"
+#include "GLState.hpp"
+#include <gsl/gsl>
+
+namespace
+{
+    [[nodiscard]] OpenGL::Mesh upload(std::span<const std::byte> vertex_bytes, std::span<const std::byte> index_bytes, OpenGL::VertexFormat format, GLenum index_type, GLsizei index_count)
+    {
+        using namespace OpenGL;
+        Mesh mesh;
+        mesh.Format      = format;
+        mesh.IndexType   = index_type;
+        mesh.IndexCount  = index_count;
+        mesh.VertexBytes = vertex_bytes.size();
+        mesh.IndexBytes  = index_bytes.size();
+
+        // may be recycled buffers a bit bigger than asked for, the draws only read what we wrote
+        mesh.VertexBuffer = CreateBuffer(GL_ARRAY_BUFFER, vertex_bytes.size(), vertex_bytes.data());
+        mesh.IndexBuffer  = CreateBuffer(GL_ELEMENT_ARRAY_BUFFER, index_bytes.size(), index_bytes.data());
+
+        mesh.VertexArray = CreateVertexArray();
+        BindVertexArray(mesh.VertexArray.Get());
+        BindBuffer(GL_ARRAY_BUFFER, mesh.VertexBuffer.Get());
+        BindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.IndexBuffer.Get());
+        DescribeVertexLayout(GetVertexLayout(format));
+        return mesh;
+    }
+}
+
+namespace OpenGL
+{
+    Mesh CreateMesh(std::span<const Vertex> vertices, std::span<const std::uint32_t> indices, VertexFormat format)
+    {
+        const auto index_type = ChooseIndexType(vertices.size());
+        return upload(EncodeVertices(vertices, format), EncodeIndices(indices, index_type), format, index_type, gsl::narrow<GLsizei>(indices.size()));
+    }
+
+    Mesh CreateMesh(const MeshAsset& asset)
+    {
+        return upload(asset.Vertices, asset.Indices, asset.GetFormat(), asset.Header.IndexType, gsl::narrow<GLsizei>(asset.Header.IndexCount));
+    }
+
+    void DestroyMesh(Mesh& mesh)
+    {
+        mesh = Mesh{};
+    }
+
+    void DrawMesh(const Mesh& mesh)
+    {
+        BindVertexArray(mesh.VertexArray.Get());
+        DrawElements(GL_TRIANGLES, mesh.IndexCount, mesh.IndexType, 0);
+    }
+}
@@ -0,0 +1,42 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include "GpuResources.hpp"
+#include "MeshFile.hpp"
+#include "Vertex.hpp"
+#include "VertexLayout.hpp"
+#include <GL/glew.h>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace OpenGL
+{
+    // a static indexed model : vertex buffer, index buffer and the VAO that describes them.
+    // Move only, the gl objects go back to the pool (GpuResources.hpp) with it
+    struct [[nodiscard]] Mesh
+    {
+        BufferHandle      VertexBuffer{};
+        BufferHandle      IndexBuffer{};
+        VertexArrayHandle VertexArray{};
+        GLsizei           IndexCount  = 0;
+        GLenum            IndexType   = GL_UNSIGNED_SHORT; // picked from the vertex count by ChooseIndexType()
+        VertexFormat      Format      = VertexFormat::Float;
+        std::size_t       VertexBytes = 0;
+        std::size_t       IndexBytes  = 0;
+    };
+
+    // vertices are written as Vertex and encoded into format on the way to the gpu
+    Mesh CreateMesh(std::span<const Vertex> vertices, std::span<const std::uint32_t> indices, VertexFormat format = VertexFormat::Float);
+    // the blobs are already encoded, they go from the mapped file straight to glBufferData
+    Mesh CreateMesh(const MeshAsset& asset);
+    void DestroyMesh(Mesh& mesh);
+    // binds the VAO and draws every index
+    void DrawMesh(const Mesh& mesh);
+}
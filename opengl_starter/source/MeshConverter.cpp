@@ -0,0 +1,77 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+
+// cs200_meshc : offline converter from text meshes (.obj / .json, see MeshImport.hpp) to the binary .mesh
+// files the app maps and uploads as they are (see MeshFile.hpp). Each input gets a .mesh next to it.
+//
+// cs200_meshc [--format float|packed|half|short] input.obj [input.json ...]
+
+#include "MeshFile.hpp"
+#include "MeshImport.hpp"
+#include "VertexLayout.hpp"
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+int main(int argc, char* argv[])
+{
+    auto                               format = OpenGL::VertexFormat::PackedColor;
+    std::vector<std::filesystem::path> inputs;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string_view arg = argv[i];
+        if (arg == "--format" && i + 1 < argc)
+        {
+            const auto picked = OpenGL::VertexFormatFromString(argv[++i]);
+            if (!picked)
+            {
+                std::cout << "--format wants float, packed, half or short\n";
+                return 1;
+            }
+            format = *picked;
+        }
+        else
+        {
+            inputs.emplace_back(arg);
+        }
+    }
+    if (inputs.empty())
+    {
+        std::cout << "cs200_meshc [--format float|packed|half|short] input.obj [input.json ...]\n";
+        return 1;
+    }
+
+    try
+    {
+        for (const auto& input : inputs)
+        {
+            const auto mesh = OpenGL::ImportMesh(input);
+            if (format == OpenGL::VertexFormat::ShortPosition &&
+                std::any_of(mesh.Vertices.begin(), mesh.Vertices.end(), [](const OpenGL::Vertex& v) { return std::abs(v.x) > 1.0f || std::abs(v.y) > 1.0f; }))
+            {
+                throw std::runtime_error(input.string() + " : short positions have to be inside [-1,1], use half or packed");
+            }
+
+            auto output = input;
+            output.replace_extension(".mesh");
+            OpenGL::WriteMeshFile(output, mesh.Vertices, mesh.Indices, format);
+            std::cout << input.string() << " -> " << output.string() << " : " << mesh.Vertices.size() << " vertices (" << OpenGL::ToString(format) << "), " << mesh.Indices.size()
+                      << " indices (" << (OpenGL::ChooseIndexType(mesh.Vertices.size()) == GL_UNSIGNED_SHORT ? 16 : 32) << " bit), " << std::filesystem::file_size(output) << " bytes\n";
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cout << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
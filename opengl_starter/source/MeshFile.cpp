@@ -0,0 +1,115 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "MeshFile.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <gsl/gsl>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+    static_assert(std::endian::native == std::endian::little, ".mesh files are little endian");
+
+    [[nodiscard]] std::uint64_t align_up(std::uint64_t offset) noexcept
+    {
+        return (offset + OpenGL::MeshFileAlignment - 1) / OpenGL::MeshFileAlignment * OpenGL::MeshFileAlignment;
+    }
+
+    [[nodiscard]] bool fits(std::uint64_t offset, std::uint64_t bytes, std::size_t file_size) noexcept
+    {
+        return offset <= file_size && bytes <= file_size - offset;
+    }
+
+    // an index past the last vertex would have the gpu read outside the vertex buffer
+    template <typename Index>
+    [[nodiscard]] bool indices_in_range(std::span<const std::byte> bytes, std::uint32_t vertex_count) noexcept
+    {
+        Index largest = 0;
+        for (std::size_t offset = 0; offset < bytes.size(); offset += sizeof(Index))
+        {
+            Index index = 0;
+            std::memcpy(&index, bytes.data() + offset, sizeof(Index));
+            largest = std::max(largest, index);
+        }
+        return bytes.empty() || largest < vertex_count;
+    }
+}
+
+namespace OpenGL
+{
+    MeshAsset LoadMeshFile(const std::filesystem::path& file_path)
+    {
+        MeshAsset  asset{ MappedFile{ file_path } };
+        const auto bytes = asset.File.GetBytes();
+        const auto bad   = [&file_path](const char* why) { return std::runtime_error(file_path.string() + " : " + why); };
+        if (bytes.size() < sizeof(MeshFileHeader))
+        {
+            throw bad("too small to be a .mesh");
+        }
+        std::memcpy(&asset.Header, bytes.data(), sizeof(MeshFileHeader));
+
+        const MeshFileHeader expected{};
+        const auto&          header = asset.Header;
+        if (!std::equal(std::begin(header.Magic), std::end(header.Magic), std::begin(expected.Magic)) || header.Version != expected.Version)
+        {
+            throw bad("not a .mesh file, or an older version (run cs200_meshc again)");
+        }
+        if (header.Format > static_cast<std::uint32_t>(VertexFormat::ShortPosition) || (header.IndexType != GL_UNSIGNED_SHORT && header.IndexType != GL_UNSIGNED_INT))
+        {
+            throw bad("unknown vertex format or index type");
+        }
+        const auto stride = static_cast<std::uint64_t>(GetVertexLayout(asset.GetFormat()).Stride);
+        if (header.VertexBytes != header.VertexCount * stride || header.IndexBytes != header.IndexCount * IndexSize(header.IndexType) ||
+            !fits(header.VertexOffset, header.VertexBytes, bytes.size()) || !fits(header.IndexOffset, header.IndexBytes, bytes.size()))
+        {
+            throw bad("blob sizes don't match the header, the file is cut short or damaged");
+        }
+
+        asset.Vertices = bytes.subspan(gsl::narrow<std::size_t>(header.VertexOffset), gsl::narrow<std::size_t>(header.VertexBytes));
+        asset.Indices  = bytes.subspan(gsl::narrow<std::size_t>(header.IndexOffset), gsl::narrow<std::size_t>(header.IndexBytes));
+        const bool in_range = (header.IndexType == GL_UNSIGNED_SHORT) ? indices_in_range<std::uint16_t>(asset.Indices, header.VertexCount)
+                                                                      : indices_in_range<std::uint32_t>(asset.Indices, header.VertexCount);
+        if (!in_range)
+        {
+            throw bad("an index points past the last vertex");
+        }
+        return asset;
+    }
+
+    void WriteMeshFile(const std::filesystem::path& file_path, std::span<const Vertex> vertices, std::span<const std::uint32_t> indices, VertexFormat format)
+    {
+        MeshFileHeader header{};
+        header.Format      = static_cast<std::uint32_t>(format);
+        header.IndexType   = ChooseIndexType(vertices.size());
+        header.VertexCount = gsl::narrow<std::uint32_t>(vertices.size());
+        header.IndexCount  = gsl::narrow<std::uint32_t>(indices.size());
+
+        const auto vertex_bytes = EncodeVertices(vertices, format);
+        const auto index_bytes  = EncodeIndices(indices, header.IndexType);
+        header.VertexOffset     = align_up(sizeof(MeshFileHeader));
+        header.VertexBytes      = vertex_bytes.size();
+        header.IndexOffset      = align_up(header.VertexOffset + header.VertexBytes);
+        header.IndexBytes       = index_bytes.size();
+
+        std::vector<std::byte> file(gsl::narrow<std::size_t>(header.IndexOffset + header.IndexBytes));
+        std::memcpy(file.data(), &header, sizeof(header));
+        std::copy(vertex_bytes.begin(), vertex_bytes.end(), file.begin() + gsl::narrow<std::ptrdiff_t>(header.VertexOffset));
+        std::copy(index_bytes.begin(), index_bytes.end(), file.begin() + gsl::narrow<std::ptrdiff_t>(header.IndexOffset));
+
+        std::ofstream ofs(file_path, std::ios::out | std::ios::binary | std::ios::trunc);
+        ofs.write(reinterpret_cast<const char*>(file.data()), gsl::narrow<std::streamsize>(file.size()));
+        if (!ofs)
+        {
+            throw std::runtime_error("Cannot write " + file_path.string());
+        }
+    }
+}
@@ -0,0 +1,60 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include "MappedFile.hpp"
+#include "Vertex.hpp"
+#include "VertexLayout.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+namespace OpenGL
+{
+    // .mesh : a header, then the vertex blob already in its VertexFormat, then the index blob already
+    // in its index type. Both start on a MeshFileAlignment boundary so once the file is mapped they go
+    // to glBufferData as they are, no parsing, no copy. Little endian, like every platform we build for.
+    constexpr std::size_t MeshFileAlignment = 64;
+
+    struct MeshFileHeader
+    {
+        char          Magic[4]     = { 'C', 'S', '2', 'M' };
+        std::uint32_t Version      = 1;
+        std::uint32_t Format       = 0; // VertexFormat
+        std::uint32_t IndexType    = 0; // GL_UNSIGNED_SHORT or GL_UNSIGNED_INT, picked by ChooseIndexType()
+        std::uint32_t VertexCount  = 0;
+        std::uint32_t IndexCount   = 0;
+        std::uint64_t VertexOffset = 0; // from the start of the file
+        std::uint64_t VertexBytes  = 0;
+        std::uint64_t IndexOffset  = 0;
+        std::uint64_t IndexBytes   = 0;
+        std::uint32_t Reserved[2]  = {};
+    };
+
+    static_assert(sizeof(MeshFileHeader) == MeshFileAlignment);
+
+    // a loaded .mesh, Vertices and Indices point into File
+    struct [[nodiscard]] MeshAsset
+    {
+        MappedFile                 File;
+        MeshFileHeader             Header{};
+        std::span<const std::byte> Vertices{};
+        std::span<const std::byte> Indices{};
+
+        [[nodiscard]] VertexFormat GetFormat() const noexcept
+        {
+            return static_cast<VertexFormat>(Header.Format);
+        }
+    };
+
+    // throws std::runtime_error if the file is missing, not a .mesh, cut short or has an index past the last vertex
+    MeshAsset LoadMeshFile(const std::filesystem::path& file_path);
+    // encodes the vertices into format and picks the index type, throws if the file can't be written
+    void WriteMeshFile(const std::filesystem::path& file_path, std::span<const Vertex> vertices, std::span<const std::uint32_t> indices, VertexFormat format);
+}
@@ -0,0 +1,365 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "MeshImport.hpp"
+
+#include "FileLoader.hpp"
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <gsl/gsl>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+    [[nodiscard]] bool is_space(char c) noexcept
+    {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+    [[nodiscard]] std::string_view next_token(std::string_view& line) noexcept
+    {
+        std::size_t start = 0;
+        while (start < line.size() && is_space(line[start]))
+        {
+            ++start;
+        }
+        std::size_t end = start;
+        while (end < line.size() && !is_space(line[end]))
+        {
+            ++end;
+        }
+        const auto token = line.substr(start, end - start);
+        line.remove_prefix(end);
+        return token;
+    }
+
+    // strtod wants a terminated string, tokens are short so copy them
+    [[nodiscard]] bool to_double(std::string_view token, double& value) noexcept
+    {
+        std::array<char, 64> buffer{};
+        if (token.empty() || token.size() >= buffer.size())
+        {
+            return false;
+        }
+        std::copy(token.begin(), token.end(), buffer.begin());
+        char* end = nullptr;
+        value     = std::strtod(buffer.data(), &end);
+        return end == buffer.data() + token.size();
+    }
+
+    [[nodiscard]] bool to_float(std::string_view token, float& value) noexcept
+    {
+        double     number = 0.0;
+        const bool ok     = to_double(token, number);
+        value             = static_cast<float>(number);
+        return ok;
+    }
+
+    // whole token or nothing : "1.7", "12abc" and anything past long long are refused
+    [[nodiscard]] bool to_index(std::string_view token, long long& value) noexcept
+    {
+        const char* const last  = token.data() + token.size();
+        const auto [end, error] = std::from_chars(token.data(), last, value);
+        return error == std::errc{} && end == last;
+    }
+
+    [[nodiscard]] std::runtime_error parse_error(std::string_view format, std::size_t line, std::string_view why)
+    {
+        return std::runtime_error(std::string{ format } + " line " + std::to_string(line) + " : " + std::string{ why });
+    }
+
+    // just enough json for our meshes : objects, arrays, numbers, and strings/true/false/null to skip over
+    class JsonReader
+    {
+    public:
+        explicit JsonReader(std::string_view json_text) : text(json_text)
+        {
+        }
+
+        void Expect(char c)
+        {
+            if (!Accept(c))
+            {
+                throw error(std::string{ "expected '" } + c + "'");
+            }
+        }
+
+        [[nodiscard]] bool Accept(char c)
+        {
+            skip_space();
+            if (position < text.size() && text[position] == c)
+            {
+                ++position;
+                return true;
+            }
+            return false;
+        }
+
+        [[nodiscard]] std::string_view String()
+        {
+            Expect('"');
+            const auto start = position;
+            while (position < text.size() && text[position] != '"')
+            {
+                position += (text[position] == '\\') ? 2u : 1u;
+            }
+            if (position >= text.size())
+            {
+                throw error("string never ends");
+            }
+            return text.substr(start, position++ - start);
+        }
+
+        [[nodiscard]] double Number()
+        {
+            skip_space();
+            const auto start = position;
+            while (position < text.size() && (std::isdigit(static_cast<unsigned char>(text[position])) || std::string_view{ "+-.eE" }.find(text[position]) != std::string_view::npos))
+            {
+                ++position;
+            }
+            double value = 0.0;
+            if (!to_double(text.substr(start, position - start), value))
+            {
+                throw error("expected a number");
+            }
+            return value;
+        }
+
+        // every number inside the value, however deep the arrays go
+        void Numbers(std::vector<double>& numbers)
+        {
+            if (!Accept('['))
+            {
+                numbers.push_back(Number());
+                return;
+            }
+            if (Accept(']'))
+            {
+                return;
+            }
+            do
+            {
+                Numbers(numbers);
+            } while (Accept(','));
+            Expect(']');
+        }
+
+        void Skip()
+        {
+            skip_space();
+            if (position >= text.size())
+            {
+                throw error("unexpected end");
+            }
+            const char c = text[position];
+            if (c == '"')
+            {
+                (void)String();
+            }
+            else if (c == '[' || c == '{')
+            {
+                const char close = (c == '[') ? ']' : '}';
+                ++position;
+                if (Accept(close))
+                {
+                    return;
+                }
+                do
+                {
+                    if (close == '}')
+                    {
+                        (void)String();
+                        Expect(':');
+                    }
+                    Skip();
+                } while (Accept(','));
+                Expect(close);
+            }
+            else if (std::isalpha(static_cast<unsigned char>(c)))
+            {
+                while (position < text.size() && std::isalpha(static_cast<unsigned char>(text[position])))
+                {
+                    ++position;
+                }
+            }
+            else
+            {
+                (void)Number();
+            }
+        }
+
+        [[nodiscard]] bool AtEnd()
+        {
+            skip_space();
+            return position >= text.size();
+        }
+
+    private:
+        void skip_space() noexcept
+        {
+            while (position < text.size() && is_space(text[position]))
+            {
+                ++position;
+            }
+        }
+
+        [[nodiscard]] std::runtime_error error(std::string_view why) const
+        {
+            const auto line = static_cast<std::size_t>(std::count(text.begin(), text.begin() + gsl::narrow<std::ptrdiff_t>(std::min(position, text.size())), '\n')) + 1;
+            return parse_error("json", line, why);
+        }
+
+    private:
+        std::string_view text;
+        std::size_t      position = 0;
+    };
+}
+
+namespace OpenGL
+{
+    MeshData ParseOBJ(std::string_view text)
+    {
+        MeshData    mesh;
+        std::size_t line_number = 0;
+        while (!text.empty())
+        {
+            const auto line_end = text.find('\n');
+            auto       line     = text.substr(0, line_end);
+            text.remove_prefix(line_end == std::string_view::npos ? text.size() : line_end + 1);
+            ++line_number;
+
+            const auto keyword = next_token(line);
+            if (keyword == "v")
+            {
+                // x y [z] [r g b]
+                std::array<float, 6> values{ 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f };
+                std::size_t          count = 0;
+                for (auto token = next_token(line); !token.empty() && count < values.size(); token = next_token(line))
+                {
+                    if (!to_float(token, values[count++]))
+                    {
+                        throw parse_error("obj", line_number, "bad number in a vertex");
+                    }
+                }
+                if (count < 2)
+                {
+                    throw parse_error("obj", line_number, "a vertex needs at least x and y");
+                }
+                if (count == 5)
+                {
+                    // x y r g b : no z
+                    values = { values[0], values[1], 0.0f, values[2], values[3], values[4] };
+                }
+                mesh.Vertices.push_back(Vertex{ values[0], values[1], values[3], values[4], values[5] });
+            }
+            else if (keyword == "f")
+            {
+                std::vector<std::uint32_t> polygon;
+                for (auto token = next_token(line); !token.empty(); token = next_token(line))
+                {
+                    // a, a/b, a//c, a/b/c : only the position index matters
+                    const auto position = token.substr(0, token.find('/'));
+                    long long  index    = 0;
+                    if (!to_index(position, index) || index == 0)
+                    {
+                        throw parse_error("obj", line_number, "bad face index");
+                    }
+                    const auto count = static_cast<long long>(mesh.Vertices.size());
+                    const auto fixed = (index < 0) ? count + index : index - 1;
+                    if (fixed < 0 || fixed >= count)
+                    {
+                        throw parse_error("obj", line_number, "face index out of range");
+                    }
+                    polygon.push_back(static_cast<std::uint32_t>(fixed));
+                }
+                if (polygon.size() < 3)
+                {
+                    throw parse_error("obj", line_number, "a face needs at least 3 vertices");
+                }
+                for (std::size_t i = 1; i + 1 < polygon.size(); ++i)
+                {
+                    mesh.Indices.insert(mesh.Indices.end(), { polygon[0], polygon[i], polygon[i + 1] });
+                }
+            }
+        }
+        return mesh;
+    }
+
+    MeshData ParseMeshJSON(std::string_view text)
+    {
+        JsonReader          json{ text };
+        std::vector<double> vertex_numbers;
+        std::vector<double> index_numbers;
+        json.Expect('{');
+        if (!json.Accept('}'))
+        {
+            do
+            {
+                const auto key = json.String();
+                json.Expect(':');
+                if (key == "vertices")
+                {
+                    json.Numbers(vertex_numbers);
+                }
+                else if (key == "indices")
+                {
+                    json.Numbers(index_numbers);
+                }
+                else
+                {
+                    json.Skip();
+                }
+            } while (json.Accept(','));
+            json.Expect('}');
+        }
+        if (!json.AtEnd())
+        {
+            throw parse_error("json", 0, "trailing characters after the mesh");
+        }
+        if (vertex_numbers.size() % 5 != 0)
+        {
+            throw parse_error("json", 0, "vertices need 5 numbers each : x, y, r, g, b");
+        }
+
+        MeshData mesh;
+        for (std::size_t i = 0; i < vertex_numbers.size(); i += 5)
+        {
+            mesh.Vertices.push_back(Vertex{ static_cast<float>(vertex_numbers[i]), static_cast<float>(vertex_numbers[i + 1]), static_cast<float>(vertex_numbers[i + 2]),
+                                            static_cast<float>(vertex_numbers[i + 3]), static_cast<float>(vertex_numbers[i + 4]) });
+        }
+        for (const double index : index_numbers)
+        {
+            if (index < 0.0 || index >= static_cast<double>(mesh.Vertices.size()) || index != std::floor(index))
+            {
+                throw parse_error("json", 0, "index " + std::to_string(index) + " doesn't name a vertex");
+            }
+            mesh.Indices.push_back(static_cast<std::uint32_t>(index));
+        }
+        return mesh;
+    }
+
+    MeshData ImportMesh(const std::filesystem::path& file_path)
+    {
+        const std::string text      = ReadTextFile(file_path);
+        const auto        extension = file_path.extension();
+        if (extension == ".obj")
+        {
+            return ParseOBJ(text);
+        }
+        if (extension == ".json")
+        {
+            return ParseMeshJSON(text);
+        }
+        throw std::runtime_error(file_path.string() + " : only .obj and .json meshes can be imported");
+    }
+}
@@ -0,0 +1,37 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include "Vertex.hpp"
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+#include <vector>
+
+namespace OpenGL
+{
+    // text mesh formats, what cs200_meshc turns into .mesh files
+    struct MeshData
+    {
+        std::vector<Vertex>        Vertices;
+        std::vector<std::uint32_t> Indices;
+    };
+
+    // Wavefront OBJ, only what a 2d mesh needs :
+    //   v x y [z] [r g b]   z is ignored, color defaults to white (the common "vertex color" extension)
+    //   f a b c ...         1 based or negative, a/b/c forms are fine, polygons become triangle fans
+    // everything else (vt, vn, o, g, usemtl...) is skipped
+    [[nodiscard]] MeshData ParseOBJ(std::string_view text);
+
+    // { "vertices": [ [x, y, r, g, b], ... ], "indices": [ 0, 1, 2, ... ] }
+    // the inner arrays are optional, a flat list of 5 numbers per vertex works too. Other keys are skipped
+    [[nodiscard]] MeshData ParseMeshJSON(std::string_view text);
+
+    // by extension (.obj or .json), throws std::runtime_error if it can't be read or parsed
+    [[nodiscard]] MeshData ImportMesh(const std::filesystem::path& file_path);
+}
@@ -0,0 +1,380 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "Profiler.hpp"
+
+#include <GL/glew.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <gsl/gsl>
+#include <imgui.h>
+#include <iomanip>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+    using clock = std::chrono::steady_clock;
+    using Profiling::FrameProfile;
+
+    constexpr std::size_t no_query = static_cast<std::size_t>(-1);
+
+    // a recorded frame until its timestamps are back
+    struct PendingFrame
+    {
+        FrameProfile             Profile{};
+        std::vector<GLuint>      Queries{};        // begin, end for every gpu scope. Kept between frames, only ever grows
+        std::vector<std::size_t> QueryScopes{};    // which scope each begin / end pair belongs to
+        double                   GpuToCpuMs = 0.0; // add to a gpu timestamp in ms to land on the cpu clock
+        bool                     Recorded   = false;
+    };
+
+    struct OpenScope
+    {
+        std::size_t Scope     = no_query; // no_query when it started outside a frame
+        std::size_t QueryPair = no_query;
+    };
+
+    struct Profiler
+    {
+        clock::time_point                                  Start = clock::now();
+        std::array<PendingFrame, Profiling::QueryLatency>  Pending{};
+        std::size_t                                        Current   = 0;
+        std::uint64_t                                      NextIndex = 0;
+        bool                                               InFrame   = false;
+        int                                                GpuTimer  = -1; // -1 : not asked yet, glewInit has to run first
+        std::vector<OpenScope>                             Open{};
+        std::array<FrameProfile, Profiling::HistoryFrames> History{};
+        std::size_t                                        HistoryNext  = 0;
+        std::size_t                                        HistoryCount = 0;
+    };
+
+    Profiler gProfiler;
+
+    [[nodiscard]] double now_ms() noexcept
+    {
+        return std::chrono::duration<double, std::milli>(clock::now() - gProfiler.Start).count();
+    }
+
+    // the timestamps of a frame that is QueryLatency frames old, into the history
+    void retire(PendingFrame& frame)
+    {
+#if !defined(__EMSCRIPTEN__)
+        bool available = true;
+        for (std::size_t i = 0; i < frame.QueryScopes.size() * 2 && available; ++i)
+        {
+            GLint ready = GL_FALSE;
+            glGetQueryObjectiv(frame.Queries[i], GL_QUERY_RESULT_AVAILABLE, &ready);
+            available = ready == GL_TRUE;
+        }
+        // still not there (gpu way behind) : the frame keeps its cpu times only, better than a stall
+        for (std::size_t pair = 0; pair < frame.QueryScopes.size() && available; ++pair)
+        {
+            GLuint64 begin = 0;
+            GLuint64 end   = 0;
+            glGetQueryObjectui64v(frame.Queries[pair * 2], GL_QUERY_RESULT, &begin);
+            glGetQueryObjectui64v(frame.Queries[pair * 2 + 1], GL_QUERY_RESULT, &end);
+            auto& scope      = frame.Profile.Scopes[frame.QueryScopes[pair]];
+            scope.GpuStartMs = static_cast<double>(begin) / 1'000'000.0 + frame.GpuToCpuMs;
+            scope.GpuMs      = static_cast<double>(end - begin) / 1'000'000.0;
+        }
+#endif
+        // copy assignment reuses the old frame's scope vector, no allocation once the history went around
+        gProfiler.History[gProfiler.HistoryNext] = frame.Profile;
+        gProfiler.HistoryNext                    = (gProfiler.HistoryNext + 1) % Profiling::HistoryFrames;
+        gProfiler.HistoryCount                   = std::min(gProfiler.HistoryCount + 1, Profiling::HistoryFrames);
+        frame.Recorded                           = false;
+    }
+
+    [[nodiscard]] std::string json_escaped(std::string_view text)
+    {
+        std::string escaped;
+        for (const char c : text)
+        {
+            if (c == '"' || c == '\\')
+            {
+                escaped += '\\';
+            }
+            escaped += c;
+        }
+        return escaped;
+    }
+
+    void write_trace_event(std::ostream& out, std::string_view name, int thread, double start_ms, double duration_ms)
+    {
+        // trace_event times are microseconds
+        out << ",\n{\"name\":\"" << json_escaped(name) << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread << ",\"ts\":" << start_ms * 1000.0 << ",\"dur\":" << duration_ms * 1000.0
+            << '}';
+    }
+}
+
+namespace Profiling
+{
+    void BeginFrame()
+    {
+        auto& frame = gProfiler.Pending[gProfiler.Current];
+        if (frame.Recorded)
+        {
+            retire(frame);
+        }
+        frame.Profile.Index   = gProfiler.NextIndex++;
+        frame.Profile.StartMs = now_ms();
+        frame.Profile.CpuMs   = 0.0;
+        frame.Profile.Scopes.clear();
+        frame.QueryScopes.clear();
+#if !defined(__EMSCRIPTEN__)
+        if (HasGpuTimer())
+        {
+            // where the gpu clock is right now, to line its timestamps up with ours
+            GLint64 gpu_now = 0;
+            glGetInteger64v(GL_TIMESTAMP, &gpu_now);
+            frame.GpuToCpuMs = now_ms() - static_cast<double>(gpu_now) / 1'000'000.0;
+        }
+#endif
+        gProfiler.InFrame = true;
+    }
+
+    void EndFrame()
+    {
+        if (!gProfiler.InFrame)
+        {
+            return;
+        }
+        auto& frame         = gProfiler.Pending[gProfiler.Current];
+        frame.Profile.CpuMs = now_ms() - frame.Profile.StartMs;
+        frame.Recorded      = true;
+        gProfiler.InFrame   = false;
+        gProfiler.Current   = (gProfiler.Current + 1) % QueryLatency;
+    }
+
+    void BeginScope(std::string_view name, [[maybe_unused]] bool gpu)
+    {
+        if (!gProfiler.InFrame)
+        {
+            gProfiler.Open.push_back(OpenScope{});
+            return;
+        }
+        auto&     frame = gProfiler.Pending[gProfiler.Current];
+        OpenScope open{ frame.Profile.Scopes.size(), no_query };
+        frame.Profile.Scopes.push_back(ScopeSample{ name, gsl::narrow<int>(gProfiler.Open.size()), now_ms() });
+#if !defined(__EMSCRIPTEN__)
+        if (gpu && HasGpuTimer())
+        {
+            open.QueryPair = frame.QueryScopes.size();
+            frame.QueryScopes.push_back(open.Scope);
+            if (frame.Queries.size() < frame.QueryScopes.size() * 2)
+            {
+                const std::size_t first = frame.Queries.size();
+                frame.Queries.resize(std::max<std::size_t>(16, frame.Queries.size() * 2));
+                glGenQueries(gsl::narrow<GLsizei>(frame.Queries.size() - first), frame.Queries.data() + first);
+            }
+            glQueryCounter(frame.Queries[open.QueryPair * 2], GL_TIMESTAMP);
+        }
+#endif
+        gProfiler.Open.push_back(open);
+    }
+
+    void EndScope()
+    {
+        if (gProfiler.Open.empty())
+        {
+            return;
+        }
+        const auto open = gProfiler.Open.back();
+        gProfiler.Open.pop_back();
+        if (!gProfiler.InFrame || open.Scope == no_query)
+        {
+            return;
+        }
+        auto& frame  = gProfiler.Pending[gProfiler.Current];
+        auto& sample = frame.Profile.Scopes[open.Scope];
+        sample.CpuMs = now_ms() - sample.CpuStartMs;
+#if !defined(__EMSCRIPTEN__)
+        if (open.QueryPair != no_query)
+        {
+            glQueryCounter(frame.Queries[open.QueryPair * 2 + 1], GL_TIMESTAMP);
+        }
+#endif
+    }
+
+    void Shutdown()
+    {
+        for (auto& frame : gProfiler.Pending)
+        {
+            if (frame.Recorded)
+            {
+                retire(frame);
+            }
+            if (!frame.Queries.empty())
+            {
+                glDeleteQueries(gsl::narrow<GLsizei>(frame.Queries.size()), frame.Queries.data());
+                frame.Queries.clear();
+            }
+        }
+        gProfiler.InFrame  = false;
+        gProfiler.GpuTimer = -1; // the next context gets asked again
+        gProfiler.Open.clear();
+    }
+
+    bool HasGpuTimer() noexcept
+    {
+#if defined(__EMSCRIPTEN__)
+        // WebGL2 only has them behind EXT_disjoint_timer_query_webgl2, and browsers mostly hide it
+        return false;
+#else
+        if (gProfiler.GpuTimer < 0)
+        {
+            gProfiler.GpuTimer = GLEW_ARB_timer_query ? 1 : 0; // core since 3.3
+        }
+        return gProfiler.GpuTimer == 1;
+#endif
+    }
+
+    std::vector<FrameProfile> GetHistory()
+    {
+        std::vector<FrameProfile> frames;
+        frames.reserve(gProfiler.HistoryCount);
+        const std::size_t oldest = (gProfiler.HistoryNext + HistoryFrames - gProfiler.HistoryCount) % HistoryFrames;
+        for (std::size_t i = 0; i < gProfiler.HistoryCount; ++i)
+        {
+            frames.push_back(gProfiler.History[(oldest + i) % HistoryFrames]);
+        }
+        return frames;
+    }
+
+    std::vector<ScopeAverage> AverageScopes(std::size_t frame_count)
+    {
+        struct Total
+        {
+            ScopeAverage Average{};
+            int          GpuFrames = 0;
+        };
+
+        std::vector<Total> totals;
+        const std::size_t  count  = std::min(frame_count, gProfiler.HistoryCount);
+        const std::size_t  oldest = (gProfiler.HistoryNext + HistoryFrames - count) % HistoryFrames;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            for (const auto& scope : gProfiler.History[(oldest + i) % HistoryFrames].Scopes)
+            {
+                auto total = std::find_if(totals.begin(), totals.end(), [&scope](const Total& t) { return t.Average.Name == scope.Name && t.Average.Depth == scope.Depth; });
+                if (total == totals.end())
+                {
+                    totals.push_back(Total{ ScopeAverage{ scope.Name, scope.Depth, 0.0, 0.0, 0.0 } });
+                    total = totals.end() - 1;
+                }
+                total->Average.Calls += 1.0;
+                total->Average.CpuMs += scope.CpuMs;
+                if (scope.GpuMs >= 0.0)
+                {
+                    total->Average.GpuMs += scope.GpuMs;
+                    ++total->GpuFrames;
+                }
+            }
+        }
+
+        std::vector<ScopeAverage> averages;
+        averages.reserve(totals.size());
+        for (auto& total : totals)
+        {
+            const double frames = static_cast<double>(std::max<std::size_t>(count, 1));
+            total.Average.Calls /= frames;
+            total.Average.CpuMs /= frames;
+            total.Average.GpuMs = (total.GpuFrames > 0) ? total.Average.GpuMs / static_cast<double>(total.GpuFrames) : -1.0; // only the frames whose query came back
+            averages.push_back(total.Average);
+        }
+        return averages;
+    }
+
+    void WriteChromeTrace(const std::filesystem::path& file_path)
+    {
+        std::ofstream out(file_path);
+        if (!out)
+        {
+            throw std::runtime_error("Cannot open " + file_path.string());
+        }
+        out << std::fixed << std::setprecision(3);
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        out << R"({"name":"thread_name","ph":"M","pid":1,"tid":1,"args":{"name":"cpu"}})";
+        out << ",\n" << R"({"name":"thread_name","ph":"M","pid":1,"tid":2,"args":{"name":"gpu"}})";
+        for (const auto& frame : GetHistory())
+        {
+            write_trace_event(out, "frame " + std::to_string(frame.Index), 1, frame.StartMs, frame.CpuMs);
+            for (const auto& scope : frame.Scopes)
+            {
+                write_trace_event(out, scope.Name, 1, scope.CpuStartMs, scope.CpuMs);
+                if (scope.GpuMs >= 0.0)
+                {
+                    write_trace_event(out, scope.Name, 2, scope.GpuStartMs, scope.GpuMs);
+                }
+            }
+        }
+        out << "\n]}\n";
+    }
+
+    void DrawOverlay(bool* open)
+    {
+        static std::string saved; // what the save button said last
+
+        ImGui::SetNextWindowPos(ImVec2(10.0f, 330.0f), ImGuiCond_FirstUseEver);
+        ImGui::Begin("Profiler (F2)", open, ImGuiWindowFlags_AlwaysAutoResize);
+        if (!HasGpuTimer())
+        {
+            ImGui::TextUnformatted("no timer queries here, cpu times only");
+        }
+        constexpr std::size_t averaged_frames = 60;
+        if (ImGui::BeginTable("scopes", 4, ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit))
+        {
+            ImGui::TableSetupColumn("scope");
+            ImGui::TableSetupColumn("calls");
+            ImGui::TableSetupColumn("cpu ms");
+            ImGui::TableSetupColumn("gpu ms");
+            ImGui::TableHeadersRow();
+            for (const auto& scope : AverageScopes(averaged_frames))
+            {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::Text("%*s%.*s", scope.Depth * 2, "", static_cast<int>(scope.Name.size()), scope.Name.data());
+                ImGui::TableNextColumn();
+                ImGui::Text("%.1f", scope.Calls);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", scope.CpuMs);
+                ImGui::TableNextColumn();
+                if (scope.GpuMs >= 0.0)
+                {
+                    ImGui::Text("%.3f", scope.GpuMs);
+                }
+                else
+                {
+                    ImGui::TextUnformatted("-");
+                }
+            }
+            ImGui::EndTable();
+        }
+        ImGui::Text("averaged over %zu frames", std::min(averaged_frames, gProfiler.HistoryCount));
+        if (ImGui::Button("save trace"))
+        {
+            try
+            {
+                WriteChromeTrace("profile_trace.json");
+                saved = std::to_string(gProfiler.HistoryCount) + " frames in profile_trace.json";
+            }
+            catch (const std::exception& error)
+            {
+                saved = error.what();
+            }
+        }
+        if (!saved.empty())
+        {
+            ImGui::SameLine();
+            ImGui::TextUnformatted(saved.c_str());
+        }
+        ImGui::End();
+    }
+}
@@ -0,0 +1,106 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+#include <vector>
+
+// Where the frame goes, cpu and gpu.
+//
+// PROFILE_SCOPE("name") times the rest of the block on the cpu. PROFILE_GPU_SCOPE("name") also puts a GL_TIMESTAMP
+// query on each end, so the gl work in between gets timed on the gpu. Scopes nest, and the same name at the same depth
+// is added up for the frame. Timestamps are read back QueryLatency frames later, when the gpu is long done with them,
+// so nothing ever waits on a query.
+// Without DEVELOPER_VERSION the macros are empty : no clock reads, no queries, nothing recorded.
+// gl thread only, like the state cache.
+namespace Profiling
+{
+    constexpr std::size_t QueryLatency  = 3;
+    constexpr std::size_t HistoryFrames = 600; // what the overlay averages and the trace holds, 10 s at 60 fps
+
+    struct ScopeSample
+    {
+        std::string_view Name; // has to outlive the profiler, string literals are fine
+        int              Depth      = 0;
+        double           CpuStartMs = 0.0; // since the profiler started
+        double           CpuMs      = 0.0;
+        double           GpuStartMs = 0.0; // moved onto the cpu clock, so both line up in a trace
+        double           GpuMs      = -1.0; // -1 : cpu only scope, no timer queries, or the results never came
+    };
+
+    struct FrameProfile
+    {
+        std::uint64_t            Index   = 0;
+        double                   StartMs = 0.0;
+        double                   CpuMs   = 0.0; // BeginFrame() to EndFrame()
+        std::vector<ScopeSample> Scopes{};      // in the order they started
+    };
+
+    // one name at one depth, per frame on average
+    struct ScopeAverage
+    {
+        std::string_view Name;
+        int              Depth = 0;
+        double           Calls = 0.0;
+        double           CpuMs = 0.0;
+        double           GpuMs = -1.0;
+    };
+
+    void BeginFrame();
+    void EndFrame();
+    // use the macros, they go away in release builds
+    void BeginScope(std::string_view name, bool gpu);
+    void EndScope();
+    // before the context goes away, deletes the queries
+    void Shutdown();
+
+    [[nodiscard]] bool HasGpuTimer() noexcept;
+    // frames with every result read back, oldest first
+    [[nodiscard]] std::vector<FrameProfile> GetHistory();
+    // over the newest frame_count frames of the history, in the order the scopes first show up
+    [[nodiscard]] std::vector<ScopeAverage> AverageScopes(std::size_t frame_count);
+
+    // the history as Chrome trace_event json (chrome://tracing, ui.perfetto.dev), cpu and gpu on their own rows
+    void WriteChromeTrace(const std::filesystem::path& file_path);
+    // ImGui window with the averages and a button that saves a trace
+    void DrawOverlay(bool* open);
+
+    class Scope
+    {
+    public:
+        Scope(std::string_view name, bool gpu)
+        {
+            BeginScope(name, gpu);
+        }
+
+        ~Scope()
+        {
+            EndScope();
+        }
+
+        Scope(const Scope&)            = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+}
+
+#if defined(DEVELOPER_VERSION)
+#    define PROFILE_CONCAT_INNER(a, b) a##b
+#    define PROFILE_CONCAT(a, b)       PROFILE_CONCAT_INNER(a, b)
+#    define PROFILE_SCOPE(name)        const Profiling::Scope PROFILE_CONCAT(profile_scope_, __LINE__)(name, false)
+#    define PROFILE_GPU_SCOPE(name)    const Profiling::Scope PROFILE_CONCAT(profile_scope_, __LINE__)(name, true)
+#    define PROFILE_BEGIN_FRAME()      Profiling::BeginFrame()
+#    define PROFILE_END_FRAME()        Profiling::EndFrame()
+#else
+#    define PROFILE_SCOPE(name)        static_cast<void>(0)
+#    define PROFILE_GPU_SCOPE(name)    static_cast<void>(0)
+#    define PROFILE_BEGIN_FRAME()      static_cast<void>(0)
+#    define PROFILE_END_FRAME()        static_cast<void>(0)
+#endif
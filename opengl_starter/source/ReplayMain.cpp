@@ -0,0 +1,326 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+
+// cs200_replay : plays a capture (cs200_fun / cs200_bench --capture file) into an offscreen framebuffer and
+// reports cpu / gpu / frame times per frame with percentiles, like cs200_bench but without the app in the way.
+// The same file replayed on two builds or two drivers draws exactly the same thing, so the numbers can be compared.
+//
+// cs200_replay file [--repeat N] [--per-draw] [--slowest N] [--csv file]
+// cs200_replay file --list : what is in the file, no context needed
+//
+// --repeat N   : play every frame N times (default 3), setup is played again before each pass
+// --per-draw   : time each draw with timestamp queries and print the slowest ones. It waits for the gpu every frame
+// --slowest N  : how many of the slowest draws to print (default 10)
+// --csv file   : one line per frame and pass
+//
+// The framebuffer is hashed after each pass, passes that don't end on the same image are reported.
+
+#include "CaptureReplay.hpp"
+#include "Hash.hpp"
+#include "HeadlessContext.hpp"
+#include <GL/glew.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+    // as in cs200_bench : results of frame N are read at frame N + QueryLatency, so reading doesn't stall
+    constexpr std::size_t QueryLatency = 4;
+
+    struct FrameSample
+    {
+        std::size_t Frame   = 0;
+        int         Pass    = 0;
+        double      CpuMs   = 0.0; // inside PlayFrame()
+        double      GpuMs   = 0.0; // GL_TIME_ELAPSED around PlayFrame()
+        double      FrameMs = 0.0; // start of this frame to start of the next
+    };
+
+    // nearest rank
+    [[nodiscard]] double percentile(const std::vector<double>& sorted, double percent)
+    {
+        const auto rank = static_cast<std::size_t>(std::ceil(percent / 100.0 * static_cast<double>(sorted.size())));
+        return sorted[std::clamp(rank, std::size_t{ 1 }, sorted.size()) - 1];
+    }
+
+    void print_summary(std::string_view name, const std::vector<FrameSample>& samples, double FrameSample::*field)
+    {
+        std::vector<double> values;
+        values.reserve(samples.size());
+        double total = 0.0;
+        for (const auto& sample : samples)
+        {
+            values.push_back(sample.*field);
+            total += sample.*field;
+        }
+        if (values.empty())
+        {
+            return;
+        }
+        std::sort(values.begin(), values.end());
+        std::cout << name << " ms | mean: " << total / static_cast<double>(values.size()) << " p50: " << percentile(values, 50.0) << " p95: " << percentile(values, 95.0)
+                  << " p99: " << percentile(values, 99.0) << " max: " << values.back() << '\n';
+    }
+
+    [[nodiscard]] std::string describe_input(const OpenGL::InputEvent& event)
+    {
+        // SDL_Event::type, the replay doesn't pull SDL in for three constants
+        switch (event.Type)
+        {
+            case 0x100: return "quit";
+            case 0x200: return "window event " + std::to_string(event.Code) + " (" + std::to_string(event.X) + ", " + std::to_string(event.Y) + ')';
+            case 0x300: return "key " + std::to_string(event.Code);
+            default: return "event " + std::to_string(event.Type);
+        }
+    }
+
+    void list(const OpenGL::CaptureReplay& replay)
+    {
+        const auto& frames = replay.GetFrames();
+        for (std::size_t i = 0; i < frames.size(); ++i)
+        {
+            const auto& frame = frames[i];
+            std::cout << "frame " << i << " | " << frame.Width << 'x' << frame.Height << " | draws: " << frame.Draws << " | " << (frame.End - frame.First) / 1024 << " KB";
+            for (const auto& input : frame.Inputs)
+            {
+                std::cout << " | " << describe_input(input);
+            }
+            std::cout << '\n';
+        }
+        const auto& counts = replay.GetRecordCounts();
+        for (std::size_t op = 0; op < counts.size(); ++op)
+        {
+            if (counts[op] > 0)
+            {
+                std::cout << std::setw(24) << OpenGL::CaptureOpName(static_cast<OpenGL::CaptureOp>(op)) << " : " << counts[op] << '\n';
+            }
+        }
+    }
+
+    [[nodiscard]] bool slower(const OpenGL::CaptureReplay::DrawTiming& a, const OpenGL::CaptureReplay::DrawTiming& b) noexcept
+    {
+        return a.GpuMs > b.GpuMs;
+    }
+
+    // every draw of every frame of every pass adds up, only the ones that can still make the list are kept
+    void keep_slowest(std::vector<OpenGL::CaptureReplay::DrawTiming>& draws, std::size_t count)
+    {
+        if (draws.size() <= count)
+        {
+            return;
+        }
+        const auto last = draws.begin() + static_cast<std::ptrdiff_t>(count);
+        std::nth_element(draws.begin(), last, draws.end(), slower);
+        draws.erase(last, draws.end());
+    }
+
+    // what ended up in the framebuffer, to tell if two passes drew the same thing
+    [[nodiscard]] std::uint64_t framebuffer_hash(int width, int height)
+    {
+        std::vector<char> pixels(static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 4);
+        glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+        return Hash::FNV1a(std::string_view{ pixels.data(), pixels.size() });
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        std::cout << "cs200_replay file [--repeat N] [--per-draw] [--slowest N] [--csv file] [--list]\n";
+        return 1;
+    }
+    const std::string path      = argv[1];
+    int               passes    = 3;
+    bool              per_draw  = false;
+    bool              list_only = false;
+    std::size_t       slowest   = 10;
+    std::string       csv_path;
+    for (int i = 2; i < argc; ++i)
+    {
+        const std::string_view arg = argv[i];
+        if (arg == "--repeat" && i + 1 < argc)
+        {
+            passes = std::max(1, std::stoi(argv[++i]));
+        }
+        else if (arg == "--per-draw")
+        {
+            per_draw = true;
+        }
+        else if (arg == "--slowest" && i + 1 < argc)
+        {
+            slowest = static_cast<std::size_t>(std::max(0, std::stoi(argv[++i])));
+        }
+        else if (arg == "--csv" && i + 1 < argc)
+        {
+            csv_path = argv[++i];
+        }
+        else if (arg == "--list")
+        {
+            list_only = true;
+        }
+        else
+        {
+            std::cout << "unknown option " << arg << '\n';
+            return 1;
+        }
+    }
+
+    try
+    {
+        OpenGL::CaptureReplay replay(path);
+        const auto&           frames = replay.GetFrames();
+        std::cout << path << " : " << frames.size() << " frames, " << static_cast<double>(replay.GetFileSize()) / (1024.0 * 1024.0) << " MB\n";
+        if (list_only)
+        {
+            list(replay);
+            return 0;
+        }
+        if (frames.empty())
+        {
+            std::cout << "nothing to play\n";
+            return 1;
+        }
+
+        const int               width  = replay.GetMaxWidth();
+        const int               height = replay.GetMaxHeight();
+        OpenGL::HeadlessContext context(width, height);
+        std::cout << context.Describe() << '\n';
+
+        const bool                       has_gpu_timer = GLEW_ARB_timer_query;
+        std::array<GLuint, QueryLatency> queries{};
+        std::vector<FrameSample>         samples;
+        samples.reserve(frames.size() * static_cast<std::size_t>(passes));
+        if (has_gpu_timer)
+        {
+            glGenQueries(static_cast<GLsizei>(queries.size()), queries.data());
+            // llvmpipe answers the first elapsed time query of a context with a timestamp, unless something was drawn before
+            glBeginQuery(GL_TIME_ELAPSED, queries[0]);
+            glClear(GL_COLOR_BUFFER_BIT);
+            glEndQuery(GL_TIME_ELAPSED);
+            glFinish();
+        }
+        const auto read_gpu_time = [&](std::size_t sample)
+        {
+            GLuint64 nanoseconds = 0;
+            glGetQueryObjectui64v(queries[sample % QueryLatency], GL_QUERY_RESULT, &nanoseconds);
+            samples[sample].GpuMs = static_cast<double>(nanoseconds) / 1'000'000.0;
+        };
+
+        using clock = std::chrono::steady_clock;
+        using ms    = std::chrono::duration<double, std::milli>;
+        std::vector<OpenGL::CaptureReplay::DrawTiming> draws;
+        std::uint64_t                                  first_hash = 0;
+        for (int pass = 0; pass < passes; ++pass)
+        {
+            replay.Restart();
+            glFinish(); // setup isn't timed
+            auto frame_start = clock::now();
+            for (std::size_t frame = 0; frame < frames.size(); ++frame)
+            {
+                const std::size_t sample = samples.size();
+                samples.push_back(FrameSample{ frame, pass, 0.0, 0.0, 0.0 });
+                if (has_gpu_timer)
+                {
+                    if (sample >= QueryLatency)
+                    {
+                        read_gpu_time(sample - QueryLatency);
+                    }
+                    glBeginQuery(GL_TIME_ELAPSED, queries[sample % QueryLatency]);
+                }
+                const auto cpu_start = clock::now();
+                replay.PlayFrame(frame, per_draw ? &draws : nullptr);
+                samples[sample].CpuMs = ms(clock::now() - cpu_start).count();
+                keep_slowest(draws, slowest);
+                if (has_gpu_timer)
+                {
+                    glEndQuery(GL_TIME_ELAPSED);
+                }
+                glFlush();
+
+                const auto next_start   = clock::now();
+                samples[sample].FrameMs = ms(next_start - frame_start).count();
+                frame_start             = next_start;
+            }
+
+            const auto hash = framebuffer_hash(width, height);
+            std::cout << "pass " << pass << " : last frame " << std::hex << hash << std::dec << '\n';
+            if (pass == 0)
+            {
+                first_hash = hash;
+            }
+            else if (hash != first_hash)
+            {
+                std::cout << "pass " << pass << " didn't draw the same last frame as pass 0\n";
+            }
+        }
+        if (has_gpu_timer)
+        {
+            for (std::size_t sample = samples.size() - std::min(samples.size(), QueryLatency); sample < samples.size(); ++sample)
+            {
+                read_gpu_time(sample);
+            }
+            glDeleteQueries(static_cast<GLsizei>(queries.size()), queries.data());
+        }
+
+        int draw_calls = 0;
+        for (const auto& frame : frames)
+        {
+            draw_calls += frame.Draws;
+        }
+        std::cout << frames.size() << " frames x " << passes << " passes at up to " << width << 'x' << height << " | draw calls per frame: " << draw_calls / static_cast<int>(frames.size())
+                  << '\n';
+        print_summary("cpu", samples, &FrameSample::CpuMs);
+        if (has_gpu_timer)
+        {
+            print_summary("gpu", samples, &FrameSample::GpuMs);
+        }
+        print_summary("frame", samples, &FrameSample::FrameMs);
+
+        if (per_draw && !draws.empty())
+        {
+            std::sort(draws.begin(), draws.end(), slower);
+            std::cout << "slowest draws:\n";
+            for (const auto& draw : draws)
+            {
+                std::cout << "  frame " << draw.Frame << " draw " << draw.Index << " | " << OpenGL::CaptureOpName(draw.Op) << " count: " << draw.Count
+                          << " instances: " << draw.Instances << " | gpu ms: " << draw.GpuMs << '\n';
+            }
+        }
+
+        if (!csv_path.empty())
+        {
+            std::ofstream csv(csv_path);
+            csv << "pass,frame,cpu_ms,gpu_ms,frame_ms\n";
+            for (const auto& sample : samples)
+            {
+                csv << sample.Pass << ',' << sample.Frame << ',' << sample.CpuMs << ',';
+                if (has_gpu_timer)
+                {
+                    csv << sample.GpuMs;
+                }
+                csv << ',' << sample.FrameMs << '\n';
+            }
+        }
+        replay.Clear();
+    }
+    catch (const std::exception& e)
+    {
+        std::cout << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
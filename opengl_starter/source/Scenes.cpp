@@ -0,0 +1,969 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "Scenes.hpp"
+
+#include "BatchRenderer2D.hpp"
+#include "CommandBuffer.hpp"
+#include "FrameCapture.hpp"
+#include "FrameUniforms.hpp"
+#include "GLState.hpp"
+#include "Handle.hpp"
+#include "InstancedMesh.hpp"
+#include "JobSystem.hpp"
+#include "Math.hpp"
+#include "Mesh.hpp"
+#include "MeshFile.hpp"
+#include "Profiler.hpp"
+#include "Shader.hpp"
+#include "ShaderHotReload.hpp"
+#include "ShapeCache.hpp"
+#include "SpatialGrid.hpp"
+#include "SpriteBatch.hpp"
+#include "TextureAtlas.hpp"
+#include "Uniform.hpp"
+#include "Vertex.hpp"
+#include "VertexLayout.hpp"
+#include <GL/glew.h>
+#include <algorithm>
+#include <array> //feed array to vertex shader, and vertex shader do NDC
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <numbers>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+int        gWidth          = 800;
+int        gHeight         = 600;
+Scene      gScene          = Scene::Face;
+FaceMode   gFaceMode       = FaceMode::PerObject;
+int        gBenchmarkQuads = 10'000;
+int        gBenchmarkFaces = 1'000;
+int        gWorldObjects   = 100'000;
+int        gSpriteCount    = 10'000;
+int        gShapeCount     = 2'000;
+float      gUploadBudgetMB = 4.0f;
+bool       gCulling        = true;
+FrameStats gFrameStats;
+
+OpenGL::VertexFormat                  gVertexFormat = OpenGL::VertexFormat::PackedColor;
+std::optional<OpenGL::StreamStrategy> gStreamStrategy;
+std::filesystem::path                 gMeshPath;
+bool                                  gHotReload = false;
+unsigned                              gJobThreads = 0;
+
+namespace
+{
+    OpenGL::CompiledShader gShader;
+    // --hot-reload : the face shader lives in here instead of gShader, see face_shader()
+    std::unique_ptr<OpenGL::ShaderHotReload> gShaderReload;
+    OpenGL::ShaderHotReload::ProgramID       gFaceProgram = 0;
+    //keep track of GPU resources by creating a handle
+    //vertex buffer (unique set of vertices) + index buffer + VAO, collect all together : our model data, everything that the model needs
+    OpenGL::Mesh gFaceMesh;
+
+    std::unique_ptr<OpenGL::BatchRenderer2D>    gBatchRenderer;
+    std::unique_ptr<OpenGL::InstancedMesh>      gInstancedFace;
+    std::vector<OpenGL::InstanceData>           gFaceInstances;
+    std::unique_ptr<OpenGL::FrameUniformBuffer> gFrameUniforms; // uToNDC + time for every program, see FrameUniforms.hpp
+    std::unique_ptr<Jobs::JobSystem>            gJobs;
+    std::vector<OpenGL::CommandBuffer>          gCommandBuffers; // one per worker of gJobs
+    OpenGL::CommandSubmitter                    gCommandSubmitter;
+
+    // --world : same density of objects on screen whatever the map size, so only the culling decides how much gets drawn
+    constexpr float WorldDensity    = 1.0f / 96.0f; // objects per square pixel, about 5000 on an 800x600 window
+    constexpr float WorldCellSize   = 32.0f;        // a bit more than the biggest object
+    constexpr int   WorldMoverEvery = 16;           // every 16th object moves, the rest stays put
+
+    struct WorldObject
+    {
+        float X         = 0.0f;
+        float Y         = 0.0f;
+        float VelocityX = 0.0f;
+        float VelocityY = 0.0f;
+        float Size      = 0.0f;
+        float R         = 0.0f;
+        float G         = 0.0f;
+        float B         = 0.0f;
+    };
+
+    std::vector<WorldObject>                  gWorld; // index == its id in gWorldGrid, nothing gets removed
+    std::unique_ptr<Spatial::LooseGrid>       gWorldGrid;
+    std::vector<Spatial::LooseGrid::ObjectID> gVisible;
+    float                                     gWorldSide = 0.0f;
+
+    // --sprites : the files in Assets/sprites plus a pile of generated images, all in one atlas
+    constexpr int SpriteGeneratedImages = 256;
+
+    struct Sprite
+    {
+        OpenGL::TextureAtlas::SpriteID Image     = 0;
+        float                          X         = 0.0f;
+        float                          Y         = 0.0f;
+        float                          VelocityX = 0.0f;
+        float                          VelocityY = 0.0f;
+        float                          Spin      = 0.0f; // radians per second
+        float                          Scale     = 1.0f;
+    };
+
+    std::unique_ptr<OpenGL::TextureAtlas>       gAtlas;
+    std::unique_ptr<OpenGL::SpriteBatch>        gSpriteBatch;
+    std::vector<OpenGL::TextureAtlas::SpriteID> gSpriteImages;
+    std::vector<Sprite>                         gSprites;
+
+    // --shapes : copies of a few dozen prototypes, breathing so their curves go through a few levels of detail
+    constexpr int ShapePrototypes = 48;
+
+    struct ShapeObject
+    {
+        std::size_t               Prototype = 0;
+        float                     X         = 0.0f;
+        float                     Y         = 0.0f;
+        float                     Size      = 0.0f; // pixels per unit before the breathing
+        float                     Phase     = 0.0f;
+        float                     Spin      = 0.0f; // radians per second
+        OpenGL::ShapeCache::Range Range{};          // kept while the segment count doesn't change
+    };
+
+    std::unique_ptr<OpenGL::ShapeCache>            gShapeCache;
+    std::vector<std::vector<std::array<float, 2>>> gShapePoints; // what the polyline prototypes point into
+    std::vector<OpenGL::Shape>                     gShapePrototypes;
+    std::vector<ShapeObject>                       gShapes;
+
+    using clock = std::chrono::steady_clock;
+    clock::time_point gLastFrame = clock::now();
+
+    // simulated time, advanced in fixed steps by update_scene()
+    // drawing blends the last two steps so motion stays smooth when updates and frames don't line up
+    double gPreviousTime = 0.0;
+    double gCurrentTime  = 0.0;
+    float  gSceneTime    = 0.0f; // what this frame draws at
+
+    // the reloaded one can change between frames, so don't keep the reference around
+    [[nodiscard]] OpenGL::CompiledShader& face_shader()
+    {
+        return gShaderReload ? gShaderReload->Get(gFaceProgram) : gShader;
+    }
+
+    void draw_face()
+    {
+        //to feed to the uModel, uToNDC was already written for the frame in main_loop()
+        std::array<float, 9> model{
+            128.0f,
+            0.0f,
+            0.0f, // column 0
+            0.0f,
+            128.0f,
+            0.0f, // column 1
+            0.0f,
+            0.0f,
+            1.0f // column 2
+        };
+        //in shader there is uniformlocations so we can send uniform, and change by index,,check createshader!
+
+        // drawing
+        auto& shader = face_shader();
+        OpenGL::UseProgram(shader.Shader);//ask gl to use shader
+        // uniform ids index a flat array instead of hashing the name, and unchanged values aren't sent again (check Uniform.hpp)
+        OpenGL::SetUniform(shader, OpenGL::UniformIDs::uModel, model); //bind it first
+        OpenGL::SetUniform(shader, OpenGL::UniformIDs::uColor, 1.0f, 1.0f, 1.0f, 1.0f); // no tint, uniforms start at 0
+        // select which model we want to draw, then glDrawElements(type of primitive model, how many indices, type of indices, offset(sometime need to draw part of this))
+        // the index type is 16 or 32 bit depending on how many vertices the mesh has
+        OpenGL::DrawMesh(gFaceMesh);
+        // no unselect : the state cache knows what's bound, next frame's binds are dropped
+
+        gFrameStats = FrameStats{ 1, 1 };
+    }
+
+    void draw_batch_benchmark()
+    {
+        // fill the window with a grid of spinning quads
+        const int   columns   = std::max(1, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(gBenchmarkQuads)))));
+        const int   rows      = std::max(1, (gBenchmarkQuads + columns - 1) / columns);
+        const float cell_w    = static_cast<float>(gWidth) / static_cast<float>(columns);
+        const float cell_h    = static_cast<float>(gHeight) / static_cast<float>(rows);
+        const float seconds   = gSceneTime;
+        const float left      = -0.5f * static_cast<float>(gWidth) + 0.5f * cell_w;
+        const float bottom    = -0.5f * static_cast<float>(gHeight) + 0.5f * cell_h;
+        const auto  quad_size = Math::ScaleMatrix(0.8f * cell_w, 0.8f * cell_h);
+
+        gBatchRenderer->BeginScene();
+        for (int i = 0; i < gBenchmarkQuads; ++i)
+        {
+            const int   column   = i % columns;
+            const int   row      = i / columns;
+            const float x        = left + static_cast<float>(column) * cell_w;
+            const float y        = bottom + static_cast<float>(row) * cell_h;
+            const auto  model    = Math::Multiply(Math::TranslationMatrix(x, y), Math::Multiply(Math::RotationMatrix(seconds + 0.01f * static_cast<float>(i)), quad_size));
+            const float t        = static_cast<float>(column) / static_cast<float>(columns);
+            gBatchRenderer->DrawQuad(model, t, 1.0f - t, static_cast<float>(row) / static_cast<float>(rows));
+        }
+        gBatchRenderer->EndScene();
+
+        gFrameStats = FrameStats{ gBatchRenderer->GetStatistics().Quads, gBatchRenderer->GetStatistics().DrawCalls };
+    }
+
+    void draw_faces_benchmark()
+    {
+        // grid of wobbling faces, the same instance data feeds both modes
+        const int   columns = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(gBenchmarkFaces))));
+        const int   rows    = (gBenchmarkFaces + columns - 1) / columns;
+        const float cell_w  = static_cast<float>(gWidth) / static_cast<float>(columns);
+        const float cell_h  = static_cast<float>(gHeight) / static_cast<float>(rows);
+        const float size    = std::min(cell_w, cell_h);
+        const float left    = -0.5f * static_cast<float>(gWidth) + 0.5f * cell_w;
+        const float bottom  = -0.5f * static_cast<float>(gHeight) + 0.5f * cell_h;
+        const float seconds = gSceneTime;
+
+        const auto face_instance = [=](int i)
+        {
+            const int   column = i % columns;
+            const int   row    = i / columns;
+            const float x      = left + static_cast<float>(column) * cell_w;
+            const float y      = bottom + static_cast<float>(row) * cell_h;
+            const float angle  = 0.25f * std::sin(seconds * 2.0f + 0.1f * static_cast<float>(i));
+            const auto  model  = Math::Multiply(Math::TranslationMatrix(x, y), Math::Multiply(Math::RotationMatrix(angle), Math::ScaleMatrix(size, size)));
+            const float t      = static_cast<float>(column) / static_cast<float>(columns);
+            return OpenGL::InstanceData{ model, 1.0f, 1.0f - 0.5f * t, 0.5f + 0.5f * t };
+        };
+
+        if (gFaceMode == FaceMode::Recorded)
+        {
+            // every worker fills its own command buffer, no locks, then this thread sorts and draws them all
+            auto&      shader       = face_shader();
+            const auto vertex_array = gFaceMesh.VertexArray.Get(); // the pool is gl thread only, the workers get the name
+            const auto key          = OpenGL::MakeSortKey(0, shader.Shader, vertex_array);
+            for (auto& buffer : gCommandBuffers)
+            {
+                buffer.Clear();
+            }
+            {
+                PROFILE_SCOPE("record");
+                gJobs->ParallelFor(static_cast<std::size_t>(gBenchmarkFaces), 1024,
+                                   [&](std::size_t begin, std::size_t end, unsigned worker)
+                                   {
+                                       auto& buffer = gCommandBuffers[worker];
+                                       for (std::size_t i = begin; i < end; ++i)
+                                       {
+                                           const auto          instance = face_instance(static_cast<int>(i));
+                                           OpenGL::DrawCommand command;
+                                           command.Key         = key | (i & 0xFF'FFFFu); // same order as the other modes
+                                           command.Shader      = &shader;
+                                           command.VertexArray = vertex_array;
+                                           command.IndexType   = gFaceMesh.IndexType;
+                                           command.IndexCount  = gFaceMesh.IndexCount;
+                                           command.Model       = instance.Model;
+                                           command.Color       = { instance.r, instance.g, instance.b, 1.0f };
+                                           buffer.Draw(command);
+                                       }
+                                   });
+            }
+            const auto submitted = gCommandSubmitter.Submit(gCommandBuffers);
+            gFrameStats               = FrameStats{ gBenchmarkFaces, submitted.DrawCalls };
+            gFrameStats.QueuedChanges = submitted.Recorded.Total();
+            gFrameStats.SortedChanges = submitted.Submitted.Total();
+            return;
+        }
+
+        gFaceInstances.clear();
+        for (int i = 0; i < gBenchmarkFaces; ++i)
+        {
+            gFaceInstances.push_back(face_instance(i));
+        }
+
+        if (gFaceMode == FaceMode::Instanced)
+        {
+            gFrameStats = FrameStats{ gBenchmarkFaces, gInstancedFace->Draw(gFaceInstances) };
+            return;
+        }
+
+        // the old way : uModel and uColor uploads and one draw call per face
+        auto& shader = face_shader();
+        OpenGL::UseProgram(shader.Shader);
+        for (const auto& instance : gFaceInstances)
+        {
+            OpenGL::SetUniform(shader, OpenGL::UniformIDs::uModel, instance.Model);
+            OpenGL::SetUniform(shader, OpenGL::UniformIDs::uColor, instance.r, instance.g, instance.b, 1.0f);
+            OpenGL::DrawMesh(gFaceMesh);
+        }
+        gFrameStats = FrameStats{ gBenchmarkFaces, gBenchmarkFaces };
+    }
+
+    [[nodiscard]] Spatial::Rect world_bounds(const WorldObject& object) noexcept
+    {
+        const float half = 0.5f * object.Size;
+        return Spatial::Rect{ object.X - half, object.Y - half, object.X + half, object.Y + half };
+    }
+
+    // pixels around the camera -> NDC, the camera circles the map
+    [[nodiscard]] Math::mat3 world_to_ndc()
+    {
+        const float radius = 0.35f * gWorldSide;
+        const float angle  = 0.05f * gSceneTime;
+        return Math::Multiply(Math::ToNDCMatrix(gWidth, gHeight), Math::TranslationMatrix(-radius * std::cos(angle), -radius * std::sin(angle)));
+    }
+
+    void setup_world()
+    {
+        gWorldSide = std::sqrt(static_cast<float>(gWorldObjects) / WorldDensity);
+        gWorldGrid = std::make_unique<Spatial::LooseGrid>(WorldCellSize);
+        gWorld.resize(static_cast<std::size_t>(gWorldObjects));
+        std::mt19937                          random{ 42 }; // same map every run
+        std::uniform_real_distribution<float> position(-0.5f * gWorldSide, 0.5f * gWorldSide);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        for (std::size_t i = 0; i < gWorld.size(); ++i)
+        {
+            auto& object = gWorld[i];
+            object.X     = position(random);
+            object.Y     = position(random);
+            object.Size  = 4.0f + 24.0f * unit(random);
+            object.R     = unit(random);
+            object.G     = unit(random);
+            object.B     = 0.5f + 0.5f * unit(random);
+            if (i % WorldMoverEvery == 0)
+            {
+                object.VelocityX = 200.0f * (unit(random) - 0.5f);
+                object.VelocityY = 200.0f * (unit(random) - 0.5f);
+            }
+            gWorldGrid->Insert(world_bounds(object));
+        }
+    }
+
+    void update_world(double step_seconds)
+    {
+        const float step = static_cast<float>(step_seconds);
+        const float edge = 0.5f * gWorldSide;
+        for (std::size_t i = 0; i < gWorld.size(); i += WorldMoverEvery)
+        {
+            auto& object = gWorld[i];
+            object.X += object.VelocityX * step;
+            object.Y += object.VelocityY * step;
+            // bounce off the edges of the map
+            object.VelocityX = (std::abs(object.X) > edge) ? -object.VelocityX : object.VelocityX;
+            object.VelocityY = (std::abs(object.Y) > edge) ? -object.VelocityY : object.VelocityY;
+            gWorldGrid->Move(static_cast<Spatial::LooseGrid::ObjectID>(i), world_bounds(object));
+        }
+    }
+
+    void draw_world_benchmark()
+    {
+        const auto draw = [](const WorldObject& object)
+        {
+            gBatchRenderer->DrawQuad(Math::Multiply(Math::TranslationMatrix(object.X, object.Y), Math::ScaleMatrix(object.Size, object.Size)), object.R, object.G, object.B);
+        };
+
+        gBatchRenderer->BeginScene();
+        if (gCulling)
+        {
+            gVisible.clear();
+            {
+                PROFILE_SCOPE("cull");
+                gWorldGrid->Query(Spatial::VisibleRect(world_to_ndc()), gVisible);
+            }
+            for (const auto id : gVisible)
+            {
+                draw(gWorld[id]);
+            }
+        }
+        else
+        {
+            for (const auto& object : gWorld)
+            {
+                draw(object);
+            }
+        }
+        gBatchRenderer->EndScene();
+
+        gFrameStats = FrameStats{ gBatchRenderer->GetStatistics().Quads, gBatchRenderer->GetStatistics().DrawCalls };
+    }
+
+    // size x size disc, ring or diamond, see-through outside of the shape
+    [[nodiscard]] OpenGL::Image make_sprite_image(int shape, int size, std::uint8_t r, std::uint8_t g, std::uint8_t b)
+    {
+        OpenGL::Image image{ size, size, std::vector<std::uint8_t>(static_cast<std::size_t>(size * size) * 4) };
+        const float   half = 0.5f * static_cast<float>(size);
+        for (int y = 0; y < size; ++y)
+        {
+            for (int x = 0; x < size; ++x)
+            {
+                const float dx     = (static_cast<float>(x) + 0.5f - half) / half;
+                const float dy     = (static_cast<float>(y) + 0.5f - half) / half;
+                const float radius = std::sqrt(dx * dx + dy * dy);
+                const bool  inside = (shape == 0) ? radius <= 1.0f : (shape == 1) ? (radius <= 1.0f && radius >= 0.6f) : std::abs(dx) + std::abs(dy) <= 1.0f;
+                // a little shading so the shapes don't look flat
+                const float shade = 1.0f - 0.4f * std::min(radius, 1.0f);
+                auto*       pixel = image.Pixels.data() + static_cast<std::size_t>(y * size + x) * 4;
+                pixel[0]          = static_cast<std::uint8_t>(static_cast<float>(r) * shade);
+                pixel[1]          = static_cast<std::uint8_t>(static_cast<float>(g) * shade);
+                pixel[2]          = static_cast<std::uint8_t>(static_cast<float>(b) * shade);
+                pixel[3]          = inside ? 255 : 0;
+            }
+        }
+        return image;
+    }
+
+    void setup_sprites()
+    {
+        const auto budget = static_cast<std::size_t>(std::max(gUploadBudgetMB, 0.0f) * 1024.0f * 1024.0f);
+        gAtlas            = std::make_unique<OpenGL::TextureAtlas>(2048, budget);
+        gSpriteBatch      = std::make_unique<OpenGL::SpriteBatch>(*gFrameUniforms, OpenGL::SpriteBatch::MaxSpritesPerBatch, gStreamStrategy.value_or(OpenGL::BestStreamStrategy()));
+
+        // the files decode on the atlas' threads while the generated ones are already waiting for Update()
+        std::vector<std::filesystem::path> files;
+        if (std::filesystem::is_directory("Assets/sprites"))
+        {
+            for (const auto& entry : std::filesystem::directory_iterator("Assets/sprites"))
+            {
+                if (entry.path().extension() == ".tga")
+                {
+                    files.push_back(entry.path());
+                }
+            }
+        }
+        std::sort(files.begin(), files.end());
+        for (const auto& file : files)
+        {
+            gSpriteImages.push_back(gAtlas->Load(file));
+        }
+        std::mt19937                       random{ 7 };
+        std::uniform_int_distribution<int> size(8, 64);
+        std::uniform_int_distribution<int> channel(64, 255);
+        for (int i = 0; i < SpriteGeneratedImages; ++i)
+        {
+            const auto color = [&] { return static_cast<std::uint8_t>(channel(random)); };
+            gSpriteImages.push_back(gAtlas->Add(make_sprite_image(i % 3, size(random), color(), color(), color())));
+        }
+
+        gSprites.resize(static_cast<std::size_t>(gSpriteCount));
+        std::uniform_real_distribution<float>      unit(0.0f, 1.0f);
+        std::uniform_int_distribution<std::size_t> image(0, gSpriteImages.size() - 1);
+        for (auto& sprite : gSprites)
+        {
+            sprite.Image     = gSpriteImages[image(random)];
+            sprite.X         = (unit(random) - 0.5f) * static_cast<float>(gWidth);
+            sprite.Y         = (unit(random) - 0.5f) * static_cast<float>(gHeight);
+            sprite.VelocityX = 150.0f * (unit(random) - 0.5f);
+            sprite.VelocityY = 150.0f * (unit(random) - 0.5f);
+            sprite.Spin      = 2.0f * (unit(random) - 0.5f);
+            sprite.Scale     = 0.5f + unit(random);
+        }
+    }
+
+    void update_sprites(double step_seconds)
+    {
+        const float step   = static_cast<float>(step_seconds);
+        const float edge_x = 0.5f * static_cast<float>(gWidth);
+        const float edge_y = 0.5f * static_cast<float>(gHeight);
+        for (auto& sprite : gSprites)
+        {
+            sprite.X += sprite.VelocityX * step;
+            sprite.Y += sprite.VelocityY * step;
+            sprite.VelocityX = (std::abs(sprite.X) > edge_x) ? -sprite.VelocityX : sprite.VelocityX;
+            sprite.VelocityY = (std::abs(sprite.Y) > edge_y) ? -sprite.VelocityY : sprite.VelocityY;
+        }
+    }
+
+    void draw_sprites()
+    {
+        // whatever finished decoding gets packed, then up to the budget of it goes to the gpu
+        gAtlas->Update();
+
+        gSpriteBatch->BeginScene();
+        for (const auto& sprite : gSprites)
+        {
+            const auto& region = gAtlas->Get(sprite.Image);
+            const float width  = sprite.Scale * static_cast<float>(region.Width);
+            const float height = sprite.Scale * static_cast<float>(region.Height);
+            const auto  model  = Math::Multiply(Math::TranslationMatrix(sprite.X, sprite.Y), Math::Multiply(Math::RotationMatrix(sprite.Spin * gSceneTime), Math::ScaleMatrix(width, height)));
+            gSpriteBatch->Draw(region, model);
+        }
+        gSpriteBatch->EndScene();
+
+        gFrameStats = FrameStats{ gSpriteBatch->GetStatistics().Sprites, gSpriteBatch->GetStatistics().DrawCalls };
+    }
+
+    void setup_shapes()
+    {
+        gShapeCache = std::make_unique<OpenGL::ShapeCache>();
+        std::mt19937                          random{ 5 };
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        const auto                            color = [&] { return OpenGL::Color3{ 0.3f + 0.7f * unit(random), 0.3f + 0.7f * unit(random), 0.3f + 0.7f * unit(random) }; };
+
+        // stars and zigzags inside [-0.5,0.5], all made before any span points at them
+        for (int i = 0; i < ShapePrototypes / 3; ++i)
+        {
+            const int                         corners = 5 + i % 5;
+            std::vector<std::array<float, 2>> points;
+            for (int corner = 0; corner < 2 * corners; ++corner)
+            {
+                const float angle  = std::numbers::pi_v<float> * static_cast<float>(corner) / static_cast<float>(corners);
+                const float radius = (corner % 2 == 0) ? 0.45f : 0.2f + 0.1f * unit(random);
+                points.push_back((i % 2 == 0) ? std::array{ radius * std::cos(angle), radius * std::sin(angle) }
+                                              : std::array{ -0.45f + 0.9f * static_cast<float>(corner) / static_cast<float>(2 * corners - 1), (corner % 2 == 0) ? 0.2f : -0.2f });
+            }
+            gShapePoints.push_back(std::move(points));
+        }
+        for (int i = 0; i < ShapePrototypes; ++i)
+        {
+            switch (i % 3)
+            {
+                case 0: gShapePrototypes.emplace_back(OpenGL::RoundedRect{ 1.0f, 0.4f + 0.6f * unit(random), 0.05f + 0.15f * unit(random), color() }); break;
+                case 1: gShapePrototypes.emplace_back(OpenGL::Circle{ 0.5f, color() }); break;
+                default:
+                    {
+                        const auto& points = gShapePoints[static_cast<std::size_t>(i / 3)];
+                        gShapePrototypes.emplace_back(OpenGL::Polyline{ points, 0.06f, i % 2 == 0, color() });
+                    }
+                    break;
+            }
+        }
+
+        gShapes.resize(static_cast<std::size_t>(gShapeCount));
+        std::uniform_int_distribution<std::size_t> prototype(0, gShapePrototypes.size() - 1);
+        for (auto& shape : gShapes)
+        {
+            shape.Prototype = prototype(random);
+            shape.X         = (unit(random) - 0.5f) * static_cast<float>(gWidth);
+            shape.Y         = (unit(random) - 0.5f) * static_cast<float>(gHeight);
+            shape.Size      = 8.0f + 112.0f * unit(random) * unit(random); // mostly small, a few big ones
+            shape.Phase     = 6.3f * unit(random);
+            shape.Spin      = 2.0f * (unit(random) - 0.5f);
+        }
+    }
+
+    void draw_shapes(const Math::mat3& to_ndc)
+    {
+        // the same model matrices the face uses, the cache only hands out index ranges
+        auto& shader = face_shader();
+        OpenGL::UseProgram(shader.Shader);
+        OpenGL::SetUniform(shader, OpenGL::UniformIDs::uColor, 1.0f, 1.0f, 1.0f, 1.0f);
+        for (auto& object : gShapes)
+        {
+            const float scale    = object.Size * (1.0f + 0.5f * std::sin(0.7f * gSceneTime + object.Phase));
+            const auto  model    = Math::Multiply(Math::TranslationMatrix(object.X, object.Y), Math::Multiply(Math::RotationMatrix(object.Spin * gSceneTime), Math::ScaleMatrix(scale, scale)));
+            const auto& shape    = gShapePrototypes[object.Prototype];
+            const int   segments = OpenGL::ShapeSegments(shape, OpenGL::PixelsPerUnit(to_ndc, model, gWidth, gHeight));
+            if (!gShapeCache->IsCurrent(object.Range) || object.Range.Segments != segments)
+            {
+                object.Range = gShapeCache->Get(shape, segments);
+            }
+            OpenGL::SetUniform(shader, OpenGL::UniformIDs::uModel, model);
+            gShapeCache->Draw(object.Range);
+        }
+        gFrameStats = FrameStats{ gShapeCount, gShapeCount };
+    }
+}
+
+int parse_int_option(std::string_view option, const char* value)
+{
+    try
+    {
+        std::size_t used   = 0;
+        const int   result = std::stoi(value, &used);
+        if (value[used] == '\0')
+        {
+            return result;
+        }
+    }
+    catch (const std::logic_error&) // invalid_argument or out_of_range
+    {
+    }
+    throw std::invalid_argument(std::string{ option } + " wants a whole number, not '" + value + "'");
+}
+
+float parse_float_option(std::string_view option, const char* value)
+{
+    try
+    {
+        std::size_t used   = 0;
+        const float result = std::stof(value, &used);
+        if (value[used] == '\0' && std::isfinite(result)) // stof takes "nan" and "inf" too
+        {
+            return result;
+        }
+    }
+    catch (const std::logic_error&)
+    {
+    }
+    throw std::invalid_argument(std::string{ option } + " wants a number, not '" + value + "'");
+}
+
+bool parse_scene_option(int argc, char* argv[], int& i)
+{
+    const std::string_view arg = argv[i];
+    if (arg == "--batch")
+    {
+        gScene = Scene::BatchBenchmark;
+        if (i + 1 < argc)
+        {
+            gBenchmarkQuads = std::max(1, parse_int_option(arg, argv[++i]));
+        }
+        return true;
+    }
+    if (arg == "--faces")
+    {
+        gScene = Scene::FacesBenchmark;
+        if (i + 1 < argc)
+        {
+            gBenchmarkFaces = std::clamp(parse_int_option(arg, argv[++i]), 1, MaxFaces);
+        }
+        return true;
+    }
+    if (arg == "--instanced")
+    {
+        gFaceMode = FaceMode::Instanced;
+        return true;
+    }
+    if (arg == "--world")
+    {
+        gScene = Scene::WorldBenchmark;
+        if (i + 1 < argc)
+        {
+            gWorldObjects = std::clamp(parse_int_option(arg, argv[++i]), 1, MaxWorldObjects);
+        }
+        return true;
+    }
+    if (arg == "--sprites")
+    {
+        gScene = Scene::Sprites;
+        if (i + 1 < argc)
+        {
+            gSpriteCount = std::clamp(parse_int_option(arg, argv[++i]), 1, MaxSprites);
+        }
+        return true;
+    }
+    if (arg == "--shapes")
+    {
+        gScene = Scene::Shapes;
+        if (i + 1 < argc)
+        {
+            gShapeCount = std::clamp(parse_int_option(arg, argv[++i]), 1, MaxShapes);
+        }
+        return true;
+    }
+    if (arg == "--upload-budget" && i + 1 < argc)
+    {
+        gUploadBudgetMB = parse_float_option(arg, argv[++i]);
+        return true;
+    }
+    if (arg == "--no-culling")
+    {
+        gCulling = false;
+        return true;
+    }
+    if (arg == "--recorded")
+    {
+        gFaceMode = FaceMode::Recorded;
+        return true;
+    }
+    if (arg == "--jobs" && i + 1 < argc)
+    {
+        gJobThreads = static_cast<unsigned>(std::max(0, parse_int_option(arg, argv[++i])));
+        return true;
+    }
+    if (arg == "--vertex-format" && i + 1 < argc)
+    {
+        const auto format = OpenGL::VertexFormatFromString(argv[++i]);
+        if (!format)
+        {
+            throw std::invalid_argument("--vertex-format wants float, packed, half or short");
+        }
+        gVertexFormat = *format;
+        return true;
+    }
+    if (arg == "--stream" && i + 1 < argc)
+    {
+        const auto strategy = OpenGL::StreamStrategyFromString(argv[++i]);
+        if (!strategy)
+        {
+            throw std::invalid_argument("--stream wants orphan, unsync or persistent");
+        }
+        gStreamStrategy = *strategy;
+        return true;
+    }
+    if (arg == "--mesh" && i + 1 < argc)
+    {
+        gMeshPath = argv[++i];
+        return true;
+    }
+    if (arg == "--hot-reload")
+    {
+        gHotReload = true;
+        return true;
+    }
+    return false;
+}
+
+std::string_view scene_label()
+{
+    switch (gScene)
+    {
+        case Scene::Face: return "face";
+        case Scene::BatchBenchmark: return "batched quads";
+        case Scene::FacesBenchmark:
+            switch (gFaceMode)
+            {
+                case FaceMode::PerObject: return "per object faces";
+                case FaceMode::Instanced: return "instanced faces";
+                case FaceMode::Recorded: return "recorded faces";
+            }
+            break;
+        case Scene::WorldBenchmark: return gCulling ? "world, culled" : "world, everything";
+        case Scene::Sprites: return "atlas sprites";
+        case Scene::Shapes: return "cached shapes";
+    }
+    return "unknown";
+}
+
+void setup()
+{
+    //raw string supported by C++
+    //version(webgl2 == opengl3),describe what kind of layout our vertices are going to be 
+    //location0 - very first variable-attribute
+    //order doesn't matter
+    //gl_Position - put clip space if we're doing 3D or NDC if 2D(check PDF!)
+    //in normaly we have to transformation our coordinates 
+    //but now, we hardcoded to get our positon already in NDC space so don't care
+    //w has to be 1, -1 to +1 with z
+
+    //need to be interpolated across the vertices(triangle)
+    //triangle color from vertex shader -> (*) -> fragment shader
+    //to communicate, make out variable vec3
+    /*=======================================================================================================*/
+
+    //in open gl, elements are specified in column order
+    // ex) {1,2 //first column , 3,4 //second column}
+    // multiply mat2 to scale
+    // model -(with model matrix,Mm)> world -(with view matrix,Mview)> camera/view -(with ndc, Mndc)> normalized -(with viewport, Mviewport)>  screen ->framebuffer
+    // we don't care Mview(world->camera) yet
+    // if we want to matrix that affect whole models(not a single vertex), we can make in glsl uniform(all same) transformation matrix
+
+    //**gl use floats only
+    //to feed real matrix to uModel and uToNDC....go to game logic
+    //uToNDC is the same for every program, so it lives in the shared FrameData uniform block (FrameUniforms.hpp)
+    const auto vertex_glsl = std::string{ R"(#version 300 es
+layout(location = 0) in vec2 aVertexPosition;
+layout(location = 1) in vec3 aVertexColor;
+uniform mat3 uModel;
+uniform vec4 uColor;
+)" } + OpenGL::FrameUniformsGLSL + R"(out vec3 vColor;
+void main()
+{
+    vec3 cam_position = uModel * vec3(aVertexPosition, 1.0);
+    vec3 ndc_position = uToNDC * cam_position;
+    gl_Position = vec4(ndc_position.xy, 0.0, 1.0);
+    vColor = aVertexColor * uColor.rgb;
+
+}
+)";
+//now put things to the fragment shader
+//decide precision
+    const auto fragment_glst = R"(#version 300 es
+precision mediump float;
+
+in vec3 vColor;
+out vec4 FragColor;
+
+void main()
+{
+    FragColor = vec4(vColor, 1.0);
+}
+)";
+    gFrameUniforms = std::make_unique<OpenGL::FrameUniformBuffer>();
+    if (gHotReload)
+    {
+        // same shader from Assets/shaders, edits show up on the next frame. A reloaded program has to be attached again
+        gShaderReload = std::make_unique<OpenGL::ShaderHotReload>();
+        gFaceProgram  = gShaderReload->Add("Assets/shaders/face.vert", "Assets/shaders/face.frag", [](OpenGL::CompiledShader& shader) { gFrameUniforms->Attach(shader); });
+    }
+    else
+    {
+        gShader = OpenGL::CreateShader(std::string_view{ vertex_glsl }, std::string_view{ fragment_glst });
+        gFrameUniforms->Attach(gShader);
+    }
+
+    using vertex = OpenGL::Vertex; // {x,y,r,g,b}, CreateMesh() packs it into gVertexFormat (20 bytes -> 12 or 8)
+
+    const vertex vertices[] = {
+        // face verts
+        {   -0.5,   -0.5, 1, 1, 0 },
+        {   +0.5,   -0.5, 1, 1, 0 },
+        {   +0.5,   +0.5, 1, 1, 0 },
+        {   -0.5,   +0.5, 1, 1, 0 },
+        // left eye
+        { -0.375, +0.125, 0, 0, 0 },
+        { -0.125, +0.125, 0, 0, 0 },
+        { -0.125,  +0.25, 0, 0, 0 },
+        { -0.375,  +0.25, 0, 0, 0 },
+        // right eye
+        { +0.125, +0.125, 0, 0, 0 },
+        { +0.375, +0.125, 0, 0, 0 },
+        { +0.375,  +0.25, 0, 0, 0 },
+        { +0.125,  +0.25, 0, 0, 0 },
+        // left mouth part
+        { -0.375,  -0.25, 0, 0, 0 },
+        {  -0.25,  -0.25, 0, 0, 0 },
+        {  -0.25, -0.125, 0, 0, 0 },
+        { -0.375, -0.125, 0, 0, 0 },
+        // right mouth part
+        {  +0.25,  -0.25, 0, 0, 0 },
+        { +0.375,  -0.25, 0, 0, 0 },
+        { +0.375, -0.125, 0, 0, 0 },
+        {  +0.25, -0.125, 0, 0, 0 },
+        // bottom middle mouth
+        {  -0.25, -0.375, 0, 0, 0 },
+        {  +0.25, -0.375, 0, 0, 0 },
+    };
+
+    // Triangle indices, written as 32 bit and stored as 16 bit when the vertex count allows it
+    const std::uint32_t indices[] = { // face
+                                      0, 1, 2, 0, 2, 3,
+                                      // left eye
+                                      4, 5, 6, 4, 6, 7,
+                                      // right eye
+                                      8, 9, 10, 8, 10, 11,
+                                      // mouth
+                                      // left mouth part
+                                      12, 13, 14, 12, 14, 15, 12, 20, 13,
+                                      // right mouth part
+                                      16, 17, 18, 16, 18, 19, 16, 21, 17,
+                                      // middle mouth part
+                                      20, 21, 16, 20, 16, 13
+
+    };
+    // buffer of vertex data, buffer of index data and the vertex array object that ties them together :
+    // glGenBuffers + glBufferData for both, then glVertexAttribPointer for location 0 (2d position) and location 1 (color)
+    // generated from the format's VertexLayout instead of written by hand
+    // or a .mesh from cs200_meshc : mapped and handed to glBufferData as it is, in whatever format it was converted to
+    gFaceMesh = gMeshPath.empty() ? OpenGL::CreateMesh(vertices, indices, gVertexFormat) : OpenGL::CreateMesh(OpenGL::LoadMeshFile(gMeshPath));
+
+    if (gScene == Scene::BatchBenchmark || gScene == Scene::WorldBenchmark)
+    {
+        gBatchRenderer = std::make_unique<OpenGL::BatchRenderer2D>(*gFrameUniforms, OpenGL::BatchRenderer2D::MaxQuadsPerBatch, gStreamStrategy.value_or(OpenGL::BestStreamStrategy()));
+    }
+    if (gScene == Scene::FacesBenchmark)
+    {
+        // same face model, just drawn many times
+        gInstancedFace = std::make_unique<OpenGL::InstancedMesh>(*gFrameUniforms, gFaceMesh, MaxFaces);
+        gFaceInstances.reserve(MaxFaces);
+        gJobs = std::make_unique<Jobs::JobSystem>(gJobThreads);
+        gCommandBuffers.resize(gJobs->GetWorkerCount());
+    }
+    if (gScene == Scene::WorldBenchmark)
+    {
+        setup_world();
+    }
+    if (gScene == Scene::Sprites)
+    {
+        setup_sprites();
+    }
+    if (gScene == Scene::Shapes)
+    {
+        setup_shapes();
+    }
+}
+
+void update_scene(double step_seconds)
+{
+    // game logic
+    gPreviousTime = gCurrentTime;
+    gCurrentTime += step_seconds;
+    if (gScene == Scene::WorldBenchmark)
+    {
+        update_world(step_seconds);
+    }
+    if (gScene == Scene::Sprites)
+    {
+        update_sprites(step_seconds);
+    }
+}
+
+void draw_frame(double alpha)
+{
+    OpenGL::CaptureFrame(gWidth, gHeight); // when --capture is on, the frame's gl calls go to the file from here
+    PROFILE_GPU_SCOPE("draw_frame");
+    if (gShaderReload)
+    {
+        PROFILE_SCOPE("shader reload");
+        gShaderReload->Update(); // between frames, so a whole frame draws with one version of the shader
+    }
+    gSceneTime = static_cast<float>(gPreviousTime + (gCurrentTime - gPreviousTime) * alpha);
+
+    // drawing with opengl
+    OpenGL::Viewport(0, 0, gWidth, gHeight); // param : (offset.x,offset.y,width,height) useful to set offset if game has two player and each has their own camera , feed latest-updated window sized so..
+    OpenGL::ClearColor(0.34f, 0.56f, 0.9f, 1.0f); // just 'set' window color, only the first frame reaches the driver
+    OpenGL::Clear(GL_COLOR_BUFFER_BIT); //actually clear
+
+    //to feed to uToNDC
+    // 2/w 0 0
+    // 0 2/h 0
+    // 0  0  1
+    // written once into the uniform ring, every program reads it from there
+    const auto            now = clock::now();
+    OpenGL::FrameUniforms frame_uniforms;
+    {
+        PROFILE_SCOPE("uniforms");
+        frame_uniforms.ToNDC          = (gScene == Scene::WorldBenchmark) ? world_to_ndc() : Math::ToNDCMatrix(gWidth, gHeight);
+        frame_uniforms.Time           = gSceneTime;
+        frame_uniforms.DeltaTime      = std::chrono::duration<float>(now - gLastFrame).count();
+        frame_uniforms.ViewportWidth  = static_cast<float>(gWidth);
+        frame_uniforms.ViewportHeight = static_cast<float>(gHeight);
+        gLastFrame                    = now;
+        gFrameUniforms->Update(frame_uniforms);
+    }
+
+    gFrameStats = FrameStats{};
+    {
+        PROFILE_GPU_SCOPE("scene");
+        switch (gScene)
+        {
+            case Scene::Face: draw_face(); break;
+            case Scene::BatchBenchmark: draw_batch_benchmark(); break;
+            case Scene::FacesBenchmark: draw_faces_benchmark(); break;
+            case Scene::WorldBenchmark: draw_world_benchmark(); break;
+            case Scene::Sprites: draw_sprites(); break;
+            case Scene::Shapes: draw_shapes(frame_uniforms.ToNDC); break;
+        }
+    }
+    gFrameUniforms->EndFrame(); // fence : this copy of the block is free again once the gpu passes here
+
+    gFrameStats.StateCallsIssued    = OpenGL::GetStateStatistics().Issued;
+    gFrameStats.StateCallsElided    = OpenGL::GetStateStatistics().Elided;
+    gFrameStats.UniformBytes        = gFrameUniforms->GetStatistics().BytesUploaded;
+    gFrameStats.FenceWaits          = gFrameUniforms->GetStatistics().FenceWaits;
+    OpenGL::GetStateStatistics()    = {};
+    gFrameUniforms->GetStatistics() = {};
+    OpenGL::CollectResources(); // whatever this frame released
+}
+
+void shutdown()
+{
+    // gl resources have to go before the context
+    gBatchRenderer.reset();
+    gInstancedFace.reset();
+    gJobs.reset();
+    gWorldGrid.reset();
+    gWorld.clear();
+    gSpriteBatch.reset();
+    gAtlas.reset();
+    gSpriteImages.clear();
+    gSprites.clear();
+    gShapeCache.reset();
+    gShapes.clear();
+    gShapePrototypes.clear();
+    gShapePoints.clear();
+    gCommandBuffers.clear();
+    gShaderReload.reset();
+    gFrameUniforms.reset();
+    OpenGL::DestroyMesh(gFaceMesh);
+    OpenGL::DestroyShader(gShader);
+    OpenGL::ReleaseAllResources(); // and complains about anything that should have been gone already
+}
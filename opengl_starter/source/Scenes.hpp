@@ -0,0 +1,91 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include "StreamBuffer.hpp"
+#include "VertexLayout.hpp"
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+
+// Everything that gets drawn, shared by the window app (main.cpp) and the headless bench (BenchMain.cpp).
+// Neither touches SDL here, the caller owns the context and whatever it presents to.
+
+// which thing draw_frame() draws, picked from the command line
+enum class Scene
+{
+    Face,           // the single hardcoded model
+    BatchBenchmark, // --batch N : N quads through BatchRenderer2D
+    FacesBenchmark, // --faces N : N copies of the face, per object draws or instanced
+    WorldBenchmark, // --world N : N quads over a map much bigger than the window, a camera flying over it
+    Sprites,        // --sprites N : N textured quads bouncing around, every image packed into one atlas
+    Shapes          // --shapes N : N rounded rects, circles and polylines, tessellated once and kept in a ShapeCache
+};
+
+// how the faces benchmark submits its copies, 'i' toggles between them
+enum class FaceMode
+{
+    PerObject, // glUniformMatrix3fv(uModel) + glDrawElements for every face
+    Instanced, // one glDrawElementsInstanced with the models in an instance buffer
+    Recorded   // draw commands recorded on every core (CommandBuffer.hpp), sorted and replayed on the gl thread
+};
+
+constexpr int MaxFaces        = 100'000;
+constexpr int MaxWorldObjects = 1'000'000;
+constexpr int MaxSprites      = 1'000'000;
+constexpr int MaxShapes       = 100'000;
+
+// what the current scene submitted this frame
+struct FrameStats
+{
+    int           Objects          = 0;
+    int           DrawCalls        = 0;
+    std::uint64_t StateCallsIssued = 0; // from the state cache, see GLState.hpp
+    std::uint64_t StateCallsElided = 0;
+    std::uint64_t UniformBytes     = 0; // written into the FrameData ring
+    int           FenceWaits       = 0;
+    int           QueuedChanges    = 0; // program + VAO + uniform changes of the CommandSubmitter draws, in recording order
+    int           SortedChanges    = 0; // and as submitted
+};
+
+extern int        gWidth;
+extern int        gHeight;
+extern Scene      gScene;
+extern FaceMode   gFaceMode;
+extern int        gBenchmarkQuads;
+extern int        gBenchmarkFaces;
+extern int        gWorldObjects;
+extern int        gSpriteCount;
+extern int        gShapeCount;
+extern float      gUploadBudgetMB; // --upload-budget MB, how much atlas data --sprites copies to the gpu per frame
+extern bool       gCulling; // --world only draws what the spatial grid says is on screen, --no-culling / 'c' to draw everything
+extern FrameStats gFrameStats; // filled in by draw_frame()
+
+extern OpenGL::VertexFormat                  gVertexFormat;   // how the face mesh is stored, --vertex-format
+extern std::optional<OpenGL::StreamStrategy> gStreamStrategy; // how the batch renderer streams its vertices, --stream. Empty : the best the driver has
+extern std::filesystem::path                 gMeshPath;       // --mesh FILE, a .mesh to draw instead of the built in face
+extern bool                                  gHotReload;      // --hot-reload, the face shader comes from Assets/shaders and follows edits
+extern unsigned                              gJobThreads;     // --jobs N, threads recording the faces in FaceMode::Recorded. 0 : one per core
+
+// --batch N, --faces N, --instanced, --recorded, --jobs N, --world N, --no-culling, --sprites N, --upload-budget MB, --shapes N, --vertex-format NAME, --stream NAME, --mesh FILE and --hot-reload, advances i past the value. false if argv[i] isn't one of them
+bool             parse_scene_option(int argc, char* argv[], int& i);
+// the value after option, throws std::invalid_argument naming the option when value isn't all a (finite) number
+int              parse_int_option(std::string_view option, const char* value);
+float            parse_float_option(std::string_view option, const char* value);
+std::string_view scene_label();
+
+// needs a current context, creates the gl resources of the picked scene
+void setup();
+// one fixed simulation step
+void update_scene(double step_seconds);
+// viewport, clear and the scene's draw calls into whatever framebuffer is bound
+// alpha : how far between the last two update_scene() steps to draw, 1 is the latest
+void draw_frame(double alpha = 1.0);
+// before the context goes away
+void shutdown();
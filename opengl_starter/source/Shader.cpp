@@ -7,11 +7,22 @@
  */
 #include "Shader.hpp"
 
+#include "FileLoader.hpp"
+#include "FrameCapture.hpp"
+#include "GLState.hpp"
+#include "Hash.hpp"
 #include <GL/glew.h>
 #include <iostream>
 #include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <iomanip>
+#include <limits>
 #include <sstream>
 #include <fstream>
+#include <vector>
 #include <gsl/gsl>
 //custom this source file from assignment not to use logger
 namespace
@@ -19,40 +30,104 @@ namespace
     //customed
     void                                                 print_glsl_text(std::string_view source);
     [[nodiscard]] OpenGL::Handle                         compile_shader_source(GLenum type, std::string_view glsl_text);
-    [[nodiscard]] OpenGL::Handle                         compile_shader_file(GLenum type, const std::filesystem::path& file_path);
     [[nodiscard]] OpenGL::ShaderHandle                   link_shader_program(OpenGL::Handle vertex_handle, OpenGL::Handle fragment_handle);
-    [[nodiscard]] std::unordered_map<std::string, GLint> get_uniform_locations(OpenGL::ShaderHandle shader);
+
+    // program binary cache
+    struct ShaderCache
+    {
+        bool                          Enabled = false;
+        std::filesystem::path         Directory{};
+        std::uint64_t                 DriverHash = 0; // vendor + renderer + version
+        OpenGL::ShaderCacheStatistics Statistics{};
+    };
+
+    ShaderCache gShaderCache;
+
+    // deque so the string_view keys keep pointing at the same names when it grows
+    struct UniformNameRegistry
+    {
+        std::deque<std::string>                                 Names;
+        std::unordered_map<std::string_view, OpenGL::UniformID> Ids;
+    };
+
+    // function local so ids interned during static initialization of other files are safe
+    [[nodiscard]] UniformNameRegistry& uniform_name_registry()
+    {
+        static UniformNameRegistry registry;
+        return registry;
+    }
+
+    // stage files only live until they are compiled, every load reuses the same memory
+    [[nodiscard]] OpenGL::FileArena& shader_file_arena()
+    {
+        static OpenGL::FileArena arena;
+        return arena;
+    }
+
+    [[nodiscard]] std::uint64_t         program_cache_key(std::string_view vertex_source, std::string_view fragment_source) noexcept;
+    [[nodiscard]] std::filesystem::path program_cache_path(std::uint64_t key);
+    [[nodiscard]] OpenGL::ShaderHandle  load_cached_program(std::uint64_t key);
+    void                                store_cached_program(std::uint64_t key, OpenGL::ShaderHandle program);
+    [[nodiscard]] double                milliseconds_since(std::chrono::steady_clock::time_point start) noexcept;
 }
 
 namespace OpenGL
 {
     CompiledShader CreateShader(std::filesystem::path vertex_filepath, std::filesystem::path fragment_filepath)
     {
-        const auto     vertex_handle   = compile_shader_file(GL_VERTEX_SHADER, vertex_filepath);
-        const auto     fragment_handle = compile_shader_file(GL_FRAGMENT_SHADER, fragment_filepath);
-        CompiledShader cs{};
-        cs.Shader           = link_shader_program(vertex_handle, fragment_handle);
-        cs.UniformLocations = get_uniform_locations(cs.Shader);
-        return cs;
+        // both files in one go, the views point into the arena until the next load
+        auto& arena = shader_file_arena();
+        arena.Reset();
+        const auto texts = ReadShaderFiles(std::move(vertex_filepath), std::move(fragment_filepath), arena);
+        return CreateShader(texts[0], texts[1]);
     }
 
     CompiledShader CreateShader(std::string_view vertex_source, std::string_view fragment_source)
     {
-        const auto     vertex_handle   = compile_shader_source(GL_VERTEX_SHADER, vertex_source);
-        const auto     fragment_handle = compile_shader_source(GL_FRAGMENT_SHADER, fragment_source);
+        const auto     start = std::chrono::steady_clock::now();
         CompiledShader cs{};
-        cs.Shader           = link_shader_program(vertex_handle, fragment_handle);
-        cs.UniformLocations = get_uniform_locations(cs.Shader);
+        std::uint64_t  key = 0;
+        if (gShaderCache.Enabled)
+        {
+            key       = program_cache_key(vertex_source, fragment_source);
+            cs.Shader = load_cached_program(key);
+            if (cs.Shader != 0)
+            {
+                cs.Program = AdoptProgram(cs.Shader);
+                ++gShaderCache.Statistics.Hits;
+                gShaderCache.Statistics.LoadMilliseconds += milliseconds_since(start);
+                cs.UniformLocations = GetUniformLocations(cs.Shader);
+                cs.UniformSlots     = GetUniformSlots(cs.UniformLocations);
+                CaptureProgram(cs.Shader, vertex_source, fragment_source, cs.UniformLocations);
+                return cs;
+            }
+        }
+
+        const auto vertex_handle   = compile_shader_source(GL_VERTEX_SHADER, vertex_source);
+        const auto fragment_handle = compile_shader_source(GL_FRAGMENT_SHADER, fragment_source);
+        cs.Shader                  = link_shader_program(vertex_handle, fragment_handle);
+        cs.Program                 = AdoptProgram(cs.Shader);
+        cs.UniformLocations        = GetUniformLocations(cs.Shader);
+        cs.UniformSlots            = GetUniformSlots(cs.UniformLocations);
+        CaptureProgram(cs.Shader, vertex_source, fragment_source, cs.UniformLocations);
+
+        if (gShaderCache.Enabled)
+        {
+            ++gShaderCache.Statistics.Misses;
+            gShaderCache.Statistics.CompileMilliseconds += milliseconds_since(start);
+            store_cached_program(key, cs.Shader);
+        }
         return cs;
     }
 
     void DestroyShader(CompiledShader& shader) noexcept
     {
-        //no using helper func
-        glDeleteProgram(shader.Shader);
+        // the pool deletes it with the next CollectResources()
+        shader.Program.Reset();
         shader.Shader = 0;
 
         shader.UniformLocations.clear();
+        shader.UniformSlots.clear();
     }
 
     void BindUniformBufferToShader(ShaderHandle shader_handle, GLuint binding_number, Handle uniform_bufer, std::string_view uniform_block_name)
@@ -61,13 +136,154 @@ namespace OpenGL
         if (block_index != GL_INVALID_INDEX)
         {
             glUniformBlockBinding(shader_handle, block_index, binding_number);
-            glBindBufferBase(GL_UNIFORM_BUFFER, binding_number, uniform_bufer);
+            CaptureRecord(CaptureOp::UniformBlockBinding, shader_handle, uniform_block_name, binding_number);
+            BindBufferBase(GL_UNIFORM_BUFFER, binding_number, uniform_bufer);
         }
         else
         {
             std::cout << ("Uniform block '" + std::string(uniform_block_name) + "' not found in shader.") << '\n';
         }
     }
+
+    std::string ReadGLSLFile(const std::filesystem::path& file_path)
+    {
+        try
+        {
+            return ReadTextFile(file_path);
+        }
+        catch (const std::runtime_error& error)
+        {
+            std::cout << error.what() << '\n';
+            throw;
+        }
+    }
+
+    std::array<std::string_view, 2> ReadShaderFiles(std::filesystem::path vertex_filepath, std::filesystem::path fragment_filepath, FileArena& arena)
+    {
+        const std::array file_paths{ std::move(vertex_filepath), std::move(fragment_filepath) };
+        try
+        {
+            const auto texts = ReadFiles(file_paths, arena, 1);
+            return { texts[0], texts[1] };
+        }
+        catch (const std::runtime_error& error)
+        {
+            std::cout << error.what() << '\n';
+            throw;
+        }
+    }
+
+    std::unordered_map<std::string, GLint> GetUniformLocations(ShaderHandle shader)
+    {
+        std::unordered_map<std::string, GLint> uniform_locations;
+        GLint                                  num_uniforms = 0;
+        glGetProgramiv(shader, GL_ACTIVE_UNIFORMS, &num_uniforms);
+        if (num_uniforms <= 0)
+        {
+            return uniform_locations;
+        }
+        GLint max_name_length = 0;
+        glGetProgramiv(shader, GL_ACTIVE_UNIFORM_MAX_LENGTH, &max_name_length);
+        uniform_locations.reserve(static_cast<std::size_t>(num_uniforms));
+        std::string uniform_name;
+        uniform_name.resize(static_cast<std::size_t>(max_name_length));
+
+        for (GLint i = 0; i < num_uniforms; ++i)
+        {
+            GLsizei length = 0;
+            GLint   size   = 0;
+            GLenum  type   = 0;
+            glGetActiveUniform(shader, static_cast<GLuint>(i), max_name_length, &length, &size, &type, uniform_name.data());
+            uniform_name.resize(static_cast<std::size_t>(length));
+            GLint location = glGetUniformLocation(shader, uniform_name.c_str());
+            if (location != -1)
+            {
+                uniform_locations[uniform_name] = location;
+            }
+            uniform_name.resize(static_cast<std::size_t>(max_name_length));
+        }
+        return uniform_locations;
+    }
+
+    std::vector<UniformSlot> GetUniformSlots(const std::unordered_map<std::string, GLint>& uniform_locations)
+    {
+        std::vector<UniformSlot> slots;
+        for (const auto& [name, location] : uniform_locations)
+        {
+            const auto id = InternUniformName(name);
+            if (id >= slots.size())
+            {
+                slots.resize(static_cast<std::size_t>(id) + 1);
+            }
+            slots[id].Location = location;
+        }
+        return slots;
+    }
+
+    UniformID InternUniformName(std::string_view name)
+    {
+        auto& registry = uniform_name_registry();
+        if (const auto found = registry.Ids.find(name); found != registry.Ids.end())
+        {
+            return found->second;
+        }
+        const auto id = gsl::narrow<UniformID>(registry.Names.size());
+        registry.Names.emplace_back(name);
+        registry.Ids.emplace(registry.Names.back(), id);
+        return id;
+    }
+
+    std::string_view UniformName(UniformID id)
+    {
+        return uniform_name_registry().Names.at(id);
+    }
+
+    void EnableShaderCache(const std::filesystem::path& cache_directory)
+    {
+#if defined(__EMSCRIPTEN__)
+        // WebGL2 doesn't expose program binaries
+        (void)cache_directory;
+#else
+        GLint num_formats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &num_formats);
+        if (num_formats <= 0)
+        {
+            std::cout << "Driver has no program binary formats, shader cache disabled\n";
+            return;
+        }
+
+        std::error_code error;
+        std::filesystem::create_directories(cache_directory, error);
+        if (error)
+        {
+            std::cout << ("Cannot create shader cache directory " + cache_directory.string() + " : " + error.message()) << '\n';
+            return;
+        }
+
+        // a driver update changes these strings, so its old binaries simply stop matching
+        std::uint64_t driver_hash = Hash::FNV1aOffset;
+        for (const GLenum name : std::initializer_list<GLenum>{ GL_VENDOR, GL_RENDERER, GL_VERSION })
+        {
+            const auto* text = reinterpret_cast<const char*>(glGetString(name));
+            driver_hash      = Hash::FNV1a(text != nullptr ? std::string_view{ text } : std::string_view{}, driver_hash);
+            driver_hash      = Hash::FNV1a(std::string_view{ "\n" }, driver_hash);
+        }
+
+        gShaderCache.Enabled    = true;
+        gShaderCache.Directory  = cache_directory;
+        gShaderCache.DriverHash = driver_hash;
+#endif
+    }
+
+    void DisableShaderCache() noexcept
+    {
+        gShaderCache.Enabled = false;
+    }
+
+    const ShaderCacheStatistics& GetShaderCacheStatistics() noexcept
+    {
+        return gShaderCache.Statistics;
+    }
 }
 
 namespace
@@ -78,13 +294,15 @@ namespace
         CountInt           num_lines            = std::count(source.begin(), source.end(), '\n');
         const int          max_linenumber_width = static_cast<int>(std::to_string(num_lines).size());
         CountInt           line_number          = 1;
-        std::string        line;
         std::ostringstream sout;
-        std::istringstream source_stream(source.data());
-        while (std::getline(source_stream, line))
+        // straight from the view, it doesn't have to end with a '\0'
+        while (!source.empty())
         {
+            const auto end  = source.find('\n');
+            const auto line = source.substr(0, end);
             sout << std::setw(max_linenumber_width) << std::right << line_number << "| " << line << '\n';
             ++line_number;
+            source.remove_prefix((end == std::string_view::npos) ? source.size() : end + 1);
         }
         std::cout << (sout.str()) << '\n';
     }
@@ -93,7 +311,8 @@ namespace
     {
         OpenGL::Handle shader = glCreateShader(type);
         GLchar const*  source[]{ glsl_text.data() };
-        glShaderSource(shader, 1, source, nullptr);
+        const GLint    length[]{ gsl::narrow<GLint>(glsl_text.size()) }; // views aren't null terminated
+        glShaderSource(shader, 1, source, length);
         glCompileShader(shader);
         GLint is_compiled = 0;
         glGetShaderiv(shader, GL_COMPILE_STATUS, &is_compiled);
@@ -102,8 +321,10 @@ namespace
             GLint log_length = 0;
             glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &log_length);
             std::string error_log;
+            GLsizei     written = 0;
             error_log.resize(static_cast<std::string::size_type>(log_length) + 1);
-            glGetShaderInfoLog(shader, log_length, nullptr, error_log.data());
+            glGetShaderInfoLog(shader, log_length, &written, error_log.data());
+            error_log.resize(static_cast<std::string::size_type>(written)); // no '\0's in what gets printed / thrown
             glDeleteShader(shader);
             shader = 0;
             std::cout << (error_log) << '\n';
@@ -113,21 +334,6 @@ namespace
         return shader;
     }
 
-    OpenGL::Handle compile_shader_file(GLenum type, const std::filesystem::path& file_path)
-    {
-        const auto    shader_file_path = (file_path);
-        std::ifstream ifs(shader_file_path, std::ios::in);
-        if (!ifs)
-        {
-            std::cout << ("Cannot open " + file_path.string()) << '\n';
-            return 0;
-        }
-        std::string glsl_text;
-        glsl_text.reserve(gsl::narrow<std::size_t>(std::filesystem::file_size(shader_file_path)));
-        std::copy((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>(), std::back_insert_iterator(glsl_text));
-        return compile_shader_source(type, std::string_view(glsl_text));
-    }
-
     OpenGL::ShaderHandle link_shader_program(OpenGL::Handle vertex_handle, OpenGL::Handle fragment_handle)
     {
         OpenGL::ShaderHandle program_handle = glCreateProgram();
@@ -138,6 +344,13 @@ namespace
 
         glAttachShader(program_handle, vertex_handle);
         glAttachShader(program_handle, fragment_handle);
+#if !defined(__EMSCRIPTEN__)
+        if (gShaderCache.Enabled)
+        {
+            // has to be set before linking or some drivers won't keep the binary around
+            glProgramParameteri(program_handle, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        }
+#endif
 
         glLinkProgram(program_handle);
 
@@ -151,43 +364,140 @@ namespace
             GLint log_length = 0;
             glGetProgramiv(program_handle, GL_INFO_LOG_LENGTH, &log_length);
             std::string error;
+            GLsizei     written = 0;
             error.resize(static_cast<unsigned>(log_length) + 1);
-            glGetProgramInfoLog(program_handle, log_length, nullptr, error.data());
+            glGetProgramInfoLog(program_handle, log_length, &written, error.data());
+            error.resize(static_cast<unsigned>(written));
             std::cout << (error) << '\n';
             throw std::runtime_error(error);
         }
         return program_handle;
     }
 
-    std::unordered_map<std::string, GLint> get_uniform_locations(OpenGL::ShaderHandle shader)
+    // what goes in front of the driver's blob in every cache file
+    struct ProgramBinaryHeader
     {
-        std::unordered_map<std::string, GLint> uniform_locations;
-        GLint                                  num_uniforms = 0;
-        glGetProgramiv(shader, GL_ACTIVE_UNIFORMS, &num_uniforms);
-        if (num_uniforms <= 0)
+        char          Magic[4] = { 'C', 'S', 'P', 'B' };
+        std::uint32_t Version  = 1;
+        std::uint64_t Key      = 0;
+        std::uint32_t Format   = 0;
+        std::uint32_t Size     = 0;
+    };
+
+    std::uint64_t program_cache_key(std::string_view vertex_source, std::string_view fragment_source) noexcept
+    {
+        // the separator keeps "ab"+"c" and "a"+"bc" apart
+        std::uint64_t key = Hash::FNV1a(vertex_source, gShaderCache.DriverHash);
+        key               = Hash::FNV1a(std::string_view{ "\0", 1 }, key);
+        return Hash::FNV1a(fragment_source, key);
+    }
+
+    std::filesystem::path program_cache_path(std::uint64_t key)
+    {
+        std::ostringstream name;
+        name << std::hex << std::setw(16) << std::setfill('0') << key << ".bin";
+        return gShaderCache.Directory / name.str();
+    }
+
+    OpenGL::ShaderHandle load_cached_program([[maybe_unused]] std::uint64_t key)
+    {
+#if defined(__EMSCRIPTEN__)
+        return 0;
+#else
+        const auto    path = program_cache_path(key);
+        std::ifstream ifs(path, std::ios::in | std::ios::binary);
+        if (!ifs)
         {
-            return uniform_locations;
+            return 0;
         }
-        GLint max_name_length = 0;
-        glGetProgramiv(shader, GL_ACTIVE_UNIFORM_MAX_LENGTH, &max_name_length);
-        uniform_locations.reserve(static_cast<std::size_t>(num_uniforms));
-        std::string uniform_name;
-        uniform_name.resize(static_cast<std::size_t>(max_name_length));
 
-        for (GLint i = 0; i < num_uniforms; ++i)
+        ProgramBinaryHeader header{};
+        ifs.read(reinterpret_cast<char*>(&header), sizeof(header));
+        const ProgramBinaryHeader expected{};
+        if (!ifs || !std::equal(std::begin(header.Magic), std::end(header.Magic), std::begin(expected.Magic)) || header.Version != expected.Version || header.Key != key)
         {
-            GLsizei length = 0;
-            GLint   size   = 0;
-            GLenum  type   = 0;
-            glGetActiveUniform(shader, static_cast<GLuint>(i), max_name_length, &length, &size, &type, uniform_name.data());
-            uniform_name.resize(static_cast<std::size_t>(length));
-            GLint location = glGetUniformLocation(shader, uniform_name.c_str());
-            if (location != -1)
+            return 0;
+        }
+        // forget it and let the caller compile from source
+        const auto reject = [&path]
+        {
+            std::error_code ignored;
+            std::filesystem::remove(path, ignored);
+            ++gShaderCache.Statistics.Rejected;
+            return OpenGL::ShaderHandle{ 0 };
+        };
+        // Size comes from the file, it has to be what follows the header before we allocate for it
+        std::error_code error;
+        const auto      file_size = std::filesystem::file_size(path, error);
+        if (error || header.Size == 0 || header.Size > static_cast<std::uint32_t>(std::numeric_limits<GLsizei>::max()) ||
+            file_size != sizeof(header) + static_cast<std::uintmax_t>(header.Size))
+        {
+            return reject();
+        }
+        std::vector<char> binary(header.Size);
+        ifs.read(binary.data(), gsl::narrow<std::streamsize>(binary.size()));
+        if (!ifs)
+        {
+            return reject();
+        }
+
+        OpenGL::ShaderHandle program = glCreateProgram();
+        glProgramBinary(program, header.Format, binary.data(), gsl::narrow<GLsizei>(binary.size()));
+        GLint is_linked = 0;
+        glGetProgramiv(program, GL_LINK_STATUS, &is_linked);
+        if (is_linked == GL_FALSE)
+        {
+            // driver doesn't like it anymore
+            glDeleteProgram(program);
+            return reject();
+        }
+        return program;
+#endif
+    }
+
+    void store_cached_program([[maybe_unused]] std::uint64_t key, [[maybe_unused]] OpenGL::ShaderHandle program)
+    {
+#if !defined(__EMSCRIPTEN__)
+        GLint length = 0;
+        glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+        if (length <= 0)
+        {
+            return;
+        }
+        std::vector<char> binary(static_cast<std::size_t>(length));
+        GLsizei           written = 0;
+        GLenum            format  = 0;
+        glGetProgramBinary(program, length, &written, &format, binary.data());
+        if (written <= 0)
+        {
+            return;
+        }
+
+        ProgramBinaryHeader header{};
+        header.Key    = key;
+        header.Format = format;
+        header.Size   = static_cast<std::uint32_t>(written);
+
+        // write to a temp file then rename, so a crash never leaves half a binary behind
+        const auto path      = program_cache_path(key);
+        auto       temp_path = path;
+        temp_path += ".tmp";
+        {
+            std::ofstream ofs(temp_path, std::ios::out | std::ios::binary | std::ios::trunc);
+            ofs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            ofs.write(binary.data(), written);
+            if (!ofs)
             {
-                uniform_locations[uniform_name] = location;
+                return;
             }
-            uniform_name.resize(static_cast<std::size_t>(max_name_length));
         }
-        return uniform_locations;
+        std::error_code error;
+        std::filesystem::rename(temp_path, path, error);
+#endif
+    }
+
+    double milliseconds_since(std::chrono::steady_clock::time_point start) noexcept
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
     }
 }
@@ -7,26 +7,76 @@
  */
 #pragma once
 
+#include "GpuResources.hpp"
 #include "Handle.hpp"
+#include <array>
+#include <cstdint>
 #include <filesystem>
 #include <string>
 #include <string_view>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 #include <GL/glew.h>
 
 namespace OpenGL
 {
+    class FileArena;
+
     using ShaderHandle = Handle;
 
+    // uniform names get interned once into small integers (same name -> same id in every program)
+    // so the frame loop can index a flat array instead of hashing a string. See Uniform.hpp for the setters
+    using UniformID = std::uint16_t;
+
+    struct UniformSlot
+    {
+        GLint                Location = -1;
+        bool                 HasValue = false; // nothing uploaded through SetUniform yet
+        std::array<float, 9> Value{};          // last uploaded value, big enough for a mat3
+    };
+
+    // move only, Program owns the gl program and Shader is its name for the calls made every frame
     struct [[nodiscard]] CompiledShader
     {
-        ShaderHandle                           Shader;
+        ShaderHandle                           Shader = 0;
+        ProgramHandle                          Program{};
         std::unordered_map<std::string, GLint> UniformLocations;
+        std::vector<UniformSlot>               UniformSlots; // indexed by UniformID, ids past the end aren't in this program
     };
 
     CompiledShader CreateShader(std::filesystem::path vertex_filepath, std::filesystem::path fragment_filepath);
     CompiledShader CreateShader(std::string_view vertex_source, std::string_view fragment_source);
     void           DestroyShader(CompiledShader& shader) noexcept;
     void           BindUniformBufferToShader(ShaderHandle shader_handle, GLuint binding_number, Handle uniform_bufer, std::string_view uniform_block_name);
+    // whole text of a glsl file, throws if it can't be opened
+    [[nodiscard]] std::string ReadGLSLFile(const std::filesystem::path& file_path);
+    // both stage files into the arena, the views are good until it is Reset(). Prints and throws like ReadGLSLFile
+    [[nodiscard]] std::array<std::string_view, 2> ReadShaderFiles(std::filesystem::path vertex_filepath, std::filesystem::path fragment_filepath, FileArena& arena);
+    // active uniforms of an already linked program
+    [[nodiscard]] std::unordered_map<std::string, GLint> GetUniformLocations(ShaderHandle shader);
+    // interns every name and lays the locations out by UniformID
+    [[nodiscard]] std::vector<UniformSlot> GetUniformSlots(const std::unordered_map<std::string, GLint>& uniform_locations);
+
+    // not thread safe, meant for the gl thread like everything else here
+    [[nodiscard]] UniformID        InternUniformName(std::string_view name);
+    [[nodiscard]] std::string_view UniformName(UniformID id);
+
+    // On disk cache of linked program binaries (glGetProgramBinary / glProgramBinary).
+    // Entries are keyed by the vertex+fragment source and the driver's vendor/renderer/version strings,
+    // anything stale or rejected by the driver silently falls back to a full compile and gets rewritten.
+    // Not available on WebGL2, enabling it there does nothing.
+    struct ShaderCacheStatistics
+    {
+        int    Hits                = 0; // programs loaded from a binary
+        int    Misses              = 0; // programs compiled from source (then stored)
+        int    Rejected            = 0; // binaries the driver refused, counted in Misses as well
+        double CompileMilliseconds = 0; // time spent in compile + link for the misses
+        double LoadMilliseconds    = 0; // time spent in glProgramBinary for the hits
+    };
+
+    // directory gets created if needed, the GL context has to be current
+    void                                       EnableShaderCache(const std::filesystem::path& cache_directory);
+    void                                       DisableShaderCache() noexcept;
+    [[nodiscard]] const ShaderCacheStatistics& GetShaderCacheStatistics() noexcept;
 }
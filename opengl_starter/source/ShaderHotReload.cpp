@@ -0,0 +1,205 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "ShaderHotReload.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <system_error>
+
+#if defined(__linux__) && !defined(__EMSCRIPTEN__)
+#    define HAS_INOTIFY 1
+#    include <sys/inotify.h>
+#    include <unistd.h>
+#else
+#    define HAS_INOTIFY 0
+#endif
+
+namespace
+{
+    [[nodiscard]] std::filesystem::path absolute_path(const std::filesystem::path& file_path)
+    {
+        return std::filesystem::absolute(file_path).lexically_normal();
+    }
+
+    // missing files (halfway through a save) read as "no time", which counts as a change once they're back
+    [[nodiscard]] std::filesystem::file_time_type modification_time(const std::filesystem::path& file_path) noexcept
+    {
+        std::error_code error;
+        const auto      time = std::filesystem::last_write_time(file_path, error);
+        return error ? std::filesystem::file_time_type{} : time;
+    }
+}
+
+namespace OpenGL
+{
+    ShaderHotReload::ShaderHotReload([[maybe_unused]] bool allow_inotify, std::chrono::milliseconds poll_interval) : pollInterval(poll_interval)
+    {
+#if HAS_INOTIFY
+        if (allow_inotify)
+        {
+            inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        }
+#endif
+        lastPoll = std::chrono::steady_clock::now();
+    }
+
+    ShaderHotReload::~ShaderHotReload()
+    {
+        for (auto& program : programs)
+        {
+            DestroyShader(program.Compiled);
+        }
+#if HAS_INOTIFY
+        if (inotifyFd >= 0)
+        {
+            close(inotifyFd); // takes every watch with it
+        }
+#endif
+    }
+
+    ShaderHotReload::ProgramID ShaderHotReload::Add(const std::filesystem::path& vertex_filepath, const std::filesystem::path& fragment_filepath, ReloadCallback on_reload)
+    {
+        Program program{};
+        program.Vertex       = absolute_path(vertex_filepath);
+        program.Fragment     = absolute_path(fragment_filepath);
+        program.VertexTime   = modification_time(program.Vertex);
+        program.FragmentTime = modification_time(program.Fragment);
+        program.Compiled     = CreateShader(program.Vertex, program.Fragment);
+        program.OnReload     = std::move(on_reload);
+        if (program.OnReload)
+        {
+            program.OnReload(program.Compiled);
+        }
+        watch_directory_of(program.Vertex);
+        watch_directory_of(program.Fragment);
+        programs.push_back(std::move(program));
+        return programs.size() - 1;
+    }
+
+    int ShaderHotReload::Update()
+    {
+        if (IsUsingInotify())
+        {
+            read_inotify_events();
+        }
+        else
+        {
+            poll_modification_times();
+        }
+
+        int swapped = 0;
+        for (auto& program : programs)
+        {
+            if (program.Changed)
+            {
+                program.Changed = false;
+                swapped += reload(program) ? 1 : 0;
+            }
+        }
+        return swapped;
+    }
+
+    void ShaderHotReload::watch_directory_of([[maybe_unused]] const std::filesystem::path& file_path)
+    {
+#if HAS_INOTIFY
+        if (inotifyFd < 0)
+        {
+            return;
+        }
+        // IN_CLOSE_WRITE : saved in place, IN_MOVED_TO : saved as a temporary file then renamed over the old one
+        const auto directory  = file_path.parent_path();
+        const int  descriptor = inotify_add_watch(inotifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+        if (descriptor < 0)
+        {
+            // out of watches (fs.inotify.max_user_watches) or a filesystem without inotify : poll everything instead
+            std::cout << "can't watch " << directory.string() << " (" << std::strerror(errno) << "), polling shader files instead\n";
+            close(inotifyFd);
+            inotifyFd = -1;
+            watchedDirectories.clear();
+            return;
+        }
+        watchedDirectories[descriptor] = directory; // adding the same directory again gives the same descriptor
+#endif
+    }
+
+    void ShaderHotReload::read_inotify_events()
+    {
+#if HAS_INOTIFY
+        alignas(inotify_event) char buffer[4096];
+        while (true)
+        {
+            const auto length = read(inotifyFd, buffer, sizeof(buffer));
+            if (length <= 0)
+            {
+                return; // EAGAIN : nothing (more) happened, the usual case
+            }
+            for (std::size_t offset = 0; offset < static_cast<std::size_t>(length);)
+            {
+                inotify_event event{};
+                std::memcpy(&event, buffer + offset, sizeof(event));
+                const auto directory = watchedDirectories.find(event.wd);
+                if (directory != watchedDirectories.end() && event.len > 0)
+                {
+                    const auto changed = directory->second / std::string{ buffer + offset + sizeof(event) };
+                    for (auto& program : programs)
+                    {
+                        program.Changed = program.Changed || changed == program.Vertex || changed == program.Fragment;
+                    }
+                }
+                offset += sizeof(event) + event.len;
+            }
+        }
+#endif
+    }
+
+    void ShaderHotReload::poll_modification_times()
+    {
+        const auto now = std::chrono::steady_clock::now();
+        if (now - lastPoll < pollInterval)
+        {
+            return;
+        }
+        lastPoll = now;
+        for (auto& program : programs)
+        {
+            const auto vertex_time   = modification_time(program.Vertex);
+            const auto fragment_time = modification_time(program.Fragment);
+            program.Changed          = program.Changed || vertex_time != program.VertexTime || fragment_time != program.FragmentTime;
+            program.VertexTime       = vertex_time;
+            program.FragmentTime     = fragment_time;
+        }
+    }
+
+    bool ShaderHotReload::reload(Program& program)
+    {
+        try
+        {
+            // the new program gets fresh uniform tables, the old one stays bound until this works
+            auto fresh = CreateShader(program.Vertex, program.Fragment);
+            DestroyShader(program.Compiled);
+            program.Compiled = std::move(fresh);
+            if (program.OnReload)
+            {
+                program.OnReload(program.Compiled);
+            }
+            ++statistics.Reloads;
+            lastError.clear();
+            std::cout << "reloaded " << program.Vertex.filename().string() << " + " << program.Fragment.filename().string() << '\n';
+            return true;
+        }
+        catch (const std::exception& error)
+        {
+            ++statistics.Failures;
+            lastError = error.what();
+            std::cout << "reloading " << program.Vertex.filename().string() << " + " << program.Fragment.filename().string() << " failed, keeping the old program\n";
+            return false;
+        }
+    }
+}
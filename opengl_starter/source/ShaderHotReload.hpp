@@ -0,0 +1,99 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include "Shader.hpp"
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace OpenGL
+{
+    // Rebuilds programs made from shader files when the files change on disk, while the app keeps running.
+    // On Linux inotify tells us (one non-blocking read per Update() when nothing happened), everywhere else
+    // the modification times get compared every poll interval. Directories are watched rather than the files,
+    // so editors that save through a temporary file and a rename are seen too.
+    // A program that doesn't compile anymore is reported and the old one stays in use.
+    class ShaderHotReload
+    {
+    public:
+        using ProgramID = std::size_t;
+        // after a swap, for whatever has to be redone per program (FrameUniformBuffer::Attach...)
+        using ReloadCallback = std::function<void(CompiledShader&)>;
+
+        struct Statistics
+        {
+            int Reloads  = 0; // programs swapped
+            int Failures = 0; // changes that didn't compile, the old program was kept
+        };
+
+        explicit ShaderHotReload(bool allow_inotify = true, std::chrono::milliseconds poll_interval = std::chrono::milliseconds{ 500 });
+        ~ShaderHotReload();
+
+        ShaderHotReload(const ShaderHotReload&)            = delete;
+        ShaderHotReload& operator=(const ShaderHotReload&) = delete;
+
+        // compiles right away through CreateShader(path, path) and throws like it does, then watches both files
+        ProgramID Add(const std::filesystem::path& vertex_filepath, const std::filesystem::path& fragment_filepath, ReloadCallback on_reload = {});
+
+        // the newest program that compiled, only changes inside Update()
+        [[nodiscard]] CompiledShader& Get(ProgramID program)
+        {
+            return programs.at(program).Compiled;
+        }
+
+        // between frames, on the gl thread. Recompiles what changed and swaps what compiled, returns how many got swapped
+        int Update();
+
+        [[nodiscard]] bool IsUsingInotify() const noexcept
+        {
+            return inotifyFd >= 0;
+        }
+
+        [[nodiscard]] const Statistics& GetStatistics() const noexcept
+        {
+            return statistics;
+        }
+
+        // compile / link log of the last reload that failed, empty once a reload works again
+        [[nodiscard]] const std::string& GetLastError() const noexcept
+        {
+            return lastError;
+        }
+
+    private:
+        struct Program
+        {
+            CompiledShader                  Compiled{};
+            std::filesystem::path           Vertex{}; // absolute, so inotify names can be compared with them
+            std::filesystem::path           Fragment{};
+            std::filesystem::file_time_type VertexTime{};
+            std::filesystem::file_time_type FragmentTime{};
+            ReloadCallback                  OnReload{};
+            bool                            Changed = false;
+        };
+
+        void watch_directory_of(const std::filesystem::path& file_path);
+        void read_inotify_events();
+        void poll_modification_times();
+        bool reload(Program& program);
+
+    private:
+        std::vector<Program>                           programs{};
+        Statistics                                     statistics{};
+        std::string                                    lastError{};
+        int                                            inotifyFd = -1;
+        std::unordered_map<int, std::filesystem::path> watchedDirectories{}; // inotify watch descriptor -> directory
+        std::chrono::milliseconds                      pollInterval;
+        std::chrono::steady_clock::time_point          lastPoll{};
+    };
+}
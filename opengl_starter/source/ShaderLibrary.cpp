@@ -0,0 +1,243 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "ShaderLibrary.hpp"
+
+#include "Hash.hpp"
+#include <GL/glew.h>
+#include <iostream>
+#include <stdexcept>
+
+namespace
+{
+    [[nodiscard]] std::string program_info_log(OpenGL::ShaderHandle program)
+    {
+        GLint log_length = 0;
+        glGetProgramiv(program, GL_INFO_LOG_LENGTH, &log_length);
+        std::string error;
+        GLsizei     written = 0;
+        error.resize(static_cast<std::size_t>(log_length) + 1);
+        glGetProgramInfoLog(program, log_length, &written, error.data());
+        error.resize(static_cast<std::size_t>(written)); // no '\0's in what gets printed / thrown
+        return error;
+    }
+
+    [[nodiscard]] std::string shader_info_log(OpenGL::Handle shader)
+    {
+        GLint log_length = 0;
+        glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &log_length);
+        std::string error;
+        GLsizei     written = 0;
+        error.resize(static_cast<std::size_t>(log_length) + 1);
+        glGetShaderInfoLog(shader, log_length, &written, error.data());
+        error.resize(static_cast<std::size_t>(written)); // no '\0's in what gets printed / thrown
+        return error;
+    }
+}
+
+namespace OpenGL
+{
+    ShaderLibrary::ShaderLibrary()
+    {
+#if !defined(__EMSCRIPTEN__)
+        // 0xFFFFFFFF : let the driver pick how many threads it wants
+        if (GLEW_KHR_parallel_shader_compile)
+        {
+            glMaxShaderCompilerThreadsKHR(0xFFFFFFFFu);
+        }
+        else if (GLEW_ARB_parallel_shader_compile)
+        {
+            glMaxShaderCompilerThreadsARB(0xFFFFFFFFu);
+        }
+#endif
+    }
+
+    ShaderLibrary::~ShaderLibrary()
+    {
+        for (auto& program : programs)
+        {
+            DestroyShader(program.Compiled);
+        }
+        for (auto& [key, stage] : stages)
+        {
+            glDeleteShader(stage.Shader);
+        }
+    }
+
+    ShaderLibrary::ProgramID ShaderLibrary::Add(std::string_view vertex_source, std::string_view fragment_source)
+    {
+        Program program{};
+        program.VertexStage   = submit_stage(GL_VERTEX_SHADER, vertex_source);
+        program.FragmentStage = submit_stage(GL_FRAGMENT_SHADER, fragment_source);
+
+        // linking doesn't wait for the compiles to be done, the driver chains them
+        program.Compiled.Shader = glCreateProgram();
+        if (program.Compiled.Shader == 0)
+        {
+            throw std::runtime_error("Unable to create program\n");
+        }
+        program.Compiled.Program = AdoptProgram(program.Compiled.Shader);
+        glAttachShader(program.Compiled.Shader, stages.at(program.VertexStage).Shader);
+        glAttachShader(program.Compiled.Shader, stages.at(program.FragmentStage).Shader);
+        glLinkProgram(program.Compiled.Shader);
+
+        programs.push_back(std::move(program));
+        ++statistics.Programs;
+        return programs.size() - 1;
+    }
+
+    ShaderLibrary::ProgramID ShaderLibrary::Add(const std::filesystem::path& vertex_filepath, const std::filesystem::path& fragment_filepath)
+    {
+        // Add() copies the sources into the stages, so the arena can be reused by the next file load
+        arena.Reset();
+        const auto texts = ReadShaderFiles(vertex_filepath, fragment_filepath, arena);
+        return Add(texts[0], texts[1]);
+    }
+
+    const CompiledShader& ShaderLibrary::Get(ProgramID program)
+    {
+        auto& entry = programs.at(program);
+        if (!entry.Finished)
+        {
+            finish(entry);
+        }
+        return entry.Compiled;
+    }
+
+    bool ShaderLibrary::IsReady(ProgramID program) const
+    {
+        const auto& entry = programs.at(program);
+        if (entry.Finished)
+        {
+            return true;
+        }
+        if (!HasParallelCompile())
+        {
+            return false;
+        }
+        GLint is_complete = GL_FALSE;
+        glGetProgramiv(entry.Compiled.Shader, GL_COMPLETION_STATUS_KHR, &is_complete);
+        return is_complete != GL_FALSE;
+    }
+
+    int ShaderLibrary::FinishReady()
+    {
+        int finished = 0;
+        for (ProgramID id = 0; id < programs.size(); ++id)
+        {
+            if (!programs[id].Finished && IsReady(id))
+            {
+                finish(programs[id]);
+                ++finished;
+            }
+        }
+        return finished;
+    }
+
+    void ShaderLibrary::FinishAll()
+    {
+        for (auto& program : programs)
+        {
+            if (!program.Finished)
+            {
+                finish(program);
+            }
+        }
+    }
+
+    void ShaderLibrary::ReleaseStages()
+    {
+        // error reporting in finish() still wants the stages, so get that out of the way first
+        FinishAll();
+        for (auto& [key, stage] : stages)
+        {
+            glDeleteShader(stage.Shader);
+        }
+        stages.clear();
+    }
+
+    bool ShaderLibrary::HasParallelCompile() noexcept
+    {
+#if defined(__EMSCRIPTEN__)
+        return false;
+#else
+        return GLEW_KHR_parallel_shader_compile || GLEW_ARB_parallel_shader_compile;
+#endif
+    }
+
+    std::uint64_t ShaderLibrary::submit_stage(GLenum type, std::string_view source)
+    {
+        // the type is part of the key, same text as a vertex and a fragment shader are two different things
+        const char    type_tag = (type == GL_VERTEX_SHADER) ? 'v' : 'f';
+        std::uint64_t key      = Hash::FNV1a(source, Hash::FNV1a(std::string_view{ &type_tag, 1 }));
+        for (;; ++key)
+        {
+            const auto found = stages.find(key);
+            if (found == stages.end())
+            {
+                break;
+            }
+            if (found->second.Type == type && found->second.Source == source)
+            {
+                ++statistics.StagesShared;
+                return key;
+            }
+            // hash collision with a different source, try the next slot
+        }
+
+        Stage stage{};
+        stage.Shader = glCreateShader(type);
+        stage.Type   = type;
+        stage.Source = std::string{ source };
+        GLchar const* text[]{ stage.Source.c_str() };
+        glShaderSource(stage.Shader, 1, text, nullptr);
+        glCompileShader(stage.Shader);
+        stages.emplace(key, std::move(stage));
+        ++statistics.StagesCompiled;
+        return key;
+    }
+
+    void ShaderLibrary::finish(Program& program)
+    {
+        GLint is_linked = 0;
+        glGetProgramiv(program.Compiled.Shader, GL_LINK_STATUS, &is_linked);
+        if (is_linked == GL_FALSE)
+        {
+            // a failed compile is the more useful message, so look there first
+            for (const auto key : { program.VertexStage, program.FragmentStage })
+            {
+                if (const auto found = stages.find(key); found != stages.end())
+                {
+                    check_stage(found->second);
+                }
+            }
+            const auto error = program_info_log(program.Compiled.Shader);
+            std::cout << (error) << '\n';
+            throw std::runtime_error(error);
+        }
+        program.Compiled.UniformLocations = GetUniformLocations(program.Compiled.Shader);
+        program.Compiled.UniformSlots     = GetUniformSlots(program.Compiled.UniformLocations);
+        program.Finished                  = true;
+    }
+
+    void ShaderLibrary::check_stage(Stage& stage)
+    {
+        if (stage.Checked)
+        {
+            return;
+        }
+        GLint is_compiled = 0;
+        glGetShaderiv(stage.Shader, GL_COMPILE_STATUS, &is_compiled);
+        if (is_compiled == GL_FALSE)
+        {
+            const auto error = shader_info_log(stage.Shader);
+            std::cout << (error) << '\n' << stage.Source << '\n';
+            throw std::runtime_error(error);
+        }
+        stage.Checked = true;
+    }
+}
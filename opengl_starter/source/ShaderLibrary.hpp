@@ -0,0 +1,100 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include "FileLoader.hpp"
+#include "Handle.hpp"
+#include "Shader.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace OpenGL
+{
+    // Loads many programs without waiting on each one.
+    //
+    // Add() only hands the work to the driver (glCompileShader / glLinkProgram) and never asks for a status,
+    // so drivers with GL_KHR_parallel_shader_compile can compile everything on their own threads while we keep going.
+    // The status of a program is checked the first time it is asked for with Get(), which is the only place that can block.
+    // Identical stage sources are compiled once and the shader object is attached to every program that uses it.
+    class ShaderLibrary
+    {
+    public:
+        using ProgramID = std::size_t;
+
+        struct Statistics
+        {
+            int Programs       = 0;
+            int StagesCompiled = 0; // glCompileShader calls
+            int StagesShared   = 0; // stages that were already compiled for an earlier program
+        };
+
+        ShaderLibrary();
+        ~ShaderLibrary();
+
+        ShaderLibrary(const ShaderLibrary&)            = delete;
+        ShaderLibrary& operator=(const ShaderLibrary&) = delete;
+
+        ProgramID Add(std::string_view vertex_source, std::string_view fragment_source);
+        ProgramID Add(const std::filesystem::path& vertex_filepath, const std::filesystem::path& fragment_filepath);
+
+        // blocks the first time if the driver isn't done yet, throws if compiling or linking failed.
+        // The reference stays good after later Add() calls, programs never move
+        [[nodiscard]] const CompiledShader& Get(ProgramID program);
+
+        // true when Get() won't block. Without the parallel compile extension we can't tell, so only finished programs count
+        [[nodiscard]] bool IsReady(ProgramID program) const;
+
+        // finish whatever the driver already completed, never blocks. Returns how many programs got finished
+        int FinishReady();
+
+        // finish everything, blocking as needed
+        void FinishAll();
+
+        // shader objects are kept to share them with later Add() calls, release them once loading is over
+        void ReleaseStages();
+
+        [[nodiscard]] const Statistics& GetStatistics() const noexcept
+        {
+            return statistics;
+        }
+
+        [[nodiscard]] static bool HasParallelCompile() noexcept;
+
+    private:
+        struct Stage
+        {
+            Handle      Shader = 0;
+            GLenum      Type   = 0;
+            std::string Source{};
+            bool        Checked = false;
+        };
+
+        struct Program
+        {
+            CompiledShader Compiled{};
+            std::uint64_t  VertexStage   = 0;
+            std::uint64_t  FragmentStage = 0;
+            bool           Finished      = false;
+        };
+
+        std::uint64_t submit_stage(GLenum type, std::string_view source);
+        void          finish(Program& program);
+        void          check_stage(Stage& stage);
+
+    private:
+        std::unordered_map<std::uint64_t, Stage> stages{};
+        std::deque<Program>                      programs{}; // a deque so Add() doesn't move what Get() handed out
+        Statistics                               statistics{};
+        FileArena                                arena{}; // stage files of the Add() in progress
+    };
+}
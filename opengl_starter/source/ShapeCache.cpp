@@ -0,0 +1,179 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "ShapeCache.hpp"
+
+#include "FrameCapture.hpp"
+#include "GLState.hpp"
+#include "Hash.hpp"
+#include "Profiler.hpp"
+#include "VertexLayout.hpp"
+#include <gsl/gsl>
+#include <stdexcept>
+#include <string_view>
+
+namespace
+{
+    // FNV-1a over the raw bytes, every field hashed is a float, an int or a bool so there's no padding in there
+    template <typename T>
+    [[nodiscard]] std::uint64_t hash_bytes(const T* data, std::size_t count, std::uint64_t seed) noexcept
+    {
+        return Hash::FNV1a(std::string_view{ reinterpret_cast<const char*>(data), count * sizeof(T) }, seed);
+    }
+
+    template <typename T>
+    [[nodiscard]] std::uint64_t hash_value(const T& value, std::uint64_t seed) noexcept
+    {
+        return hash_bytes(&value, 1, seed);
+    }
+
+    [[nodiscard]] std::uint64_t hash_shape(const OpenGL::RoundedRect& rect, std::uint64_t seed) noexcept
+    {
+        const std::array fields{ rect.Width, rect.Height, rect.Radius };
+        return hash_value(rect.Color, hash_value(fields, seed));
+    }
+
+    [[nodiscard]] std::uint64_t hash_shape(const OpenGL::Circle& circle, std::uint64_t seed) noexcept
+    {
+        return hash_value(circle.Color, hash_value(circle.Radius, seed));
+    }
+
+    [[nodiscard]] std::uint64_t hash_shape(const OpenGL::Polyline& line, std::uint64_t seed) noexcept
+    {
+        // the points themselves, not where they are stored
+        seed = hash_bytes(line.Points.data(), line.Points.size(), seed);
+        seed = hash_value(line.Thickness, seed);
+        seed = hash_value(line.Closed, seed);
+        return hash_value(line.Color, seed);
+    }
+
+    // every parameter that ends up in the geometry, flattened. Equal fields : same triangles
+    void append_fields(const OpenGL::RoundedRect& rect, std::vector<float>& fields)
+    {
+        fields.insert(fields.end(), { rect.Width, rect.Height, rect.Radius });
+        fields.insert(fields.end(), rect.Color.begin(), rect.Color.end());
+    }
+
+    void append_fields(const OpenGL::Circle& circle, std::vector<float>& fields)
+    {
+        fields.push_back(circle.Radius);
+        fields.insert(fields.end(), circle.Color.begin(), circle.Color.end());
+    }
+
+    void append_fields(const OpenGL::Polyline& line, std::vector<float>& fields)
+    {
+        // the point count is in the size, every other field is always there
+        for (const auto& point : line.Points)
+        {
+            fields.insert(fields.end(), point.begin(), point.end());
+        }
+        fields.insert(fields.end(), { line.Thickness, line.Closed ? 1.0f : 0.0f });
+        fields.insert(fields.end(), line.Color.begin(), line.Color.end());
+    }
+
+    void shape_fields(const OpenGL::Shape& shape, int segments, std::vector<float>& fields)
+    {
+        fields.clear();
+        fields.insert(fields.end(), { static_cast<float>(shape.index()), static_cast<float>(segments) });
+        std::visit([&fields](const auto& s) { append_fields(s, fields); }, shape);
+    }
+}
+
+namespace OpenGL
+{
+    std::uint64_t HashShape(const Shape& shape, int segments) noexcept
+    {
+        std::uint64_t seed = hash_value(shape.index(), Hash::FNV1aOffset);
+        seed               = hash_value(segments, seed);
+        return std::visit([seed](const auto& s) { return hash_shape(s, seed); }, shape);
+    }
+
+    ShapeCache::ShapeCache(std::size_t max_vertices, std::size_t max_indices) : maxVertices(max_vertices), maxIndices(max_indices)
+    {
+        vertexBuffer = CreateBuffer(GL_ARRAY_BUFFER, maxVertices * sizeof(Vertex), nullptr, GL_DYNAMIC_DRAW);
+        indexBuffer  = CreateBuffer(GL_ELEMENT_ARRAY_BUFFER, maxIndices * sizeof(std::uint32_t), nullptr, GL_DYNAMIC_DRAW);
+        vertexArray  = CreateVertexArray();
+        BindVertexArray(vertexArray.Get());
+        BindBuffer(GL_ARRAY_BUFFER, vertexBuffer.Get());
+        BindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer.Get());
+        DescribeVertexLayout(GetVertexLayout(VertexFormat::Float));
+    }
+
+    ShapeCache::Range ShapeCache::Get(const Shape& shape, int segments)
+    {
+        const auto key = HashShape(shape, segments);
+        shape_fields(shape, segments, fields);
+        const auto [first, last] = ranges.equal_range(key);
+        for (auto found = first; found != last; ++found)
+        {
+            if (found->second.Fields == fields)
+            {
+                ++statistics.Hits;
+                return found->second.Cached;
+            }
+        }
+
+        PROFILE_SCOPE("tessellate shape");
+        scratch.Vertices.clear();
+        scratch.Indices.clear();
+        Tessellate(shape, segments, scratch);
+        if (scratch.Vertices.size() > maxVertices || scratch.Indices.size() > maxIndices)
+        {
+            throw std::length_error("shape has more vertices or indices than the whole ShapeCache");
+        }
+        if (vertexCount + scratch.Vertices.size() > maxVertices || indexCount + scratch.Indices.size() > maxIndices)
+        {
+            Clear();
+            ++statistics.Flushes;
+        }
+
+        // the indices point into the shared vertex buffer
+        const auto base = gsl::narrow<std::uint32_t>(vertexCount);
+        for (auto& index : scratch.Indices)
+        {
+            index += base;
+        }
+        const std::size_t vertex_bytes = scratch.Vertices.size() * sizeof(Vertex);
+        const std::size_t index_bytes  = scratch.Indices.size() * sizeof(std::uint32_t);
+        BindBuffer(GL_ARRAY_BUFFER, vertexBuffer.Get());
+        BufferSubData(GL_ARRAY_BUFFER, gsl::narrow<GLintptr>(vertexCount * sizeof(Vertex)), gsl::narrow<GLsizeiptr>(vertex_bytes), scratch.Vertices.data());
+        // our own VAO already holds the index buffer, binding it is enough to write to it
+        BindVertexArray(vertexArray.Get());
+        BindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer.Get());
+        BufferSubData(GL_ELEMENT_ARRAY_BUFFER, gsl::narrow<GLintptr>(indexCount * sizeof(std::uint32_t)), gsl::narrow<GLsizeiptr>(index_bytes), scratch.Indices.data());
+
+        const Range range{ indexCount, gsl::narrow<GLsizei>(scratch.Indices.size()), segments, generation };
+        vertexCount += scratch.Vertices.size();
+        indexCount += scratch.Indices.size();
+        ++statistics.Misses;
+        statistics.BytesUploaded += vertex_bytes + index_bytes;
+        ranges.emplace(key, Entry{ fields, range });
+        return range;
+    }
+
+    void ShapeCache::Draw(const Range& range) const
+    {
+        if (range.IndexCount == 0)
+        {
+            return;
+        }
+        BindVertexArray(vertexArray.Get());
+        const auto offset = range.FirstIndex * sizeof(std::uint32_t);
+        DrawElements(GL_TRIANGLES, range.IndexCount, GL_UNSIGNED_INT, offset);
+    }
+
+    void ShapeCache::Clear() noexcept
+    {
+        ranges.clear();
+        vertexCount = 0;
+        indexCount  = 0;
+        if (++generation == 0)
+        {
+            generation = 1; // 0 is what a Range that was never filled has
+        }
+    }
+}
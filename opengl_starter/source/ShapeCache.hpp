@@ -0,0 +1,105 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include "GpuResources.hpp"
+#include "ShapeTessellator.hpp"
+#include <GL/glew.h>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace OpenGL
+{
+    // Tessellated shapes kept on the gpu, looked up by what they are rather than by who asked.
+    // The key is a hash of the shape's parameters, color and segment count, so a thousand copies of the same
+    // button share one tessellation. The parameters are kept too and compared on a hit, two shapes whose hashes
+    // collide get a tessellation each instead of one drawing the other. All of them live in one vertex buffer and one index buffer behind one VAO
+    // (Vertex layout, 32 bit indices already offset to where their vertices landed), filled front to back.
+    // When either buffer is full everything is dropped and the shapes are made again as they are asked for.
+    //
+    // Get() costs a hash and a lookup, tessellating and uploading only happen on a miss. Callers that keep the
+    // Range and check IsCurrent() skip even that, an unchanged shape then costs nothing but its draw.
+    class ShapeCache
+    {
+    public:
+        struct Range
+        {
+            std::size_t   FirstIndex = 0;
+            GLsizei       IndexCount = 0;
+            int           Segments   = 0; // what it was tessellated with
+            std::uint32_t Generation = 0; // of the cache when it was made, see IsCurrent()
+        };
+
+        struct Statistics
+        {
+            int         Hits          = 0;
+            int         Misses        = 0; // tessellated and uploaded
+            std::size_t BytesUploaded = 0;
+            int         Flushes       = 0; // times the buffers filled up and everything was dropped
+        };
+
+        explicit ShapeCache(std::size_t max_vertices = 1u << 20u, std::size_t max_indices = 3u << 20u);
+
+        ShapeCache(const ShapeCache&)            = delete;
+        ShapeCache& operator=(const ShapeCache&) = delete;
+
+        // segments as ShapeSegments() picks them. Throws std::length_error if the shape alone doesn't fit
+        [[nodiscard]] Range Get(const Shape& shape, int segments);
+
+        // false once the buffers were flushed since range was made, Get() it again
+        [[nodiscard]] bool IsCurrent(const Range& range) const noexcept
+        {
+            return range.Generation == generation;
+        }
+
+        // binds the VAO and draws range with whatever program is in use, the face shader works (uModel + uToNDC)
+        void Draw(const Range& range) const;
+        void Clear() noexcept;
+
+        [[nodiscard]] std::size_t GetShapeCount() const noexcept
+        {
+            return ranges.size();
+        }
+
+        [[nodiscard]] std::size_t GetVertexCount() const noexcept
+        {
+            return vertexCount;
+        }
+
+        [[nodiscard]] Statistics& GetStatistics() noexcept
+        {
+            return statistics;
+        }
+
+    private:
+        struct Entry
+        {
+            std::vector<float> Fields{}; // what the shape is, see shape_fields()
+            Range              Cached{};
+        };
+
+    private:
+        std::size_t                                   maxVertices = 0;
+        std::size_t                                   maxIndices  = 0;
+        BufferHandle                                  vertexBuffer{};
+        BufferHandle                                  indexBuffer{};
+        VertexArrayHandle                             vertexArray{};
+        std::unordered_multimap<std::uint64_t, Entry> ranges{};
+        std::vector<float>                            fields{}; // of the shape being looked up
+        ShapeGeometry                                 scratch{};
+        std::size_t                                   vertexCount = 0;
+        std::size_t                                   indexCount  = 0;
+        std::uint32_t                                 generation  = 1;
+        Statistics                                    statistics{};
+    };
+
+    // what ShapeCache keys a shape with
+    [[nodiscard]] std::uint64_t HashShape(const Shape& shape, int segments) noexcept;
+}
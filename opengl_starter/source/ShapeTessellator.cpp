@@ -0,0 +1,190 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "ShapeTessellator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+namespace
+{
+    constexpr float miter_limit = 4.0f; // in half thicknesses
+
+    [[nodiscard]] std::uint32_t next_index(const OpenGL::ShapeGeometry& geometry) noexcept
+    {
+        return static_cast<std::uint32_t>(geometry.Vertices.size());
+    }
+
+    void add_vertex(OpenGL::ShapeGeometry& geometry, float x, float y, const OpenGL::Color3& color)
+    {
+        geometry.Vertices.push_back(OpenGL::Vertex{ x, y, color[0], color[1], color[2] });
+    }
+
+    // triangles from the first vertex to every pair of rim vertices after it, the rim goes around once
+    void add_fan(OpenGL::ShapeGeometry& geometry, std::uint32_t center, std::uint32_t rim_count)
+    {
+        for (std::uint32_t i = 0; i < rim_count; ++i)
+        {
+            geometry.Indices.insert(geometry.Indices.end(), { center, center + 1 + i, center + 1 + (i + 1) % rim_count });
+        }
+    }
+
+    void tessellate(const OpenGL::Circle& circle, int segments, OpenGL::ShapeGeometry& geometry)
+    {
+        const auto center = next_index(geometry);
+        const auto count  = static_cast<std::uint32_t>(std::max(segments, 3));
+        add_vertex(geometry, 0.0f, 0.0f, circle.Color);
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            const float angle = 2.0f * std::numbers::pi_v<float> * static_cast<float>(i) / static_cast<float>(count);
+            add_vertex(geometry, circle.Radius * std::cos(angle), circle.Radius * std::sin(angle), circle.Color);
+        }
+        add_fan(geometry, center, count);
+    }
+
+    void tessellate(const OpenGL::RoundedRect& rect, int segments, OpenGL::ShapeGeometry& geometry)
+    {
+        const float half_w = 0.5f * rect.Width;
+        const float half_h = 0.5f * rect.Height;
+        const float radius = std::clamp(rect.Radius, 0.0f, std::min(half_w, half_h));
+        const auto  center = next_index(geometry);
+        add_vertex(geometry, 0.0f, 0.0f, rect.Color);
+        if (radius <= 0.0f)
+        {
+            for (const auto [x, y] : { std::array{ half_w, half_h }, std::array{ -half_w, half_h }, std::array{ -half_w, -half_h }, std::array{ half_w, -half_h } })
+            {
+                add_vertex(geometry, x, y, rect.Color);
+            }
+            add_fan(geometry, center, 4);
+            return;
+        }
+
+        // a quarter circle per corner, counter clockwise from the top right one
+        const int                                 steps = std::max(segments / 4, 1);
+        const std::array<std::array<float, 2>, 4> corners{ { { half_w - radius, half_h - radius },
+                                                             { -half_w + radius, half_h - radius },
+                                                             { -half_w + radius, -half_h + radius },
+                                                             { half_w - radius, -half_h + radius } } };
+        for (std::size_t corner = 0; corner < corners.size(); ++corner)
+        {
+            for (int step = 0; step <= steps; ++step)
+            {
+                const float angle = 0.5f * std::numbers::pi_v<float> * (static_cast<float>(corner) + static_cast<float>(step) / static_cast<float>(steps));
+                add_vertex(geometry, corners[corner][0] + radius * std::cos(angle), corners[corner][1] + radius * std::sin(angle), rect.Color);
+            }
+        }
+        add_fan(geometry, center, static_cast<std::uint32_t>(4 * (steps + 1)));
+    }
+
+    void tessellate(const OpenGL::Polyline& line, int, OpenGL::ShapeGeometry& geometry)
+    {
+        const auto& points = line.Points;
+        const auto  count  = points.size();
+        if (count < 2)
+        {
+            return;
+        }
+        const float half = 0.5f * line.Thickness;
+
+        // unit normal of the segment from a to b
+        const auto normal = [&](std::size_t a, std::size_t b)
+        {
+            const float dx     = points[b][0] - points[a][0];
+            const float dy     = points[b][1] - points[a][1];
+            const float length = std::max(std::sqrt(dx * dx + dy * dy), 1e-12f);
+            return std::array{ -dy / length, dx / length };
+        };
+
+        // two vertices per point, pushed out along the miter of the segments on both sides
+        const auto first = next_index(geometry);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const bool  has_before = line.Closed || i > 0;
+            const bool  has_after  = line.Closed || i + 1 < count;
+            const auto  before     = has_before ? normal((i + count - 1) % count, i) : normal(i, i + 1);
+            const auto  after      = has_after ? normal(i, (i + 1) % count) : before;
+            float       mx         = before[0] + after[0];
+            float       my         = before[1] + after[1];
+            const float length     = std::sqrt(mx * mx + my * my);
+            float       extent     = half;
+            if (length > 1e-6f)
+            {
+                mx /= length;
+                my /= length;
+                // the miter gets longer as the turn gets sharper, 1 / cos of half the turn
+                extent = half / std::max(mx * after[0] + my * after[1], 1.0f / miter_limit);
+            }
+            else
+            {
+                // the line goes straight back, no miter to speak of
+                mx = after[0];
+                my = after[1];
+            }
+            add_vertex(geometry, points[i][0] + mx * extent, points[i][1] + my * extent, line.Color);
+            add_vertex(geometry, points[i][0] - mx * extent, points[i][1] - my * extent, line.Color);
+        }
+
+        const std::size_t segments = line.Closed ? count : count - 1;
+        for (std::size_t i = 0; i < segments; ++i)
+        {
+            const auto a = first + static_cast<std::uint32_t>(2 * i);
+            const auto b = first + static_cast<std::uint32_t>(2 * ((i + 1) % count));
+            geometry.Indices.insert(geometry.Indices.end(), { a, a + 1, b + 1, a, b + 1, b });
+        }
+    }
+}
+
+namespace OpenGL
+{
+    int SegmentsForRadius(float radius_pixels, float tolerance_pixels) noexcept
+    {
+        // a chord of a circle of radius r spanning an angle a is r * (1 - cos(a / 2)) away from the curve at most
+        if (!(radius_pixels > tolerance_pixels))
+        {
+            return MinShapeSegments;
+        }
+        const float step = 2.0f * std::acos(1.0f - tolerance_pixels / radius_pixels);
+        if (!(step > 0.0f))
+        {
+            return MaxShapeSegments; // a radius of millions of pixels rounds the step down to 0
+        }
+        // clamped while it's still a float, the count can be far past what an int holds
+        const float segments = std::min(std::ceil(2.0f * std::numbers::pi_v<float> / step), static_cast<float>(MaxShapeSegments));
+        return std::clamp((static_cast<int>(segments) + 3) / 4 * 4, MinShapeSegments, MaxShapeSegments);
+    }
+
+    float PixelsPerUnit(const Math::mat3& to_ndc, const Math::mat3& model, int viewport_width, int viewport_height) noexcept
+    {
+        // NDC is 2 units across the viewport
+        const auto  m      = Math::Multiply(to_ndc, model);
+        const float half_w = 0.5f * static_cast<float>(viewport_width);
+        const float half_h = 0.5f * static_cast<float>(viewport_height);
+        const float x_axis = std::sqrt(m[0] * half_w * m[0] * half_w + m[1] * half_h * m[1] * half_h);
+        const float y_axis = std::sqrt(m[3] * half_w * m[3] * half_w + m[4] * half_h * m[4] * half_h);
+        return std::max(x_axis, y_axis);
+    }
+
+    int ShapeSegments(const Shape& shape, float pixels_per_unit, float tolerance_pixels) noexcept
+    {
+        if (const auto* circle = std::get_if<Circle>(&shape))
+        {
+            return SegmentsForRadius(circle->Radius * pixels_per_unit, tolerance_pixels);
+        }
+        if (const auto* rect = std::get_if<RoundedRect>(&shape); rect != nullptr && rect->Radius > 0.0f)
+        {
+            const float radius = std::min({ rect->Radius, 0.5f * rect->Width, 0.5f * rect->Height });
+            return SegmentsForRadius(radius * pixels_per_unit, tolerance_pixels);
+        }
+        return 0;
+    }
+
+    void Tessellate(const Shape& shape, int segments, ShapeGeometry& geometry)
+    {
+        std::visit([&](const auto& s) { tessellate(s, segments, geometry); }, shape);
+    }
+}
@@ -0,0 +1,70 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include "Math.hpp"
+#include "Vertex.hpp"
+#include <array>
+#include <cstdint>
+#include <span>
+#include <variant>
+#include <vector>
+
+namespace OpenGL
+{
+    // Procedural 2D shapes turned into triangles, in their own units centered on (0,0).
+    // Like the face mesh, the model matrix places and scales them, so one tessellation serves every copy
+    // of the same shape. Curves get as many segments as their size on screen needs (ShapeSegments()).
+    using Color3 = std::array<float, 3>;
+
+    struct RoundedRect
+    {
+        float  Width  = 1.0f;
+        float  Height = 1.0f;
+        float  Radius = 0.0f; // of the corners, clamped to half the shortest side. 0 : a plain rectangle
+        Color3 Color{ 1.0f, 1.0f, 1.0f };
+    };
+
+    struct Circle
+    {
+        float  Radius = 0.5f;
+        Color3 Color{ 1.0f, 1.0f, 1.0f };
+    };
+
+    // a thick line through Points with mitered joins, a miter longer than 4 half thicknesses is cut short.
+    // The points aren't copied, they have to outlive the shape
+    struct Polyline
+    {
+        std::span<const std::array<float, 2>> Points{};
+        float                                 Thickness = 0.1f;
+        bool                                  Closed    = false; // last point joins the first one
+        Color3                                Color{ 1.0f, 1.0f, 1.0f };
+    };
+
+    using Shape = std::variant<RoundedRect, Circle, Polyline>;
+
+    struct ShapeGeometry
+    {
+        std::vector<Vertex>        Vertices{};
+        std::vector<std::uint32_t> Indices{}; // triangles, from the first vertex of Vertices
+    };
+
+    constexpr int MinShapeSegments = 8;
+    constexpr int MaxShapeSegments = 256;
+
+    // segments for a whole circle of radius_pixels on screen, so no chord is further than tolerance_pixels
+    // from the true curve. Multiples of 4 (a rounded rect gives a quarter to each corner), between Min and MaxShapeSegments
+    [[nodiscard]] int SegmentsForRadius(float radius_pixels, float tolerance_pixels = 0.25f) noexcept;
+    // how many pixels one unit of the shape covers once drawn through to_ndc * model, the bigger of the two axes
+    [[nodiscard]] float PixelsPerUnit(const Math::mat3& to_ndc, const Math::mat3& model, int viewport_width, int viewport_height) noexcept;
+    // what to tessellate shape with when one of its units covers pixels_per_unit pixels. 0 for shapes without curves
+    [[nodiscard]] int ShapeSegments(const Shape& shape, float pixels_per_unit, float tolerance_pixels = 0.25f) noexcept;
+
+    // appends the triangles of shape to geometry. segments is for a full turn, like ShapeSegments() returns it
+    void Tessellate(const Shape& shape, int segments, ShapeGeometry& geometry);
+}
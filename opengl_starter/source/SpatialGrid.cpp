@@ -0,0 +1,197 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "SpatialGrid.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+    // two signed 32 bit cell coordinates in one key
+    [[nodiscard]] constexpr std::uint64_t cell_key(std::int32_t x, std::int32_t y) noexcept
+    {
+        return (std::uint64_t{ static_cast<std::uint32_t>(x) } << 32) | static_cast<std::uint32_t>(y);
+    }
+
+    [[nodiscard]] std::int32_t cell_coordinate(float world, float inverse_cell_size) noexcept
+    {
+        return static_cast<std::int32_t>(std::floor(world * inverse_cell_size));
+    }
+}
+
+namespace Spatial
+{
+    Rect VisibleRect(const Math::mat3& world_to_ndc) noexcept
+    {
+        constexpr float infinity     = std::numeric_limits<float>::infinity();
+        const auto      ndc_to_world = Math::AffineInverse(world_to_ndc);
+        Rect            visible{ infinity, infinity, -infinity, -infinity };
+        // all four corners, the camera could be rotated
+        for (const auto& [x, y] : { std::array{ -1.0f, -1.0f }, std::array{ 1.0f, -1.0f }, std::array{ 1.0f, 1.0f }, std::array{ -1.0f, 1.0f } })
+        {
+            const auto corner = Math::TransformPoint(ndc_to_world, x, y);
+            visible.Left      = std::min(visible.Left, corner[0]);
+            visible.Right     = std::max(visible.Right, corner[0]);
+            visible.Bottom    = std::min(visible.Bottom, corner[1]);
+            visible.Top       = std::max(visible.Top, corner[1]);
+        }
+        return visible;
+    }
+
+    LooseGrid::LooseGrid(float cell_size) : cellSize(cell_size), inverseCellSize(1.0f / cell_size)
+    {
+        if (!(cell_size > 0.0f))
+        {
+            throw std::invalid_argument("LooseGrid cell size has to be positive");
+        }
+    }
+
+    LooseGrid::ObjectID LooseGrid::Insert(const Rect& bounds)
+    {
+        ObjectID object = 0;
+        if (freeIDs.empty())
+        {
+            object = static_cast<ObjectID>(objects.size());
+            objects.emplace_back();
+        }
+        else
+        {
+            object = freeIDs.back();
+            freeIDs.pop_back();
+        }
+        add(object, bounds, place(bounds));
+        return object;
+    }
+
+    void LooseGrid::Move(ObjectID object, const Rect& bounds)
+    {
+        const auto& entry     = live_object(object);
+        const auto  placement = place(bounds);
+        if (placement.Cell == entry.Cell && placement.Oversized == entry.Oversized)
+        {
+            list_of(entry)[entry.Slot].Bounds = bounds;
+            return;
+        }
+        remove_from_list(object);
+        add(object, bounds, placement);
+        ++statistics.CellChanges;
+    }
+
+    void LooseGrid::Remove(ObjectID object)
+    {
+        remove_from_list(object); // throws for an id that was already removed, so it can't go on freeIDs twice
+        objects[object].Live = false;
+        freeIDs.push_back(object);
+    }
+
+    void LooseGrid::Query(const Rect& area, std::vector<ObjectID>& found)
+    {
+        const auto check = [&](const std::vector<Entry>& candidates)
+        {
+            statistics.Candidates += candidates.size();
+            for (const auto& candidate : candidates)
+            {
+                if (Overlaps(candidate.Bounds, area))
+                {
+                    found.push_back(candidate.Object);
+                }
+            }
+        };
+
+        check(oversized);
+        // an object's center is at most half a cell outside of the cell it's in
+        const float        margin = 0.5f * cellSize;
+        const std::int32_t left   = cell_coordinate(area.Left - margin, inverseCellSize);
+        const std::int32_t right  = cell_coordinate(area.Right + margin, inverseCellSize);
+        const std::int32_t bottom = cell_coordinate(area.Bottom - margin, inverseCellSize);
+        const std::int32_t top    = cell_coordinate(area.Top + margin, inverseCellSize);
+        for (std::int32_t y = bottom; y <= top; ++y)
+        {
+            for (std::int32_t x = left; x <= right; ++x)
+            {
+                ++statistics.CellsVisited;
+                const auto cell = cells.find(cell_key(x, y));
+                if (cell != cells.end())
+                {
+                    check(lists[cell->second]);
+                }
+            }
+        }
+    }
+
+    LooseGrid::Placement LooseGrid::place(const Rect& bounds) const noexcept
+    {
+        if (bounds.Right - bounds.Left > cellSize || bounds.Top - bounds.Bottom > cellSize)
+        {
+            return Placement{ 0, true };
+        }
+        const float center_x = 0.5f * (bounds.Left + bounds.Right);
+        const float center_y = 0.5f * (bounds.Bottom + bounds.Top);
+        return Placement{ cell_key(cell_coordinate(center_x, inverseCellSize), cell_coordinate(center_y, inverseCellSize)), false };
+    }
+
+    const Rect& LooseGrid::GetBounds(ObjectID object) const
+    {
+        const auto& entry = live_object(object);
+        return list_of(entry)[entry.Slot].Bounds;
+    }
+
+    const LooseGrid::Object& LooseGrid::live_object(ObjectID object) const
+    {
+        const auto& entry = objects.at(object);
+        if (!entry.Live)
+        {
+            throw std::out_of_range("LooseGrid object " + std::to_string(object) + " was removed");
+        }
+        return entry;
+    }
+
+    void LooseGrid::add(ObjectID object, const Rect& bounds, Placement placement)
+    {
+        auto& entry     = objects[object];
+        entry.Cell      = placement.Cell;
+        entry.Oversized = placement.Oversized;
+        entry.Live      = true;
+        if (!placement.Oversized)
+        {
+            // new cells get the next list
+            const auto [cell, added] = cells.try_emplace(placement.Cell, static_cast<std::uint32_t>(lists.size()));
+            if (added)
+            {
+                lists.emplace_back();
+            }
+            entry.List = cell->second;
+        }
+        auto& list = list_of(entry);
+        entry.Slot      = static_cast<std::uint32_t>(list.size());
+        list.push_back(Entry{ bounds, object });
+    }
+
+    void LooseGrid::remove_from_list(ObjectID object)
+    {
+        const auto& entry = live_object(object);
+        auto&       list  = list_of(entry);
+        // swap remove, the last one takes the slot
+        list[entry.Slot]                      = list.back();
+        objects[list[entry.Slot].Object].Slot = entry.Slot;
+        list.pop_back(); // empty cells stay around with their capacity, things tend to come back
+    }
+
+    std::vector<LooseGrid::Entry>& LooseGrid::list_of(const Object& object)
+    {
+        return object.Oversized ? oversized : lists[object.List];
+    }
+
+    const std::vector<LooseGrid::Entry>& LooseGrid::list_of(const Object& object) const
+    {
+        return object.Oversized ? oversized : lists[object.List];
+    }
+}
@@ -0,0 +1,116 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include "Math.hpp"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Spatial
+{
+    // axis aligned box in world units
+    struct Rect
+    {
+        float Left   = 0.0f;
+        float Bottom = 0.0f;
+        float Right  = 0.0f;
+        float Top    = 0.0f;
+    };
+
+    [[nodiscard]] constexpr bool Overlaps(const Rect& a, const Rect& b) noexcept
+    {
+        return a.Left <= b.Right && b.Left <= a.Right && a.Bottom <= b.Top && b.Bottom <= a.Top;
+    }
+
+    // the part of the world that lands inside NDC [-1,1] : the screen corners through the inverse of world_to_ndc
+    [[nodiscard]] Rect VisibleRect(const Math::mat3& world_to_ndc) noexcept;
+
+    // Loose hashed grid : each object sits in the one cell its center falls in, and queries look half a cell
+    // further out to catch the ones that hang over the edge. Moving an object is a compare when it stays
+    // in its cell and a swap remove + push back when it doesn't, nothing gets rebuilt.
+    // Only cells with something in them exist, so the world can be any size and a query costs about
+    // the same however many objects are outside of it. Objects bigger than a cell go in a list every query checks.
+    class LooseGrid
+    {
+    public:
+        using ObjectID = std::uint32_t;
+
+        struct Statistics
+        {
+            std::uint64_t CellsVisited = 0; // by Query(), empty ones included
+            std::uint64_t Candidates   = 0; // objects whose bounds got compared
+            std::uint64_t CellChanges  = 0; // Move() calls that changed cells
+        };
+
+        // a bit bigger than the typical object, see the comment above
+        explicit LooseGrid(float cell_size);
+
+        ObjectID Insert(const Rect& bounds);
+        void     Move(ObjectID object, const Rect& bounds);
+        // the id gets reused by a later Insert(). Move(), Remove() and GetBounds() on a removed id throw std::out_of_range
+        void Remove(ObjectID object);
+
+        // appends every object overlapping area to found, each once and in no particular order
+        void Query(const Rect& area, std::vector<ObjectID>& found);
+
+        [[nodiscard]] const Rect& GetBounds(ObjectID object) const;
+
+        [[nodiscard]] std::size_t GetObjectCount() const noexcept
+        {
+            return objects.size() - freeIDs.size();
+        }
+
+        // reset with GetStatistics() = {}
+        [[nodiscard]] Statistics& GetStatistics() noexcept
+        {
+            return statistics;
+        }
+
+    private:
+        // bounds live in the cell lists, a query only reads the cells it visits
+        struct Entry
+        {
+            Rect     Bounds{};
+            ObjectID Object = 0;
+        };
+
+        struct Object
+        {
+            std::uint64_t Cell      = 0;     // key of the cell its center is in
+            std::uint32_t List      = 0;     // index into lists, so moving inside a cell doesn't hash anything
+            std::uint32_t Slot      = 0;     // where it is in that list
+            bool          Oversized = false; // in oversized instead of a cell
+            bool          Live      = false; // false once removed, until Insert() hands the id out again
+        };
+
+        struct Placement
+        {
+            std::uint64_t Cell      = 0;
+            bool          Oversized = false;
+        };
+
+        // objects.at(object) that also throws std::out_of_range for a removed id
+        [[nodiscard]] const Object& live_object(ObjectID object) const;
+        [[nodiscard]] Placement place(const Rect& bounds) const noexcept;
+        void                    add(ObjectID object, const Rect& bounds, Placement placement);
+        [[nodiscard]] std::vector<Entry>&       list_of(const Object& object);
+        [[nodiscard]] const std::vector<Entry>& list_of(const Object& object) const;
+        void                    remove_from_list(ObjectID object);
+
+    private:
+        float                                                 cellSize;
+        float                                                 inverseCellSize;
+        std::unordered_map<std::uint64_t, std::uint32_t>      cells{}; // cell key -> index into lists, only cells something was ever in
+        std::vector<std::vector<Entry>>                       lists{};
+        std::vector<Entry>                                    oversized{};
+        std::vector<Object>                                   objects{};
+        std::vector<ObjectID>                                 freeIDs{};
+        Statistics                                            statistics{};
+    };
+}
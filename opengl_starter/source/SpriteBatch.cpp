@@ -0,0 +1,153 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "SpriteBatch.hpp"
+
+#include "FrameCapture.hpp"
+#include "GLState.hpp"
+#include "Profiler.hpp"
+#include <GL/glew.h>
+#include <algorithm>
+#include <cstddef>
+#include <gsl/gsl>
+#include <span>
+#include <string>
+
+namespace
+{
+    // 0,1,2,3 -> (0,0) (1,0) (0,1) (1,1), a triangle strip over the unit quad
+    constexpr auto sprite_vertex_header = R"(#version 300 es
+layout(location = 0) in mat3 aModel;
+layout(location = 3) in vec4 aTexRect;
+layout(location = 4) in vec4 aColor;
+)";
+
+    constexpr auto sprite_vertex_body = R"(out vec2 vTexCoord;
+out vec4 vColor;
+void main()
+{
+    vec2 corner = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1));
+    vec3 ndc_position = uToNDC * (aModel * vec3(corner - 0.5, 1.0));
+    gl_Position = vec4(ndc_position.xy, 0.0, 1.0);
+    vTexCoord = mix(aTexRect.xy, aTexRect.zw, corner);
+    vColor = aColor;
+}
+)";
+
+    constexpr auto sprite_fragment_glsl = R"(#version 300 es
+precision mediump float;
+
+uniform sampler2D uTexture;
+in vec2 vTexCoord;
+in vec4 vColor;
+out vec4 FragColor;
+
+void main()
+{
+    vec4 color = texture(uTexture, vTexCoord) * vColor;
+    if (color.a < 0.5)
+    {
+        discard;
+    }
+    FragColor = vec4(color.rgb, 1.0);
+}
+)";
+
+    constexpr GLuint      model_location    = 0;
+    constexpr GLuint      tex_rect_location = 3;
+    constexpr GLuint      color_location    = 4;
+    constexpr std::size_t streamed_batches  = 4;
+}
+
+namespace OpenGL
+{
+    SpriteBatch::SpriteBatch(const FrameUniformBuffer& frame_uniforms, std::size_t max_sprites_per_batch, StreamStrategy stream_strategy)
+        : maxSprites(std::clamp(max_sprites_per_batch, std::size_t{ 1 }, MaxSpritesPerBatch)), instances(streamed_batches * maxSprites * sizeof(Instance), stream_strategy)
+    {
+        const std::string vertex_glsl = std::string{ sprite_vertex_header } + FrameUniformsGLSL + sprite_vertex_body;
+        shader                        = CreateShader(std::string_view{ vertex_glsl }, std::string_view{ sprite_fragment_glsl });
+        frame_uniforms.Attach(shader);
+        pending.reserve(maxSprites);
+
+        // no vertex buffer at all, the attributes get pointed at the stream buffer in flush()
+        vertexArrayObject = CreateVertexArray();
+        BindVertexArray(vertexArrayObject.Get());
+        for (GLuint location = model_location; location <= color_location; ++location)
+        {
+            EnableVertexAttribArray(location);
+            VertexAttribDivisor(location, 1);
+        }
+    }
+
+    SpriteBatch::~SpriteBatch()
+    {
+        DestroyShader(shader);
+    }
+
+    void SpriteBatch::BeginScene()
+    {
+        statistics   = Statistics{};
+        boundTexture = 0;
+        pending.clear();
+    }
+
+    void SpriteBatch::Draw(const TextureAtlas::Region& sprite, const Math::mat3& transform, float r, float g, float b, float a)
+    {
+        if (sprite.State != TextureAtlas::SpriteState::Ready)
+        {
+            return;
+        }
+        if (sprite.Texture != texture || pending.size() == maxSprites)
+        {
+            flush();
+            texture = sprite.Texture;
+        }
+        pending.push_back(Instance{ transform, { sprite.Left, sprite.Bottom, sprite.Right, sprite.Top }, { r, g, b, a } });
+        ++statistics.Sprites;
+    }
+
+    void SpriteBatch::EndScene()
+    {
+        flush();
+        instances.EndFrame();
+    }
+
+    void SpriteBatch::flush()
+    {
+        if (pending.empty())
+        {
+            return;
+        }
+        PROFILE_GPU_SCOPE("sprite flush");
+
+        const auto offset = instances.Write(std::as_bytes(std::span{ pending }));
+
+        UseProgram(shader.Shader);
+        BindVertexArray(vertexArrayObject.Get());
+        BindBuffer(GL_ARRAY_BUFFER, instances.GetBuffer());
+        const auto attribute = [&](GLuint location, GLint components, std::size_t member_offset)
+        {
+            VertexAttribPointer(location, components, GL_FLOAT, false, sizeof(Instance), gsl::narrow<std::uintptr_t>(offset) + member_offset);
+        };
+        for (GLuint column = 0; column < 3; ++column)
+        {
+            attribute(model_location + column, 3, offsetof(Instance, Model) + column * 3 * sizeof(float));
+        }
+        attribute(tex_rect_location, 4, offsetof(Instance, TexRect));
+        attribute(color_location, 4, offsetof(Instance, Color));
+
+        if (texture != boundTexture)
+        {
+            BindTexture2D(texture);
+            boundTexture = texture;
+            ++statistics.TextureBinds;
+        }
+        DrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, gsl::narrow<GLsizei>(pending.size()));
+        ++statistics.DrawCalls;
+        pending.clear();
+    }
+}
@@ -0,0 +1,78 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include "FrameUniforms.hpp"
+#include "GpuResources.hpp"
+#include "Handle.hpp"
+#include "Math.hpp"
+#include "Shader.hpp"
+#include "StreamBuffer.hpp"
+#include "TextureAtlas.hpp"
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace OpenGL
+{
+    // Textured quads from a TextureAtlas, one instance each : the corners come from gl_VertexID, so the
+    // only thing streamed is the instance data. A batch only breaks when the next sprite is on another
+    // atlas page, sprites from the same page share one bind and one glDrawArraysInstanced.
+    // There is no blending, texels with alpha under 0.5 are discarded, so the draw order doesn't matter.
+    class SpriteBatch
+    {
+    public:
+        static constexpr std::size_t MaxSpritesPerBatch = 16384;
+
+        struct Statistics
+        {
+            int Sprites      = 0;
+            int DrawCalls    = 0;
+            int TextureBinds = 0; // page changes between draws
+        };
+
+        explicit SpriteBatch(const FrameUniformBuffer& frame_uniforms, std::size_t max_sprites_per_batch = MaxSpritesPerBatch, StreamStrategy stream_strategy = BestStreamStrategy());
+        ~SpriteBatch();
+
+        SpriteBatch(const SpriteBatch&)            = delete;
+        SpriteBatch& operator=(const SpriteBatch&) = delete;
+
+        void BeginScene();
+        // transform is applied to the unit quad [-0.5,+0.5]x[-0.5,+0.5], the color multiplies the texels.
+        // Skipped while the sprite isn't Ready
+        void Draw(const TextureAtlas::Region& sprite, const Math::mat3& transform, float r = 1.0f, float g = 1.0f, float b = 1.0f, float a = 1.0f);
+        // flushes and fences this frame's instances
+        void EndScene();
+
+        [[nodiscard]] const Statistics& GetStatistics() const noexcept
+        {
+            return statistics;
+        }
+
+    private:
+        // location 0,1,2 : model columns, 3 : uv rect (left, bottom, right, top), 4 : rgba
+        struct Instance
+        {
+            Math::mat3           Model;
+            std::array<float, 4> TexRect;
+            std::array<float, 4> Color;
+        };
+
+        void flush();
+
+    private:
+        CompiledShader        shader{};
+        std::size_t           maxSprites = 0;
+        StreamBuffer          instances;
+        VertexArrayHandle     vertexArrayObject{};
+        Handle                texture      = 0; // page of what's pending
+        Handle                boundTexture = 0; // page of the last draw
+        std::vector<Instance> pending{};
+        Statistics            statistics{};
+    };
+}
@@ -0,0 +1,258 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "StreamBuffer.hpp"
+
+#include "FrameCapture.hpp"
+#include "GLState.hpp"
+#include <algorithm>
+#include <cstring>
+#include <gsl/gsl>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+    // same as FrameUniformBuffer : after a second something is badly wrong and we'd rather overwrite than hang
+    constexpr GLuint64 fence_timeout_ns = 1'000'000'000;
+}
+
+namespace OpenGL
+{
+    std::string_view ToString(StreamStrategy strategy) noexcept
+    {
+        switch (strategy)
+        {
+            case StreamStrategy::Orphan: return "orphan";
+            case StreamStrategy::Unsynchronized: return "unsync";
+            case StreamStrategy::Persistent: return "persistent";
+        }
+        return "unknown";
+    }
+
+    std::optional<StreamStrategy> StreamStrategyFromString(std::string_view name) noexcept
+    {
+        for (const auto strategy : AllStreamStrategies)
+        {
+            if (ToString(strategy) == name)
+            {
+                return strategy;
+            }
+        }
+        return std::nullopt;
+    }
+
+    bool IsStreamStrategySupported(StreamStrategy strategy) noexcept
+    {
+#if defined(__EMSCRIPTEN__)
+        // WebGL2 has no glMapBufferRange at all
+        return strategy == StreamStrategy::Orphan;
+#else
+        switch (strategy)
+        {
+            case StreamStrategy::Orphan:
+            case StreamStrategy::Unsynchronized: return true;
+            case StreamStrategy::Persistent: return GLEW_ARB_buffer_storage;
+        }
+        return false;
+#endif
+    }
+
+    StreamStrategy BestStreamStrategy() noexcept
+    {
+        for (const auto strategy : { StreamStrategy::Persistent, StreamStrategy::Unsynchronized })
+        {
+            if (IsStreamStrategySupported(strategy))
+            {
+                return strategy;
+            }
+        }
+        return StreamStrategy::Orphan;
+    }
+
+    StreamBuffer::StreamBuffer(std::size_t buffer_capacity, StreamStrategy stream_strategy)
+        : strategy(IsStreamStrategySupported(stream_strategy) ? stream_strategy : BestStreamStrategy()),
+          capacity((std::max(buffer_capacity, Alignment) + Alignment - 1) / Alignment * Alignment)
+    {
+        const auto bytes = gsl::narrow<GLsizeiptr>(capacity);
+        glGenBuffers(1, &buffer);
+        BindBuffer(GL_ARRAY_BUFFER, buffer);
+#if !defined(__EMSCRIPTEN__)
+        if (strategy == StreamStrategy::Persistent)
+        {
+            // coherent : our writes show up for the gpu without explicit flushes, the fences handle the rest
+            constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+            glBufferStorage(GL_ARRAY_BUFFER, bytes, nullptr, flags);
+            CaptureRecord(CaptureOp::BufferData, GLenum{ GL_ARRAY_BUFFER }, std::int64_t{ bytes }, GLenum{ GL_STREAM_DRAW }, CaptureData{}); // same storage for a replay
+            persistentMemory = static_cast<std::byte*>(glMapBufferRange(GL_ARRAY_BUFFER, 0, bytes, flags));
+            if (persistentMemory != nullptr)
+            {
+                return;
+            }
+            // storage is immutable now, start over with a fresh buffer
+            DeleteBuffer(buffer);
+            glGenBuffers(1, &buffer);
+            BindBuffer(GL_ARRAY_BUFFER, buffer);
+            strategy = StreamStrategy::Unsynchronized;
+        }
+#endif
+        BufferData(GL_ARRAY_BUFFER, bytes, nullptr, GL_STREAM_DRAW);
+    }
+
+    StreamBuffer::~StreamBuffer()
+    {
+        for (const auto& fence : fences)
+        {
+            glDeleteSync(fence.Sync);
+        }
+        if (persistentMemory != nullptr || (strategy == StreamStrategy::Unsynchronized && mapped.Memory != nullptr))
+        {
+            BindBuffer(GL_ARRAY_BUFFER, buffer);
+            glUnmapBuffer(GL_ARRAY_BUFFER);
+        }
+        DeleteBuffer(buffer);
+    }
+
+    StreamBuffer::Range StreamBuffer::Map(std::size_t bytes)
+    {
+        if (bytes == 0 || bytes > capacity)
+        {
+            throw std::length_error("StreamBuffer::Map : " + std::to_string(bytes) + " bytes, capacity is " + std::to_string(capacity) + '\n');
+        }
+        const std::size_t size     = (bytes + Alignment - 1) / Alignment * Alignment;
+        auto              physical = gsl::narrow<std::size_t>(head % capacity); // size_t is 32 bit on wasm
+        if (physical + size > capacity)
+        {
+            // doesn't fit before the end, skip the rest and start over at the beginning
+            head += capacity - physical;
+            physical = 0;
+        }
+        if (physical == 0 && head > 0)
+        {
+            ++statistics.Wraps;
+        }
+
+        BindBuffer(GL_ARRAY_BUFFER, buffer);
+        Range range{ nullptr, gsl::narrow<GLintptr>(physical), bytes };
+        switch (strategy)
+        {
+            case StreamStrategy::Orphan:
+                if (physical == 0 && head > 0)
+                {
+                    // the driver hands us new storage and frees the old one once the gpu is done with it
+                    BufferData(GL_ARRAY_BUFFER, gsl::narrow<GLsizeiptr>(capacity), nullptr, GL_STREAM_DRAW);
+                }
+                staging.resize(bytes);
+                range.Memory = staging.data();
+                break;
+            case StreamStrategy::Unsynchronized:
+                wait_until_free(head + size);
+                range.Memory = static_cast<std::byte*>(glMapBufferRange(GL_ARRAY_BUFFER, range.Offset, gsl::narrow<GLsizeiptr>(bytes),
+                                                                        GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT));
+                if (range.Memory == nullptr)
+                {
+                    throw std::runtime_error("Unable to map the stream buffer\n");
+                }
+                break;
+            case StreamStrategy::Persistent:
+                wait_until_free(head + size);
+                range.Memory = persistentMemory + physical;
+                break;
+        }
+
+        head += size;
+        mapped = range;
+        statistics.BytesStreamed += bytes;
+        return range;
+    }
+
+    bool StreamBuffer::Unmap()
+    {
+        if (mapped.Memory == nullptr)
+        {
+            return true;
+        }
+        BindBuffer(GL_ARRAY_BUFFER, buffer);
+        if (strategy != StreamStrategy::Orphan)
+        {
+            CaptureBufferWrite(buffer, mapped.Offset, { mapped.Memory, mapped.Size });
+        }
+        bool kept = true;
+        switch (strategy)
+        {
+            case StreamStrategy::Orphan: BufferSubData(GL_ARRAY_BUFFER, mapped.Offset, gsl::narrow<GLsizeiptr>(mapped.Size), staging.data()); break;
+            case StreamStrategy::Unsynchronized: kept = glUnmapBuffer(GL_ARRAY_BUFFER) == GL_TRUE; break;
+            case StreamStrategy::Persistent: break; // coherent, nothing to flush
+        }
+        mapped = Range{};
+        return kept;
+    }
+
+    GLintptr StreamBuffer::Write(std::span<const std::byte> data)
+    {
+        Range range;
+        do
+        {
+            range = Map(data.size());
+            std::memcpy(range.Memory, data.data(), data.size());
+        } while (!Unmap());
+        return range.Offset;
+    }
+
+    void StreamBuffer::EndFrame()
+    {
+        if (strategy == StreamStrategy::Orphan)
+        {
+            return;
+        }
+        fence_written();
+        // let go of what is already done, a ring that rarely wraps would pile fences up otherwise
+        while (fences.size() > 1 && glClientWaitSync(fences.front().Sync, 0, 0) != GL_TIMEOUT_EXPIRED)
+        {
+            glDeleteSync(fences.front().Sync);
+            completedUpTo = fences.front().End;
+            fences.pop_front();
+        }
+    }
+
+    void StreamBuffer::fence_written()
+    {
+        if (head > fencedUpTo)
+        {
+            fences.push_back(Fence{ glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0), head });
+            fencedUpTo = head;
+        }
+    }
+
+    void StreamBuffer::wait_until_free(std::uint64_t end)
+    {
+        // the range up to end lands on what was written one lap ago
+        if (end <= capacity || end - capacity <= completedUpTo)
+        {
+            return;
+        }
+        const std::uint64_t needed = end - capacity;
+        if (needed > fencedUpTo)
+        {
+            // more than a whole ring in one frame : we're about to write over our own draws, fence them now
+            fence_written();
+        }
+        while (completedUpTo < needed && !fences.empty())
+        {
+            const auto fence = fences.front();
+            // usually long done, the first check doesn't wait at all
+            if (glClientWaitSync(fence.Sync, 0, 0) == GL_TIMEOUT_EXPIRED)
+            {
+                ++statistics.FenceWaits;
+                glClientWaitSync(fence.Sync, GL_SYNC_FLUSH_COMMANDS_BIT, fence_timeout_ns);
+            }
+            glDeleteSync(fence.Sync);
+            completedUpTo = fence.End;
+            fences.pop_front();
+        }
+    }
+}
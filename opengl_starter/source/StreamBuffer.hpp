@@ -0,0 +1,126 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include "Handle.hpp"
+#include <GL/glew.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace OpenGL
+{
+    // how StreamBuffer gets new data to the gpu, which one is fastest depends on the driver
+    enum class StreamStrategy
+    {
+        Orphan,         // glBufferSubData into a ring, glBufferData(nullptr) to get fresh storage when it wraps. Works everywhere
+        Unsynchronized, // glMapBufferRange(GL_MAP_UNSYNCHRONIZED_BIT) into a ring, fences say when a wrapped range is free again. Not on WebGL2
+        Persistent,     // mapped once for good (persistent + coherent), same ring and fences. Needs ARB_buffer_storage
+    };
+
+    inline constexpr std::array AllStreamStrategies{ StreamStrategy::Orphan, StreamStrategy::Unsynchronized, StreamStrategy::Persistent };
+
+    [[nodiscard]] std::string_view              ToString(StreamStrategy strategy) noexcept;
+    [[nodiscard]] std::optional<StreamStrategy> StreamStrategyFromString(std::string_view name) noexcept;
+    [[nodiscard]] bool                          IsStreamStrategySupported(StreamStrategy strategy) noexcept;
+    // persistent, then unsynchronized, then orphan
+    [[nodiscard]] StreamStrategy BestStreamStrategy() noexcept;
+
+    // Buffer for data that changes every frame (batched vertices, instances...).
+    // Every Map() gets a fresh range further along a ring, so the gpu can keep reading what it was given before.
+    // Draw from the returned Offset. When the ring wraps around, the strategy decides how we avoid writing over
+    // data the gpu hasn't read yet: orphaning gives the old storage to the driver, the mapped strategies wait
+    // on the fences EndFrame() leaves behind (usually they are long signaled).
+    class StreamBuffer
+    {
+    public:
+        // offsets are multiples of this, enough for any vertex attribute and for GL_MIN_MAP_BUFFER_ALIGNMENT
+        static constexpr std::size_t Alignment = 64;
+
+        struct Range
+        {
+            std::byte*  Memory = nullptr; // write here, only valid until Unmap()
+            GLintptr    Offset = 0;       // where it lands in GetBuffer()
+            std::size_t Size   = 0;
+        };
+
+        struct Statistics
+        {
+            std::uint64_t BytesStreamed = 0;
+            int           Wraps         = 0; // times the ring went back to the start (an orphan for StreamStrategy::Orphan)
+            int           FenceWaits    = 0; // times the cpu had to wait for the gpu to be done with a range
+        };
+
+        // falls back to BestStreamStrategy() when the asked one isn't supported, check GetStrategy()
+        explicit StreamBuffer(std::size_t capacity, StreamStrategy stream_strategy = BestStreamStrategy());
+        ~StreamBuffer();
+
+        StreamBuffer(const StreamBuffer&)            = delete;
+        StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+        // bytes has to fit in the capacity. Leaves the buffer bound to GL_ARRAY_BUFFER, like Unmap()
+        [[nodiscard]] Range Map(std::size_t bytes);
+        // false when the driver threw away what was written (glUnmapBuffer said the storage got corrupted,
+        // a display mode change can do that). Map() again and write it again
+        bool Unmap();
+        // Map + memcpy + Unmap until it sticks, returns the offset
+        GLintptr Write(std::span<const std::byte> data);
+        // after the last draw that reads this frame's data
+        void EndFrame();
+
+        [[nodiscard]] Handle GetBuffer() const noexcept
+        {
+            return buffer;
+        }
+
+        [[nodiscard]] StreamStrategy GetStrategy() const noexcept
+        {
+            return strategy;
+        }
+
+        [[nodiscard]] std::size_t GetCapacity() const noexcept
+        {
+            return capacity;
+        }
+
+        // reset with GetStatistics() = {}
+        [[nodiscard]] Statistics& GetStatistics() noexcept
+        {
+            return statistics;
+        }
+
+    private:
+        // head and the fence ends count every byte ever handed out, head % capacity is the spot in the buffer
+        struct Fence
+        {
+            GLsync        Sync = nullptr;
+            std::uint64_t End  = 0;
+        };
+
+        void fence_written();
+        void wait_until_free(std::uint64_t end);
+
+    private:
+        Handle                 buffer = 0;
+        StreamStrategy         strategy;
+        std::size_t            capacity      = 0;
+        std::uint64_t          head          = 0;
+        std::uint64_t          fencedUpTo    = 0; // everything before this has a fence
+        std::uint64_t          completedUpTo = 0; // everything before this the gpu is done with
+        std::deque<Fence>      fences{};
+        std::byte*             persistentMemory = nullptr;
+        std::vector<std::byte> staging{}; // what Map() hands out for StreamStrategy::Orphan
+        Range                  mapped{};
+        Statistics             statistics{};
+    };
+}
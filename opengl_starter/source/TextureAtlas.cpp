@@ -0,0 +1,382 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "TextureAtlas.hpp"
+
+#include "FrameCapture.hpp"
+#include "GLState.hpp"
+#include "Profiler.hpp"
+#include <GL/glew.h>
+#include <algorithm>
+#include <gsl/gsl>
+#include <iostream>
+#include <span>
+#include <stdexcept>
+
+namespace
+{
+    constexpr std::size_t bytes_per_pixel = 4;
+
+    // enough for the budget of a few frames, so a wrap rarely finds the gpu still reading a strip
+    constexpr std::size_t staged_frames = 3;
+
+    [[nodiscard]] int clamp_page_size(int page_size)
+    {
+        GLint max_size = 0;
+        glGetIntegerv(GL_MAX_TEXTURE_SIZE, &max_size);
+        return std::clamp(page_size, 64, std::max(max_size, 64));
+    }
+
+    [[nodiscard]] std::size_t row_bytes(int width) noexcept
+    {
+        return static_cast<std::size_t>(width) * bytes_per_pixel;
+    }
+}
+
+namespace OpenGL
+{
+    SkylinePacker::SkylinePacker(int width, int height) : pageWidth(width), pageHeight(height)
+    {
+        if (width <= 0 || height <= 0)
+        {
+            throw std::invalid_argument("SkylinePacker needs a positive size");
+        }
+        skyline.push_back(Segment{ 0, 0, width });
+    }
+
+    std::optional<SkylinePacker::Position> SkylinePacker::Insert(int width, int height)
+    {
+        if (width <= 0 || height <= 0)
+        {
+            return std::nullopt;
+        }
+
+        // lowest top edge wins, then the narrowest segment so wide gaps stay open for wide rectangles
+        std::size_t best_index = skyline.size();
+        int         best_top   = pageHeight + 1;
+        int         best_width = pageWidth + 1;
+        for (std::size_t index = 0; index < skyline.size(); ++index)
+        {
+            const auto y = fit(index, width, height);
+            if (!y)
+            {
+                continue;
+            }
+            const int top = *y + height;
+            if (top < best_top || (top == best_top && skyline[index].Width < best_width))
+            {
+                best_index = index;
+                best_top   = top;
+                best_width = skyline[index].Width;
+            }
+        }
+        if (best_index == skyline.size())
+        {
+            return std::nullopt;
+        }
+
+        const Position position{ skyline[best_index].X, best_top - height };
+        const auto     inserted = skyline.insert(skyline.begin() + static_cast<std::ptrdiff_t>(best_index), Segment{ position.X, best_top, width });
+        // the segments the new one covers get cut down or dropped
+        const int right = position.X + width;
+        auto      next  = inserted + 1;
+        while (next != skyline.end() && next->X < right)
+        {
+            const int covered = right - next->X;
+            if (covered >= next->Width)
+            {
+                next = skyline.erase(next);
+                continue;
+            }
+            next->X += covered;
+            next->Width -= covered;
+            break;
+        }
+        // neighbours at the same height become one segment
+        for (std::size_t index = 0; index + 1 < skyline.size();)
+        {
+            if (skyline[index].Y == skyline[index + 1].Y)
+            {
+                skyline[index].Width += skyline[index + 1].Width;
+                skyline.erase(skyline.begin() + static_cast<std::ptrdiff_t>(index + 1));
+                continue;
+            }
+            ++index;
+        }
+
+        usedArea += static_cast<std::uint64_t>(width) * static_cast<std::uint64_t>(height);
+        return position;
+    }
+
+    double SkylinePacker::GetEfficiency() const noexcept
+    {
+        const auto area = GetSkylineArea();
+        return area == 0 ? 1.0 : static_cast<double>(usedArea) / static_cast<double>(area);
+    }
+
+    std::uint64_t SkylinePacker::GetSkylineArea() const noexcept
+    {
+        std::uint64_t area = 0;
+        for (const auto& segment : skyline)
+        {
+            area += static_cast<std::uint64_t>(segment.Width) * static_cast<std::uint64_t>(segment.Y);
+        }
+        return area;
+    }
+
+    std::optional<int> SkylinePacker::fit(std::size_t index, int width, int height) const noexcept
+    {
+        if (skyline[index].X + width > pageWidth)
+        {
+            return std::nullopt;
+        }
+        // it rests on the highest segment it spans
+        int y          = 0;
+        int width_left = width;
+        for (; width_left > 0 && index < skyline.size(); ++index)
+        {
+            y = std::max(y, skyline[index].Y);
+            if (y + height > pageHeight)
+            {
+                return std::nullopt;
+            }
+            width_left -= skyline[index].Width;
+        }
+        return y;
+    }
+
+    TextureAtlas::TextureAtlas(int page_size, std::size_t upload_budget_bytes, [[maybe_unused]] unsigned decode_threads)
+        : pageSize(clamp_page_size(page_size)),
+          // at least one row of a full page, every frame has to make some progress
+          uploadBudget(std::max(upload_budget_bytes, row_bytes(pageSize))), staging(staged_frames * uploadBudget)
+    {
+#if !defined(__EMSCRIPTEN__)
+        const unsigned count = (decode_threads == 0) ? std::max(1u, std::thread::hardware_concurrency() / 2) : decode_threads;
+        for (unsigned i = 0; i < count; ++i)
+        {
+            workers.emplace_back([this] { decode_loop(); });
+        }
+#endif
+    }
+
+    TextureAtlas::~TextureAtlas()
+    {
+        {
+            const std::lock_guard lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+        for (const auto& page : pages)
+        {
+            DeleteTexture(page.Texture);
+        }
+    }
+
+    TextureAtlas::SpriteID TextureAtlas::Load(const std::filesystem::path& image_path)
+    {
+        const auto sprite = static_cast<SpriteID>(regions.size());
+        regions.emplace_back();
+#if defined(__EMSCRIPTEN__)
+        // no pthreads in this build, decode right away and let Update() pick it up like any other
+        Decoded result{ sprite };
+        try
+        {
+            result.Pixels = LoadImage(image_path);
+        }
+        catch (const std::exception& error)
+        {
+            std::cerr << error.what() << '\n';
+            result.Failed = true;
+        }
+        const std::lock_guard lock(mutex);
+        decoded.push_back(std::move(result));
+#else
+        {
+            const std::lock_guard lock(mutex);
+            decodes.push_back(Decode{ sprite, image_path });
+        }
+        wake.notify_one();
+#endif
+        return sprite;
+    }
+
+    TextureAtlas::SpriteID TextureAtlas::Add(Image image)
+    {
+        const auto sprite = static_cast<SpriteID>(regions.size());
+        regions.emplace_back();
+        const std::lock_guard lock(mutex);
+        decoded.push_back(Decoded{ sprite, std::move(image) });
+        return sprite;
+    }
+
+    void TextureAtlas::Update()
+    {
+        PROFILE_SCOPE("atlas update");
+
+        std::vector<Decoded> finished;
+        {
+            const std::lock_guard lock(mutex);
+            finished.swap(decoded);
+        }
+        statistics.Decoded += static_cast<int>(finished.size());
+        for (auto& result : finished)
+        {
+            place(std::move(result));
+        }
+        if (uploads.empty())
+        {
+            return;
+        }
+
+        // whole rows from the front of the queue until the budget is gone, big images take a few frames
+        std::size_t spent = 0;
+        while (!uploads.empty())
+        {
+            auto&             upload     = uploads.front();
+            const std::size_t row_size   = row_bytes(upload.Pixels.Width);
+            const int         rows_left  = upload.Pixels.Height - upload.RowsUp;
+            const auto        affordable = static_cast<int>(std::min<std::size_t>((uploadBudget - spent) / row_size, static_cast<std::size_t>(rows_left)));
+            if (affordable == 0)
+            {
+                break;
+            }
+
+            const std::size_t bytes  = static_cast<std::size_t>(affordable) * row_size;
+            const auto        offset = staging.Write(std::as_bytes(std::span{ upload.Pixels.Pixels }.subspan(static_cast<std::size_t>(upload.RowsUp) * row_size, bytes)));
+
+            // with a buffer bound to GL_PIXEL_UNPACK_BUFFER the pointer is an offset into it
+            BindBuffer(GL_PIXEL_UNPACK_BUFFER, staging.GetBuffer());
+            BindTexture2D(pages[upload.Page].Texture);
+            TexSubImage2D(upload.X, upload.Y + upload.RowsUp, upload.Pixels.Width, affordable, GL_RGBA, GL_UNSIGNED_BYTE, reinterpret_cast<const void*>(offset));
+            spent += bytes;
+            upload.RowsUp += affordable;
+            ++statistics.Uploads;
+
+            if (upload.RowsUp == upload.Pixels.Height)
+            {
+                regions[upload.Sprite].State = SpriteState::Ready;
+                uploads.pop_front();
+            }
+        }
+        // anything else uploading a texture (ImGui's font) expects client memory
+        BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        staging.EndFrame();
+        statistics.BytesUploaded += spent;
+    }
+
+    bool TextureAtlas::IsIdle() const
+    {
+        const std::lock_guard lock(mutex);
+        return uploads.empty() && decodes.empty() && decoded.empty() && decoding == 0;
+    }
+
+    double TextureAtlas::GetPackingEfficiency() const noexcept
+    {
+        std::uint64_t area = 0;
+        for (const auto& page : pages)
+        {
+            area += page.Packer.GetSkylineArea();
+        }
+        return area == 0 ? 1.0 : static_cast<double>(packedPixels) / static_cast<double>(area);
+    }
+
+    void TextureAtlas::decode_loop()
+    {
+        std::unique_lock lock(mutex);
+        while (true)
+        {
+            wake.wait(lock, [this] { return stopping || !decodes.empty(); });
+            if (stopping)
+            {
+                return;
+            }
+            const Decode job = std::move(decodes.front());
+            decodes.pop_front();
+            ++decoding;
+            lock.unlock();
+
+            Decoded result{ job.Sprite };
+            try
+            {
+                result.Pixels = LoadImage(job.Path);
+            }
+            catch (const std::exception& error)
+            {
+                std::cerr << error.what() << '\n';
+                result.Failed = true;
+            }
+
+            lock.lock();
+            decoded.push_back(std::move(result));
+            --decoding;
+        }
+    }
+
+    void TextureAtlas::place(Decoded result)
+    {
+        auto&     region = regions[result.Sprite];
+        const int width  = result.Pixels.Width + 2 * Padding;
+        const int height = result.Pixels.Height + 2 * Padding;
+        if (result.Failed || result.Pixels.Width <= 0 || result.Pixels.Height <= 0 || width > pageSize || height > pageSize)
+        {
+            region.State = SpriteState::Failed;
+            return;
+        }
+
+        // the first page with room, so early pages fill up before new ones get touched
+        std::optional<SkylinePacker::Position> position;
+        std::size_t                            page = 0;
+        for (; page < pages.size() && !position; ++page)
+        {
+            position = pages[page].Packer.Insert(width, height);
+        }
+        if (position)
+        {
+            --page;
+        }
+        else
+        {
+            page     = add_page();
+            position = pages[page].Packer.Insert(width, height);
+        }
+        packedPixels += static_cast<std::uint64_t>(result.Pixels.Width) * static_cast<std::uint64_t>(result.Pixels.Height);
+
+        // rows go up top row first, so the top of the image is the low v
+        const int   x     = position->X + Padding;
+        const int   y     = position->Y + Padding;
+        const float scale = 1.0f / static_cast<float>(pageSize);
+        region.Texture    = pages[page].Texture;
+        region.Left       = static_cast<float>(x) * scale;
+        region.Right      = static_cast<float>(x + result.Pixels.Width) * scale;
+        region.Top        = static_cast<float>(y) * scale;
+        region.Bottom     = static_cast<float>(y + result.Pixels.Height) * scale;
+        region.Width      = result.Pixels.Width;
+        region.Height     = result.Pixels.Height;
+        uploads.push_back(Upload{ result.Sprite, std::move(result.Pixels), page, x, y, 0 });
+    }
+
+    std::size_t TextureAtlas::add_page()
+    {
+        Page page{ 0, SkylinePacker(pageSize, pageSize) };
+        glGenTextures(1, &page.Texture);
+        BindTexture2D(page.Texture);
+        // nearest : sprites are pixel art sized and nothing bleeds in from the padding
+        TexParameteri(GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        TexParameteri(GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        TexParameteri(GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        TexParameteri(GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        // storage only, a bound unpack buffer would turn the nullptr into offset 0
+        BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        TexImage2D(GL_RGBA8, pageSize, pageSize, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        pages.push_back(std::move(page));
+        return pages.size() - 1;
+    }
+}
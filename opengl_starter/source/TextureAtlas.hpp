@@ -0,0 +1,207 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include "Handle.hpp"
+#include "Image.hpp"
+#include "StreamBuffer.hpp"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace OpenGL
+{
+    // Bottom left skyline packer : the used area is a row of segments, each with the height of the
+    // highest thing in it. A rectangle goes where it would end up lowest (then where it wastes the least
+    // width), and the segments under it become one segment. Nothing is ever taken out again.
+    class SkylinePacker
+    {
+    public:
+        struct Position
+        {
+            int X = 0;
+            int Y = 0;
+        };
+
+        SkylinePacker(int width, int height);
+
+        // empty when it doesn't fit anywhere
+        [[nodiscard]] std::optional<Position> Insert(int width, int height);
+
+        // used area / area under the skyline, 1 is perfect packing
+        [[nodiscard]] double        GetEfficiency() const noexcept;
+        [[nodiscard]] std::uint64_t GetSkylineArea() const noexcept;
+
+        [[nodiscard]] std::uint64_t GetUsedArea() const noexcept
+        {
+            return usedArea;
+        }
+
+    private:
+        struct Segment
+        {
+            int X     = 0;
+            int Y     = 0;
+            int Width = 0;
+        };
+
+        // where the rectangle would sit if its left edge was at segment index, empty if it pokes out
+        [[nodiscard]] std::optional<int> fit(std::size_t index, int width, int height) const noexcept;
+
+    private:
+        int                  pageWidth;
+        int                  pageHeight;
+        std::vector<Segment> skyline{};
+        std::uint64_t        usedArea = 0;
+    };
+
+    // Sprites packed into a few big textures (pages), so thousands of them can be drawn with one bind.
+    // Load() hands the file to background threads that decode it, Update() on the gl thread packs what got
+    // decoded and copies it up in row strips through a pixel buffer (a StreamBuffer bound to GL_PIXEL_UNPACK_BUFFER),
+    // never more than the upload budget per frame, so a pile of new sprites doesn't make one frame take forever.
+    // Until a sprite is Ready its region is empty and its state says why.
+    class TextureAtlas
+    {
+    public:
+        using SpriteID = std::uint32_t;
+
+        enum class SpriteState
+        {
+            Loading, // decoding or uploading
+            Ready,
+            Failed // the file couldn't be read or decoded, or it is bigger than a page
+        };
+
+        // where a sprite ended up, the uvs are for the bottom left and top right corners of the image
+        struct Region
+        {
+            Handle      Texture = 0;
+            float       Left    = 0.0f;
+            float       Bottom  = 0.0f;
+            float       Right   = 0.0f;
+            float       Top     = 0.0f;
+            int         Width   = 0;
+            int         Height  = 0;
+            SpriteState State   = SpriteState::Loading;
+        };
+
+        struct Statistics
+        {
+            std::uint64_t BytesUploaded = 0;
+            int           Uploads       = 0; // glTexSubImage2D calls
+            int           Decoded       = 0; // images Update() picked up, failed ones included
+        };
+
+        // empty texels left around every sprite, so a quad that lands between pixels can't sample its neighbour
+        static constexpr int Padding = 1;
+
+        // decode_threads 0 : half the cores (at least one). The web build decodes inside Load()
+        explicit TextureAtlas(int page_size = 2048, std::size_t upload_budget_bytes = std::size_t{ 4 } << 20, unsigned decode_threads = 0);
+        ~TextureAtlas();
+
+        TextureAtlas(const TextureAtlas&)            = delete;
+        TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+        // from the thread that owns the atlas, the gl context isn't needed
+        SpriteID Load(const std::filesystem::path& image_path);
+        SpriteID Add(Image image);
+
+        // gl thread, once a frame : pack whatever finished decoding and upload up to the budget
+        void Update();
+
+        // nothing left to decode or upload
+        [[nodiscard]] bool IsIdle() const;
+
+        [[nodiscard]] const Region& Get(SpriteID sprite) const
+        {
+            return regions.at(sprite);
+        }
+
+        [[nodiscard]] std::size_t GetSpriteCount() const noexcept
+        {
+            return regions.size();
+        }
+
+        [[nodiscard]] std::size_t GetPageCount() const noexcept
+        {
+            return pages.size();
+        }
+
+        [[nodiscard]] int GetPageSize() const noexcept
+        {
+            return pageSize;
+        }
+
+        // sprite pixels / texels under the skylines of every page, the padding counts as waste
+        [[nodiscard]] double GetPackingEfficiency() const noexcept;
+
+        // reset with GetStatistics() = {}
+        [[nodiscard]] Statistics& GetStatistics() noexcept
+        {
+            return statistics;
+        }
+
+    private:
+        struct Page
+        {
+            Handle        Texture = 0;
+            SkylinePacker Packer;
+        };
+
+        struct Decode
+        {
+            SpriteID              Sprite = 0;
+            std::filesystem::path Path{};
+        };
+
+        struct Decoded
+        {
+            SpriteID Sprite = 0;
+            Image    Pixels{};
+            bool     Failed = false;
+        };
+
+        // packed and waiting for its rows to go up
+        struct Upload
+        {
+            SpriteID    Sprite = 0;
+            Image       Pixels{};
+            std::size_t Page   = 0;
+            int         X      = 0;
+            int         Y      = 0;
+            int         RowsUp = 0;
+        };
+
+        void        decode_loop();
+        void        place(Decoded result);
+        std::size_t add_page();
+
+    private:
+        int                      pageSize;
+        std::size_t              uploadBudget;
+        std::vector<Page>        pages{};
+        std::vector<Region>      regions{};
+        std::deque<Upload>       uploads{};
+        std::uint64_t            packedPixels = 0;
+        StreamBuffer             staging;
+        Statistics               statistics{};
+        std::vector<std::thread> workers{};
+        mutable std::mutex       mutex{}; // guards everything below
+        std::condition_variable  wake{};
+        std::deque<Decode>       decodes{};
+        std::vector<Decoded>     decoded{};
+        int                      decoding = 0; // taken by a worker, not in decoded yet
+        bool                     stopping = false;
+    };
+}
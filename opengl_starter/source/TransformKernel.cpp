@@ -0,0 +1,308 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "TransformKernel.hpp"
+
+#include <algorithm>
+#include <array>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#    define TRANSFORM_KERNEL_X86 1
+#    include <immintrin.h>
+#    if defined(_MSC_VER) && !defined(__clang__)
+#        include <intrin.h>
+#        define TRANSFORM_KERNEL_AVX2_TARGET
+#    else
+#        define TRANSFORM_KERNEL_AVX2_TARGET __attribute__((target("avx2,fma")))
+#    endif
+#endif
+
+#if defined(__wasm_simd128__)
+#    include <wasm_simd128.h>
+#endif
+
+namespace
+{
+    using OpenGL::TransformBatch;
+    using OpenGL::Vertex;
+
+    // shape points are done in chunks so the transformed lanes fit in a small stack buffer
+    constexpr std::size_t points_per_chunk = 16;
+
+    // transformed x (or y) of each chunk point, one row per point, one column per lane
+    template <std::size_t lanes>
+    using LaneBuffer = std::array<std::array<float, lanes>, points_per_chunk>;
+
+    // the SIMD paths leave x and y for `lanes` objects in lane order, this writes them out object by object
+    // so every object's vertices go out front to back (friendly to write-combined mapped memory)
+    template <std::size_t lanes>
+    void write_vertices(
+        const TransformBatch& batch, std::size_t first_object, std::size_t shape_size, std::size_t first_point, std::size_t point_count, const LaneBuffer<lanes>& xs,
+        const LaneBuffer<lanes>& ys, Vertex* out)
+    {
+        for (std::size_t lane = 0; lane < lanes; ++lane)
+        {
+            const std::size_t object = first_object + lane;
+            Vertex*           vertex = out + object * shape_size + first_point;
+            const float       r      = batch.R[object];
+            const float       g      = batch.G[object];
+            const float       b      = batch.B[object];
+            for (std::size_t point = 0; point < point_count; ++point)
+            {
+                vertex[point] = Vertex{ xs[point][lane], ys[point][lane], r, g, b };
+            }
+        }
+    }
+
+    void transform_scalar(const TransformBatch& batch, std::size_t first_object, std::span<const float> shape_x, std::span<const float> shape_y, Vertex* out)
+    {
+        const std::size_t shape_size = shape_x.size();
+        for (std::size_t object = first_object; object < batch.Size(); ++object)
+        {
+            Vertex* vertex = out + object * shape_size;
+            for (std::size_t point = 0; point < shape_size; ++point)
+            {
+                const float x = shape_x[point];
+                const float y = shape_y[point];
+                vertex[point] = Vertex{ batch.M00[object] * x + batch.M01[object] * y + batch.Tx[object], batch.M10[object] * x + batch.M11[object] * y + batch.Ty[object],
+                                        batch.R[object], batch.G[object], batch.B[object] };
+            }
+        }
+    }
+
+#if defined(TRANSFORM_KERNEL_X86)
+    // returns the first object it didn't get to, the scalar path finishes the tail
+    std::size_t transform_sse2(const TransformBatch& batch, std::span<const float> shape_x, std::span<const float> shape_y, Vertex* out)
+    {
+        constexpr std::size_t lanes      = 4;
+        const std::size_t     shape_size = shape_x.size();
+        LaneBuffer<lanes>     xs{};
+        LaneBuffer<lanes>     ys{};
+        std::size_t           object = 0;
+        for (; object + lanes <= batch.Size(); object += lanes)
+        {
+            const __m128 m00 = _mm_loadu_ps(&batch.M00[object]);
+            const __m128 m10 = _mm_loadu_ps(&batch.M10[object]);
+            const __m128 m01 = _mm_loadu_ps(&batch.M01[object]);
+            const __m128 m11 = _mm_loadu_ps(&batch.M11[object]);
+            const __m128 tx  = _mm_loadu_ps(&batch.Tx[object]);
+            const __m128 ty  = _mm_loadu_ps(&batch.Ty[object]);
+            for (std::size_t first_point = 0; first_point < shape_size; first_point += points_per_chunk)
+            {
+                const std::size_t point_count = std::min(points_per_chunk, shape_size - first_point);
+                for (std::size_t point = 0; point < point_count; ++point)
+                {
+                    const __m128 x = _mm_set1_ps(shape_x[first_point + point]);
+                    const __m128 y = _mm_set1_ps(shape_y[first_point + point]);
+                    _mm_storeu_ps(xs[point].data(), _mm_add_ps(_mm_add_ps(_mm_mul_ps(m00, x), _mm_mul_ps(m01, y)), tx));
+                    _mm_storeu_ps(ys[point].data(), _mm_add_ps(_mm_add_ps(_mm_mul_ps(m10, x), _mm_mul_ps(m11, y)), ty));
+                }
+                write_vertices<lanes>(batch, object, shape_size, first_point, point_count, xs, ys, out);
+            }
+        }
+        return object;
+    }
+
+    TRANSFORM_KERNEL_AVX2_TARGET std::size_t transform_avx2(const TransformBatch& batch, std::span<const float> shape_x, std::span<const float> shape_y, Vertex* out)
+    {
+        constexpr std::size_t lanes      = 8;
+        const std::size_t     shape_size = shape_x.size();
+        LaneBuffer<lanes>     xs{};
+        LaneBuffer<lanes>     ys{};
+        std::size_t           object = 0;
+        for (; object + lanes <= batch.Size(); object += lanes)
+        {
+            const __m256 m00 = _mm256_loadu_ps(&batch.M00[object]);
+            const __m256 m10 = _mm256_loadu_ps(&batch.M10[object]);
+            const __m256 m01 = _mm256_loadu_ps(&batch.M01[object]);
+            const __m256 m11 = _mm256_loadu_ps(&batch.M11[object]);
+            const __m256 tx  = _mm256_loadu_ps(&batch.Tx[object]);
+            const __m256 ty  = _mm256_loadu_ps(&batch.Ty[object]);
+            for (std::size_t first_point = 0; first_point < shape_size; first_point += points_per_chunk)
+            {
+                const std::size_t point_count = std::min(points_per_chunk, shape_size - first_point);
+                for (std::size_t point = 0; point < point_count; ++point)
+                {
+                    const __m256 x = _mm256_set1_ps(shape_x[first_point + point]);
+                    const __m256 y = _mm256_set1_ps(shape_y[first_point + point]);
+                    _mm256_storeu_ps(xs[point].data(), _mm256_fmadd_ps(m00, x, _mm256_fmadd_ps(m01, y, tx)));
+                    _mm256_storeu_ps(ys[point].data(), _mm256_fmadd_ps(m10, x, _mm256_fmadd_ps(m11, y, ty)));
+                }
+                write_vertices<lanes>(batch, object, shape_size, first_point, point_count, xs, ys, out);
+            }
+        }
+        return object;
+    }
+
+    [[nodiscard]] bool cpu_has_avx2() noexcept
+    {
+#    if defined(_MSC_VER) && !defined(__clang__)
+        int registers[4]{};
+        __cpuid(registers, 0);
+        if (registers[0] < 7)
+        {
+            return false;
+        }
+        __cpuid(registers, 1);
+        const bool has_fma     = (registers[2] & (1 << 12)) != 0;
+        const bool has_osxsave = (registers[2] & (1 << 27)) != 0;
+        // the os has to save the ymm registers on context switches too
+        if (!has_fma || !has_osxsave || (_xgetbv(0) & 0x6) != 0x6)
+        {
+            return false;
+        }
+        __cpuidex(registers, 7, 0);
+        return (registers[1] & (1 << 5)) != 0;
+#    else
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#    endif
+    }
+#endif
+
+#if defined(__wasm_simd128__)
+    std::size_t transform_wasm_simd128(const TransformBatch& batch, std::span<const float> shape_x, std::span<const float> shape_y, Vertex* out)
+    {
+        constexpr std::size_t lanes      = 4;
+        const std::size_t     shape_size = shape_x.size();
+        LaneBuffer<lanes>     xs{};
+        LaneBuffer<lanes>     ys{};
+        std::size_t           object = 0;
+        for (; object + lanes <= batch.Size(); object += lanes)
+        {
+            const v128_t m00 = wasm_v128_load(&batch.M00[object]);
+            const v128_t m10 = wasm_v128_load(&batch.M10[object]);
+            const v128_t m01 = wasm_v128_load(&batch.M01[object]);
+            const v128_t m11 = wasm_v128_load(&batch.M11[object]);
+            const v128_t tx  = wasm_v128_load(&batch.Tx[object]);
+            const v128_t ty  = wasm_v128_load(&batch.Ty[object]);
+            for (std::size_t first_point = 0; first_point < shape_size; first_point += points_per_chunk)
+            {
+                const std::size_t point_count = std::min(points_per_chunk, shape_size - first_point);
+                for (std::size_t point = 0; point < point_count; ++point)
+                {
+                    const v128_t x = wasm_f32x4_splat(shape_x[first_point + point]);
+                    const v128_t y = wasm_f32x4_splat(shape_y[first_point + point]);
+                    wasm_v128_store(xs[point].data(), wasm_f32x4_add(wasm_f32x4_add(wasm_f32x4_mul(m00, x), wasm_f32x4_mul(m01, y)), tx));
+                    wasm_v128_store(ys[point].data(), wasm_f32x4_add(wasm_f32x4_add(wasm_f32x4_mul(m10, x), wasm_f32x4_mul(m11, y)), ty));
+                }
+                write_vertices<lanes>(batch, object, shape_size, first_point, point_count, xs, ys, out);
+            }
+        }
+        return object;
+    }
+#endif
+}
+
+namespace OpenGL
+{
+    void TransformBatch::Reserve(std::size_t count)
+    {
+        for (auto* column : { &M00, &M10, &M01, &M11, &Tx, &Ty, &R, &G, &B })
+        {
+            column->reserve(count);
+        }
+    }
+
+    void TransformBatch::Clear() noexcept
+    {
+        for (auto* column : { &M00, &M10, &M01, &M11, &Tx, &Ty, &R, &G, &B })
+        {
+            column->clear();
+        }
+    }
+
+    void TransformBatch::Push(const Math::mat3& transform, float r, float g, float b)
+    {
+        // mat3 is column order : [0] [1] first column, [3] [4] second, [6] [7] translation
+        M00.push_back(transform[0]);
+        M10.push_back(transform[1]);
+        M01.push_back(transform[3]);
+        M11.push_back(transform[4]);
+        Tx.push_back(transform[6]);
+        Ty.push_back(transform[7]);
+        R.push_back(r);
+        G.push_back(g);
+        B.push_back(b);
+    }
+
+    SimdPath BestSimdPath() noexcept
+    {
+        for (const auto path : { SimdPath::AVX2, SimdPath::SSE2, SimdPath::WasmSimd128 })
+        {
+            if (IsSimdPathSupported(path))
+            {
+                return path;
+            }
+        }
+        return SimdPath::Scalar;
+    }
+
+    bool IsSimdPathSupported(SimdPath path) noexcept
+    {
+        switch (path)
+        {
+            case SimdPath::Scalar: return true;
+#if defined(TRANSFORM_KERNEL_X86)
+            case SimdPath::SSE2: return true;
+            case SimdPath::AVX2:
+                {
+                    static const bool has_avx2 = cpu_has_avx2();
+                    return has_avx2;
+                }
+#else
+            case SimdPath::SSE2:
+            case SimdPath::AVX2: return false;
+#endif
+#if defined(__wasm_simd128__)
+            case SimdPath::WasmSimd128: return true;
+#else
+            case SimdPath::WasmSimd128: return false;
+#endif
+        }
+        return false;
+    }
+
+    std::string_view ToString(SimdPath path) noexcept
+    {
+        switch (path)
+        {
+            case SimdPath::Scalar: return "scalar";
+            case SimdPath::SSE2: return "sse2";
+            case SimdPath::AVX2: return "avx2";
+            case SimdPath::WasmSimd128: return "wasm simd128";
+        }
+        return "unknown";
+    }
+
+    void TransformShapes(const TransformBatch& batch, std::span<const float> shape_x, std::span<const float> shape_y, Vertex* out, SimdPath path)
+    {
+        if (shape_x.empty() || shape_x.size() != shape_y.size())
+        {
+            return;
+        }
+        if (!IsSimdPathSupported(path))
+        {
+            path = SimdPath::Scalar;
+        }
+
+        std::size_t done = 0;
+        switch (path)
+        {
+            case SimdPath::Scalar: break;
+#if defined(TRANSFORM_KERNEL_X86)
+            case SimdPath::SSE2: done = transform_sse2(batch, shape_x, shape_y, out); break;
+            case SimdPath::AVX2: done = transform_avx2(batch, shape_x, shape_y, out); break;
+#endif
+#if defined(__wasm_simd128__)
+            case SimdPath::WasmSimd128: done = transform_wasm_simd128(batch, shape_x, shape_y, out); break;
+#endif
+            default: break;
+        }
+        // whatever didn't fill a whole register
+        transform_scalar(batch, done, shape_x, shape_y, out);
+    }
+}
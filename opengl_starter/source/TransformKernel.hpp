@@ -0,0 +1,56 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include "Math.hpp"
+#include "Vertex.hpp"
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace OpenGL
+{
+    // The parts of a batch of mat3s that matter for 2d points, one array per element (structure of arrays)
+    // so a SIMD register can hold the same element of 4 or 8 objects at once.
+    //   x' = M00 * x + M01 * y + Tx
+    //   y' = M10 * x + M11 * y + Ty
+    // The color is per object and gets copied into every vertex the object makes.
+    struct TransformBatch
+    {
+        std::vector<float> M00, M10, M01, M11, Tx, Ty;
+        std::vector<float> R, G, B;
+
+        void Reserve(std::size_t count);
+        void Clear() noexcept;
+        void Push(const Math::mat3& transform, float r, float g, float b);
+
+        [[nodiscard]] std::size_t Size() const noexcept
+        {
+            return Tx.size();
+        }
+    };
+
+    enum class SimdPath
+    {
+        Scalar,
+        SSE2,        // x86-64 baseline, 4 objects at a time
+        AVX2,        // 8 objects at a time, picked at runtime when the cpu has AVX2 + FMA
+        WasmSimd128  // emscripten build with -msimd128
+    };
+
+    // the widest path this build and this cpu can run
+    [[nodiscard]] SimdPath         BestSimdPath() noexcept;
+    [[nodiscard]] bool             IsSimdPathSupported(SimdPath path) noexcept;
+    [[nodiscard]] std::string_view ToString(SimdPath path) noexcept;
+
+    // For every object i and every shape point j writes
+    //   out[i * shape_x.size() + j] = { transform_i * (shape_x[j], shape_y[j]), color_i }
+    // out needs room for batch.Size() * shape_x.size() vertices. It can be a mapped buffer, each object's vertices are written front to back.
+    void TransformShapes(const TransformBatch& batch, std::span<const float> shape_x, std::span<const float> shape_y, Vertex* out, SimdPath path = BestSimdPath());
+}
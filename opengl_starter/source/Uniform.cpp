@@ -0,0 +1,106 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "Uniform.hpp"
+
+#include "FrameCapture.hpp"
+#include <GL/glew.h>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstring>
+
+namespace
+{
+    OpenGL::UniformStatistics gUniformStatistics;
+
+    // returns the slot to upload to, or nullptr when there is nothing to do
+    // bytes are compared rather than floats so -0.0 vs 0.0 and NaNs still count as changes
+    template <std::size_t N>
+    [[nodiscard]] OpenGL::UniformSlot* changed_slot(OpenGL::CompiledShader& shader, OpenGL::UniformID id, const std::array<float, N>& value)
+    {
+        static_assert(N <= std::tuple_size_v<decltype(OpenGL::UniformSlot::Value)>);
+        if (id >= shader.UniformSlots.size() || shader.UniformSlots[id].Location < 0)
+        {
+            return nullptr;
+        }
+        auto& slot = shader.UniformSlots[id];
+        if (slot.HasValue && std::memcmp(value.data(), slot.Value.data(), sizeof(value)) == 0)
+        {
+            ++gUniformStatistics.Skipped;
+            return nullptr;
+        }
+        std::copy(value.begin(), value.end(), slot.Value.begin());
+        slot.HasValue = true;
+        ++gUniformStatistics.Uploads;
+        return &slot;
+    }
+}
+
+namespace OpenGL
+{
+    void SetUniform(CompiledShader& shader, UniformID id, const Math::mat3& value)
+    {
+        if (const auto* slot = changed_slot(shader, id, value))
+        {
+            glUniformMatrix3fv(slot->Location, 1, GL_FALSE, value.data());
+            CaptureRecord(CaptureOp::Uniform, slot->Location, std::uint8_t{ 9 }, value);
+        }
+    }
+
+    void SetUniform(CompiledShader& shader, UniformID id, float x)
+    {
+        if (const auto* slot = changed_slot(shader, id, std::array{ x }))
+        {
+            glUniform1f(slot->Location, x);
+            CaptureRecord(CaptureOp::Uniform, slot->Location, std::uint8_t{ 1 }, std::array{ x });
+        }
+    }
+
+    void SetUniform(CompiledShader& shader, UniformID id, float x, float y)
+    {
+        if (const auto* slot = changed_slot(shader, id, std::array{ x, y }))
+        {
+            glUniform2f(slot->Location, x, y);
+            CaptureRecord(CaptureOp::Uniform, slot->Location, std::uint8_t{ 2 }, std::array{ x, y });
+        }
+    }
+
+    void SetUniform(CompiledShader& shader, UniformID id, float x, float y, float z)
+    {
+        if (const auto* slot = changed_slot(shader, id, std::array{ x, y, z }))
+        {
+            glUniform3f(slot->Location, x, y, z);
+            CaptureRecord(CaptureOp::Uniform, slot->Location, std::uint8_t{ 3 }, std::array{ x, y, z });
+        }
+    }
+
+    void SetUniform(CompiledShader& shader, UniformID id, float x, float y, float z, float w)
+    {
+        if (const auto* slot = changed_slot(shader, id, std::array{ x, y, z, w }))
+        {
+            glUniform4f(slot->Location, x, y, z, w);
+            CaptureRecord(CaptureOp::Uniform, slot->Location, std::uint8_t{ 4 }, std::array{ x, y, z, w });
+        }
+    }
+
+    void SetUniform(CompiledShader& shader, UniformID id, int value)
+    {
+        // stored by its bits, the cache only ever compares
+        if (const auto* slot = changed_slot(shader, id, std::array{ std::bit_cast<float>(value) }))
+        {
+            glUniform1i(slot->Location, value);
+            CaptureRecord(CaptureOp::UniformInt, slot->Location, value);
+        }
+    }
+
+    UniformStatistics& GetUniformStatistics() noexcept
+    {
+        return gUniformStatistics;
+    }
+}
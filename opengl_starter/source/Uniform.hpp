@@ -0,0 +1,43 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include "Math.hpp"
+#include "Shader.hpp"
+#include <cstdint>
+
+namespace OpenGL
+{
+    // ids for the uniforms our shaders share, interned the first time anyone touches them
+    namespace UniformIDs
+    {
+        inline const UniformID uModel = InternUniformName("uModel");
+        inline const UniformID uToNDC = InternUniformName("uToNDC");
+        inline const UniformID uColor = InternUniformName("uColor");
+        inline const UniformID uTime  = InternUniformName("uTime");
+    }
+
+    struct UniformStatistics
+    {
+        std::uint64_t Uploads = 0; // glUniform* calls made
+        std::uint64_t Skipped = 0; // same value as last time, nothing sent
+    };
+
+    // shader has to be the program currently in use (glUseProgram).
+    // Uniforms the program doesn't have are ignored, like glUniform* does with location -1.
+    // The value is compared with the last one sent through these functions and dropped if it matches
+    void SetUniform(CompiledShader& shader, UniformID id, const Math::mat3& value);
+    void SetUniform(CompiledShader& shader, UniformID id, float x);
+    void SetUniform(CompiledShader& shader, UniformID id, float x, float y);
+    void SetUniform(CompiledShader& shader, UniformID id, float x, float y, float z);
+    void SetUniform(CompiledShader& shader, UniformID id, float x, float y, float z, float w);
+    void SetUniform(CompiledShader& shader, UniformID id, int value);
+
+    // reset with GetUniformStatistics() = {}
+    [[nodiscard]] UniformStatistics& GetUniformStatistics() noexcept;
+}
@@ -0,0 +1,30 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "Vertex.hpp"
+
+#include "FrameCapture.hpp"
+#include "VertexLayout.hpp"
+
+namespace OpenGL
+{
+    void DescribeVertexLayout()
+    {
+        // location 0 : float x,y | location 1 : float r,g,b, see GetVertexLayout() for the compact formats
+        DescribeVertexLayout(GetVertexLayout(VertexFormat::Float));
+    }
+
+    void DescribeVertexLayout(const VertexLayout& layout, GLuint divisor, std::size_t base_offset)
+    {
+        for (const auto& attribute : layout.GetAttributes())
+        {
+            EnableVertexAttribArray(attribute.Location);
+            VertexAttribPointer(attribute.Location, attribute.Components, attribute.Type, attribute.Normalized, layout.Stride, base_offset + attribute.Offset);
+            VertexAttribDivisor(attribute.Location, divisor);
+        }
+    }
+}
@@ -0,0 +1,25 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+namespace OpenGL
+{
+    // {x,y,r,g,b} : location 0 is the 2d position, location 1 is the rgb color
+    struct Vertex
+    {
+        float x;
+        float y;
+        float r;
+        float g;
+        float b;
+    };
+
+    // describe the Vertex layout to the currently bound VAO
+    // the vertex buffer has to be bound to GL_ARRAY_BUFFER before calling this
+    void DescribeVertexLayout();
+}
@@ -0,0 +1,288 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "VertexLayout.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <gsl/gsl>
+
+namespace
+{
+    using OpenGL::Vertex;
+
+    // what each compact format looks like in the buffer, alpha is padding so the stride stays a multiple of 4
+    struct PackedColorVertex
+    {
+        float        x;
+        float        y;
+        std::uint8_t r;
+        std::uint8_t g;
+        std::uint8_t b;
+        std::uint8_t a;
+    };
+
+    struct HalfVertex
+    {
+        std::uint16_t x;
+        std::uint16_t y;
+        std::uint8_t  r;
+        std::uint8_t  g;
+        std::uint8_t  b;
+        std::uint8_t  a;
+    };
+
+    struct ShortVertex
+    {
+        std::int16_t x;
+        std::int16_t y;
+        std::uint8_t r;
+        std::uint8_t g;
+        std::uint8_t b;
+        std::uint8_t a;
+    };
+
+    static_assert(sizeof(Vertex) == 20 && sizeof(PackedColorVertex) == 12 && sizeof(HalfVertex) == 8 && sizeof(ShortVertex) == 8);
+
+    [[nodiscard]] std::uint8_t to_unorm8(float value) noexcept
+    {
+        return static_cast<std::uint8_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 255.0f));
+    }
+
+    [[nodiscard]] float from_unorm8(std::uint8_t value) noexcept
+    {
+        return static_cast<float>(value) / 255.0f;
+    }
+
+    [[nodiscard]] std::int16_t to_snorm16(float value) noexcept
+    {
+        return static_cast<std::int16_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * 32767.0f));
+    }
+
+    // same rule as GL ES 3 : -32768 and -32767 both mean -1
+    [[nodiscard]] float from_snorm16(std::int16_t value) noexcept
+    {
+        return std::max(static_cast<float>(value) / 32767.0f, -1.0f);
+    }
+
+    template <typename Encoded>
+    [[nodiscard]] OpenGL::VertexLayout describe(GLenum position_type, bool position_normalized)
+    {
+        OpenGL::VertexLayout layout;
+        layout.Attributes[0]  = OpenGL::VertexAttribute{ 0, 2, position_type, position_normalized, offsetof(Encoded, x) };
+        layout.Attributes[1]  = OpenGL::VertexAttribute{ 1, 4, GL_UNSIGNED_BYTE, true, offsetof(Encoded, r) };
+        layout.AttributeCount = 2;
+        layout.Stride         = sizeof(Encoded);
+        return layout;
+    }
+
+    template <typename Encoded, typename Encode>
+    [[nodiscard]] std::vector<std::byte> encode_all(std::span<const Vertex> vertices, Encode encode)
+    {
+        std::vector<std::byte> bytes(vertices.size() * sizeof(Encoded));
+        for (std::size_t i = 0; i < vertices.size(); ++i)
+        {
+            const Encoded encoded = encode(vertices[i]);
+            std::memcpy(bytes.data() + i * sizeof(Encoded), &encoded, sizeof(Encoded));
+        }
+        return bytes;
+    }
+
+    template <typename Encoded, typename Decode>
+    [[nodiscard]] std::vector<Vertex> decode_all(std::span<const std::byte> bytes, Decode decode)
+    {
+        std::vector<Vertex> vertices(bytes.size() / sizeof(Encoded));
+        for (std::size_t i = 0; i < vertices.size(); ++i)
+        {
+            Encoded encoded;
+            std::memcpy(&encoded, bytes.data() + i * sizeof(Encoded), sizeof(Encoded));
+            vertices[i] = decode(encoded);
+        }
+        return vertices;
+    }
+
+    template <typename Index>
+    void encode_indices(std::span<const std::uint32_t> indices, std::vector<std::byte>& bytes)
+    {
+        bytes.resize(indices.size() * sizeof(Index));
+        for (std::size_t i = 0; i < indices.size(); ++i)
+        {
+            const auto index = gsl::narrow<Index>(indices[i]);
+            std::memcpy(bytes.data() + i * sizeof(Index), &index, sizeof(Index));
+        }
+    }
+}
+
+namespace OpenGL
+{
+    std::string_view ToString(VertexFormat format) noexcept
+    {
+        switch (format)
+        {
+            case VertexFormat::Float: return "float";
+            case VertexFormat::PackedColor: return "packed";
+            case VertexFormat::HalfPosition: return "half";
+            case VertexFormat::ShortPosition: return "short";
+        }
+        return "unknown";
+    }
+
+    std::optional<VertexFormat> VertexFormatFromString(std::string_view name) noexcept
+    {
+        for (const auto format : AllVertexFormats)
+        {
+            if (ToString(format) == name)
+            {
+                return format;
+            }
+        }
+        return std::nullopt;
+    }
+
+    VertexLayout GetVertexLayout(VertexFormat format) noexcept
+    {
+        switch (format)
+        {
+            case VertexFormat::Float: break;
+            case VertexFormat::PackedColor: return describe<PackedColorVertex>(GL_FLOAT, false);
+            case VertexFormat::HalfPosition: return describe<HalfVertex>(GL_HALF_FLOAT, false);
+            case VertexFormat::ShortPosition: return describe<ShortVertex>(GL_SHORT, true);
+        }
+        // {x,y,*r*,g,b} : 3 float color right after the position
+        VertexLayout layout;
+        layout.Attributes[0]  = VertexAttribute{ 0, 2, GL_FLOAT, false, offsetof(Vertex, x) };
+        layout.Attributes[1]  = VertexAttribute{ 1, 3, GL_FLOAT, false, offsetof(Vertex, r) };
+        layout.AttributeCount = 2;
+        layout.Stride         = sizeof(Vertex);
+        return layout;
+    }
+
+    std::vector<std::byte> EncodeVertices(std::span<const Vertex> vertices, VertexFormat format)
+    {
+        switch (format)
+        {
+            case VertexFormat::Float: break;
+            case VertexFormat::PackedColor:
+                return encode_all<PackedColorVertex>(vertices, [](const Vertex& v) { return PackedColorVertex{ v.x, v.y, to_unorm8(v.r), to_unorm8(v.g), to_unorm8(v.b), 255 }; });
+            case VertexFormat::HalfPosition:
+                return encode_all<HalfVertex>(vertices, [](const Vertex& v) { return HalfVertex{ FloatToHalf(v.x), FloatToHalf(v.y), to_unorm8(v.r), to_unorm8(v.g), to_unorm8(v.b), 255 }; });
+            case VertexFormat::ShortPosition:
+                return encode_all<ShortVertex>(vertices, [](const Vertex& v) { return ShortVertex{ to_snorm16(v.x), to_snorm16(v.y), to_unorm8(v.r), to_unorm8(v.g), to_unorm8(v.b), 255 }; });
+        }
+        const auto bytes = std::as_bytes(vertices);
+        return std::vector<std::byte>(bytes.begin(), bytes.end());
+    }
+
+    std::vector<Vertex> DecodeVertices(std::span<const std::byte> bytes, VertexFormat format)
+    {
+        switch (format)
+        {
+            case VertexFormat::Float: break;
+            case VertexFormat::PackedColor:
+                return decode_all<PackedColorVertex>(bytes, [](const PackedColorVertex& v) { return Vertex{ v.x, v.y, from_unorm8(v.r), from_unorm8(v.g), from_unorm8(v.b) }; });
+            case VertexFormat::HalfPosition:
+                return decode_all<HalfVertex>(bytes, [](const HalfVertex& v) { return Vertex{ HalfToFloat(v.x), HalfToFloat(v.y), from_unorm8(v.r), from_unorm8(v.g), from_unorm8(v.b) }; });
+            case VertexFormat::ShortPosition:
+                return decode_all<ShortVertex>(bytes, [](const ShortVertex& v) { return Vertex{ from_snorm16(v.x), from_snorm16(v.y), from_unorm8(v.r), from_unorm8(v.g), from_unorm8(v.b) }; });
+        }
+        return decode_all<Vertex>(bytes, [](const Vertex& v) { return v; });
+    }
+
+    GLenum ChooseIndexType(std::size_t vertex_count) noexcept
+    {
+        // WebGL2 always has primitive restart on, so 0xFFFF is not a usable 16 bit index there
+        constexpr std::size_t max_16_bit_vertices = 0xFFFF;
+        return (vertex_count <= max_16_bit_vertices) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+    }
+
+    std::size_t IndexSize(GLenum index_type) noexcept
+    {
+        switch (index_type)
+        {
+            case GL_UNSIGNED_BYTE: return 1;
+            case GL_UNSIGNED_SHORT: return 2;
+            default: return 4;
+        }
+    }
+
+    std::vector<std::byte> EncodeIndices(std::span<const std::uint32_t> indices, GLenum index_type)
+    {
+        std::vector<std::byte> bytes;
+        switch (index_type)
+        {
+            case GL_UNSIGNED_BYTE: encode_indices<std::uint8_t>(indices, bytes); break;
+            case GL_UNSIGNED_SHORT: encode_indices<std::uint16_t>(indices, bytes); break;
+            default: encode_indices<std::uint32_t>(indices, bytes); break;
+        }
+        return bytes;
+    }
+
+    std::uint16_t FloatToHalf(float value) noexcept
+    {
+        const auto          bits      = std::bit_cast<std::uint32_t>(value);
+        const auto          sign      = static_cast<std::uint16_t>((bits >> 16) & 0x8000u);
+        const std::uint32_t magnitude = bits & 0x7FFF'FFFFu;
+
+        if (magnitude >= 0x7F80'0000u)
+        {
+            // inf stays inf, nan stays a (quiet) nan
+            return static_cast<std::uint16_t>(sign | 0x7C00u | ((magnitude > 0x7F80'0000u) ? 0x0200u : 0u));
+        }
+        if (magnitude >= 0x4780'0000u)
+        {
+            // 65536 and up, too big for a half
+            return static_cast<std::uint16_t>(sign | 0x7C00u);
+        }
+        if (magnitude < 0x3880'0000u)
+        {
+            // under 2^-14 : subnormal half (or zero), the value is m * 2^-24
+            if (magnitude < 0x3300'0000u)
+            {
+                return sign; // under 2^-25 rounds to 0
+            }
+            const std::uint32_t exponent = magnitude >> 23;
+            const std::uint32_t mantissa = (magnitude & 0x007F'FFFFu) | 0x0080'0000u;
+            const std::uint32_t shift    = 126u - exponent;
+            std::uint32_t       half     = mantissa >> shift;
+            const std::uint32_t rest     = mantissa & ((1u << shift) - 1u);
+            const std::uint32_t halfway  = 1u << (shift - 1u);
+            if (rest > halfway || (rest == halfway && (half & 1u) != 0))
+            {
+                ++half;
+            }
+            return static_cast<std::uint16_t>(sign | half);
+        }
+
+        // rebias the exponent from 127 to 15 and drop 13 mantissa bits, a carry into the exponent is still right
+        std::uint32_t       half = (magnitude - 0x3800'0000u) >> 13;
+        const std::uint32_t rest = magnitude & 0x1FFFu;
+        if (rest > 0x1000u || (rest == 0x1000u && (half & 1u) != 0))
+        {
+            ++half;
+        }
+        return static_cast<std::uint16_t>(sign | half);
+    }
+
+    float HalfToFloat(std::uint16_t half) noexcept
+    {
+        const std::uint32_t sign     = (half & 0x8000u) << 16;
+        const std::uint32_t exponent = (half >> 10) & 0x1Fu;
+        const std::uint32_t mantissa = half & 0x03FFu;
+        if (exponent == 0)
+        {
+            const float value = std::ldexp(static_cast<float>(mantissa), -24);
+            return (sign != 0) ? -value : value;
+        }
+        if (exponent == 0x1F)
+        {
+            return std::bit_cast<float>(sign | 0x7F80'0000u | (mantissa << 13));
+        }
+        return std::bit_cast<float>(sign | ((exponent + 112u) << 23) | (mantissa << 13));
+    }
+}
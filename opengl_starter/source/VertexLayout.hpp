@@ -0,0 +1,82 @@
+/**
+ * \file
+ * \author Rudy Castan
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include "Vertex.hpp"
+#include <GL/glew.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace OpenGL
+{
+    // one glVertexAttribPointer call
+    struct VertexAttribute
+    {
+        GLuint      Location   = 0;
+        GLint       Components = 0;
+        GLenum      Type       = GL_FLOAT;
+        bool        Normalized = false; // integer types read as [0,1] / [-1,1] floats by the shader
+        std::size_t Offset     = 0;
+    };
+
+    // how one vertex is laid out in a buffer, enough to describe it to a VAO
+    struct VertexLayout
+    {
+        static constexpr std::size_t MaxAttributes = 4;
+
+        std::array<VertexAttribute, MaxAttributes> Attributes{};
+        std::size_t                                AttributeCount = 0;
+        GLsizei                                    Stride         = 0;
+
+        [[nodiscard]] std::span<const VertexAttribute> GetAttributes() const noexcept
+        {
+            return std::span{ Attributes }.first(AttributeCount);
+        }
+    };
+
+    // Smaller ways to store a Vertex in a gpu buffer. They all have the same two attributes (location 0 position,
+    // location 1 color) and the vertex fetch turns half / normalized values back into floats,
+    // so the shaders don't need to change.
+    enum class VertexFormat
+    {
+        Float,         // float x,y   + float r,g,b     20 bytes, what Vertex is
+        PackedColor,   // float x,y   + unorm8 r,g,b,a  12 bytes
+        HalfPosition,  // half x,y    + unorm8 r,g,b,a   8 bytes, ~3 significant digits
+        ShortPosition, // snorm16 x,y + unorm8 r,g,b,a   8 bytes, positions have to be inside [-1,1]
+    };
+
+    inline constexpr std::array AllVertexFormats{ VertexFormat::Float, VertexFormat::PackedColor, VertexFormat::HalfPosition, VertexFormat::ShortPosition };
+
+    [[nodiscard]] std::string_view            ToString(VertexFormat format) noexcept;
+    [[nodiscard]] std::optional<VertexFormat> VertexFormatFromString(std::string_view name) noexcept;
+    [[nodiscard]] VertexLayout                GetVertexLayout(VertexFormat format) noexcept;
+
+    // enables and points every attribute of the layout at the buffer bound to GL_ARRAY_BUFFER, for the bound VAO
+    // base_offset : where the first vertex starts in the buffer, streamed data moves around every draw.
+    // It lives in Vertex.cpp with the rest of the gl side, cs200_meshc links this file without gl
+    void DescribeVertexLayout(const VertexLayout& layout, GLuint divisor = 0, std::size_t base_offset = 0);
+
+    // Vertex -> format, ready for glBufferData. Decode gives back what the shader is going to see
+    [[nodiscard]] std::vector<std::byte> EncodeVertices(std::span<const Vertex> vertices, VertexFormat format);
+    [[nodiscard]] std::vector<Vertex>    DecodeVertices(std::span<const std::byte> bytes, VertexFormat format);
+
+    // 16 bit indices when they can reach every vertex, 32 bit otherwise
+    [[nodiscard]] GLenum      ChooseIndexType(std::size_t vertex_count) noexcept;
+    [[nodiscard]] std::size_t IndexSize(GLenum index_type) noexcept;
+    // throws gsl::narrowing_error if an index doesn't fit index_type
+    [[nodiscard]] std::vector<std::byte> EncodeIndices(std::span<const std::uint32_t> indices, GLenum index_type);
+
+    // IEEE half float, round to nearest even
+    [[nodiscard]] std::uint16_t FloatToHalf(float value) noexcept;
+    [[nodiscard]] float         HalfToFloat(std::uint16_t half) noexcept;
+}
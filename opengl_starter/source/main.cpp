@@ -8,9 +8,25 @@
 #include <GL/glew.h>
 #include <SDL.h>
 #include <gsl/gsl> //owner template
+#include <imgui.h>
+#include <imgui_impl_opengl3.h>
+#include <imgui_impl_sdl2.h>
 #include <iostream>
-#include <array> //feed array to vertex shader, and vertex shader do NDC
-#include "Handle.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include "Benchmarks.hpp"
+#include "FrameCapture.hpp"
+#include "FrameScheduler.hpp"
+#include "GLState.hpp"
+#include "GpuResources.hpp"
+#include "Profiler.hpp"
+#include "Scenes.hpp"
 #include "Shader.hpp"
 
 gsl::owner<SDL_Window*>   gWindow  = nullptr; //mental reminder
@@ -40,174 +56,209 @@ EMSCRIPTEN_BINDINGS(main_window)
 
 gsl::owner<SDL_GLContext> gContext = nullptr; 
 bool                      gIsDone  = false;
-OpenGL::CompiledShader gShader;
-//keep track of GPU resources by creating a handle
-OpenGL::Handle gVertexBuffer; //hold the unique set of vertices
-OpenGL::Handle gIndexBuffer;
-//collect all together
-OpenGL::Handle gVertexArrayObject; // handle to our model data , everything that the model needs
-GLsizei                   gIndicesCount = 0;
-int                       gWidth = 800;
-int                       gHeight = 600;
-
-void setup()
-{
-    //raw string supported by C++
-    //version(webgl2 == opengl3),describe what kind of layout our vertices are going to be 
-    //location0 - very first variable-attribute
-    //order doesn't matter
-    //gl_Position - put clip space if we're doing 3D or NDC if 2D(check PDF!)
-    //in normaly we have to transformation our coordinates 
-    //but now, we hardcoded to get our positon already in NDC space so don't care
-    //w has to be 1, -1 to +1 with z
-
-    //need to be interpolated across the vertices(triangle)
-    //triangle color from vertex shader -> (*) -> fragment shader
-    //to communicate, make out variable vec3
-    /*=======================================================================================================*/
-
-    //in open gl, elements are specified in column order
-    // ex) {1,2 //first column , 3,4 //second column}
-    // multiply mat2 to scale
-    // model -(with model matrix,Mm)> world -(with view matrix,Mview)> camera/view -(with ndc, Mndc)> normalized -(with viewport, Mviewport)>  screen ->framebuffer
-    // we don't care Mview(world->camera) yet
-    // if we want to matrix that affect whole models(not a single vertex), we can make in glsl uniform(all same) transformation matrix
-
-    //**gl use floats only
-    //to feed real matrix to uModel and uToNDC....go to game logic
-    const auto vertex_glsl = R"(#version 300 es
-layout(location = 0) in vec2 aVertexPosition;
-layout(location = 1) in vec3 aVertexColor;
-uniform mat3 uModel;
-uniform mat3 uToNDC;
-out vec3 vColor;
-void main()
-{
-    vec3 cam_position = uModel * vec3(aVertexPosition, 1.0);
-    vec3 ndc_position = uToNDC * cam_position;
-    gl_Position = vec4(ndc_position, 0.0, 1.0);
-    vColor = aVertexColor;
+// gWidth, gHeight and the picked scene live in Scenes.cpp, the headless bench draws the same things
+bool                      gUseShaderCache = true;
+std::function<void()>     gRunOnceBenchmark;       // set from the command line : run it after the context is up, then quit
+int                       gExitCode = 0;           // 1 when a run-once benchmark's own check failed
+Timing::FrameScheduler    gFrameScheduler;         // fixed step updates + one render per main_loop()
+bool                      gUseVsync        = true;
+bool                      gShowFramePacing = true; // F1
+std::filesystem::path     gCapturePath;            // --capture FILE, started before setup() so the file has everything
+int                       gCaptureFrames   = 600;
+#ifdef DEVELOPER_VERSION
+bool                  gShowProfiler = true; // F2
+std::filesystem::path gTracePath;           // --trace FILE, written when the app closes
+#endif
 
-}
-)";
-//now put things to the fragment shader
-//decide precision
-    const auto fragment_glst = R"(#version 300 es
-precision mediump float;
+// frame time is measured between two main_loop() calls and printed once a second
+struct FrameReport
+{
+    using clock = std::chrono::steady_clock;
+    clock::time_point LastFrame    = clock::now();
+    clock::time_point LastPrint    = clock::now();
+    double            AccumulatedMs = 0.0;
+    int               Frames        = 0;
+};
 
-in vec3 vColor;
-out vec4 FragColor;
+FrameReport gFrameReport;
 
-void main()
+void main_loop();
+void apply_vsync();
+void draw_imgui();
+void draw_frame_pacing_window();
+void report_frame_time();
+void capture_input(const SDL_Event& event);
+
+// true when argv[i] has a value after it that isn't the next option
+bool next_is_value(int argc, char* argv[], int i)
 {
-    FragColor = vec4(vColor, 1.0);
+    return i + 1 < argc && !std::string_view{ argv[i + 1] }.starts_with("--");
 }
-)";
-    gShader                  = OpenGL::CreateShader(std::string_view{ vertex_glsl }, std::string_view{ fragment_glst });
 
-    struct vertex
+// the optional [N] of a run-once benchmark, fallback when no number follows. Throws std::invalid_argument if it isn't one
+int optional_count(int argc, char* argv[], int& i, int fallback, int minimum)
+{
+    if (!next_is_value(argc, argv, i))
     {
-        float x;
-        float y;
-        float r;
-        float g;
-        float b;
-    };
-
-    const vertex vertices[] = {
-        // face verts
-        {   -0.5,   -0.5, 1, 1, 0 },
-        {   +0.5,   -0.5, 1, 1, 0 },
-        {   +0.5,   +0.5, 1, 1, 0 },
-        {   -0.5,   +0.5, 1, 1, 0 },
-        // left eye
-        { -0.375, +0.125, 0, 0, 0 },
-        { -0.125, +0.125, 0, 0, 0 },
-        { -0.125,  +0.25, 0, 0, 0 },
-        { -0.375,  +0.25, 0, 0, 0 },
-        // right eye
-        { +0.125, +0.125, 0, 0, 0 },
-        { +0.375, +0.125, 0, 0, 0 },
-        { +0.375,  +0.25, 0, 0, 0 },
-        { +0.125,  +0.25, 0, 0, 0 },
-        // left mouth part
-        { -0.375,  -0.25, 0, 0, 0 },
-        {  -0.25,  -0.25, 0, 0, 0 },
-        {  -0.25, -0.125, 0, 0, 0 },
-        { -0.375, -0.125, 0, 0, 0 },
-        // right mouth part
-        {  +0.25,  -0.25, 0, 0, 0 },
-        { +0.375,  -0.25, 0, 0, 0 },
-        { +0.375, -0.125, 0, 0, 0 },
-        {  +0.25, -0.125, 0, 0, 0 },
-        // bottom middle mouth
-        {  -0.25, -0.375, 0, 0, 0 },
-        {  +0.25, -0.375, 0, 0, 0 },
-    };
-
-    // Triangle indices
-    const unsigned short indices[] = { // face
-                                       0, 1, 2, 0, 2, 3,
-                                       // left eye
-                                       4, 5, 6, 4, 6, 7,
-                                       // right eye
-                                       8, 9, 10, 8, 10, 11,
-                                       // mouth
-                                       // left mouth part
-                                       12, 13, 14, 12, 14, 15, 12, 20, 13,
-                                       // right mouth part
-                                       16, 17, 18, 16, 18, 19, 16, 21, 17,
-                                       // middle mouth part
-                                       20, 21, 16, 20, 16, 13
-
-    };
-    gIndicesCount = static_cast<GLsizei>(std::ssize(indices));//size for just size, ssize for signed size
-
-    // buffer of vertex data
-    glGenBuffers(1, &gVertexBuffer); //generate buffers, set up to create many buffers all in one go, create a unique ID
-    glBindBuffer(GL_ARRAY_BUFFER, gVertexBuffer); //feed this vertex buffer with my verticies data but before bind unique buffer, param : type of buffer, param : unique id
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW); //feed, param : type, param : size, param : real data(decay to pointer), param : static/dynamic
-    glBindBuffer(GL_ARRAY_BUFFER, 0); // unbind - good practice, 0 means nothing : no buffer
-
-    // buffer of index data
-    glGenBuffers(1, &gIndexBuffer); 
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, gIndexBuffer); // opengl use word 'element' to specify indices
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-
-    // vertex array object - collection of the vertices and indices and description of how they're organized : model
-    glGenVertexArrays(1, &gVertexArrayObject);
-    glBindVertexArray(gVertexArrayObject);
-    // associate our vertex&index buffers with this VAO
-    glBindBuffer(GL_ARRAY_BUFFER, gVertexBuffer);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, gIndexBuffer);
-
-    // tell opengl how we organized the vertices for the vertex shader
-    // to feed our data into the vertex shader
-    // we have to attributes (location 0, location 1) -> we have to turn them on and describe them
-    
-    // describes our 2d position
-    glEnableVertexAttribArray(0); //turn on location 0
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(vertex),nullptr); //param : index(location), dimension(2d), type, should we normalize?(no, we hardcorded), stride: how many amount of jump do we need to go next data, location of the very first bytes to be read : 0, but it takes void* so..
-    glVertexAttribDivisor(0, 0);//called instancing..not now, param : index, how many instances of this mode need this value ; don't need this right now but use in assign
-    
-    // describes our rgb color
-    glEnableVertexAttribArray(1); //turn on location 1
-    ptrdiff_t offset = 2 * sizeof(float); //because {x,y,*r*,g,b} -> need 2 offset!
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(vertex), reinterpret_cast<void*>(offset));
-    glVertexAttribDivisor(1, 0);
-
-    //un-select VAO&buffers, unbind
-    glBindVertexArray(0);
-    glBindBuffer(GL_ARRAY_BUFFER, 0); //**already unbind??
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-    
+        return fallback;
+    }
+    const std::string_view option = argv[i];
+    return std::max(minimum, parse_int_option(option, argv[++i]));
 }
 
-void main_loop();
-
-int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[])
+int main(int argc, char* argv[])
 {
+    // --batch N : draw N quads with the batch renderer and print draw calls / frame time
+    // --faces N [--instanced | --recorded [--jobs N]] : draw N faces, keys 1/2/3 pick 1k/10k/100k and 'i' cycles per object / instanced / recorded
+    // --world N [--no-culling] : N quads (default 100k, up to 1M) on a map that grows with N, only what's on screen gets drawn, 'c' toggles culling
+    // --sprites N [--upload-budget MB] : N sprites (default 10k) from Assets/sprites and generated images, all in one texture atlas
+    // --no-shader-cache : always compile shaders from source
+    // --shader-benchmark [N] : compile N synthetic programs serially and through a ShaderLibrary, then quit
+    // --uniform-benchmark [N] : N mat3 uploads by name lookup vs by UniformID, then quit
+    // --transform-benchmark [N] : N quads through each SIMD path of the cpu transform kernel, then quit
+    // --vertex-format-benchmark [N] : a mesh of N vertices drawn in every vertex format, then quit
+    // --vertex-format NAME : float, packed, half or short storage for the face mesh
+    // --stream NAME : orphan, unsync or persistent vertex streaming for --batch
+    // --stream-benchmark [MB] : 1, 4, 16... up to MB (default 64) streamed per frame with every strategy, then quit
+    // --mesh FILE : draw a .mesh made by cs200_meshc instead of the built in face
+    // --mesh-benchmark [DIR] : load every .mesh under DIR (default Assets) against parsing their .obj / .json, then quit
+    // --file-benchmark [N] : Assets/shaders copied into N files (default 4000), read back every way we have, then quit
+    // --hot-reload : the face shader is loaded from Assets/shaders and recompiled when the files change
+    // --reload-benchmark : per frame cost and edit to swap latency of shader hot reload, then quit
+    // --record-benchmark [N] : N objects (default 100k) recorded into command buffers on 1..every core, then submitted unsorted and sorted, then quit
+    // --queue-benchmark [N] : N random draws (default 50k) submitted as recorded, sorted, merged and multidrawn, then quit
+    // --cull-benchmark : spatial grid query / move cost and drawn objects for maps of 10k to 1M objects, against testing every object, then quit
+    // --atlas-benchmark [N] : N images (default 2000) packed into atlas pages, then decoded and uploaded with 1 / 4 / 16 MB per frame, then quit
+    // --resource-benchmark [N] : N meshes (default 1000) streamed in and out with and without the gpu resource pool, then quit
+    // --shape-benchmark [N] : N shapes (default 100k) tessellated every frame against cold and warm shape cache lookups, then quit
+    // --capture FILE [--capture-frames N] : the gl calls of the first N frames (default 600) and the input before them, for cs200_replay
+    // --trace FILE : the last 600 frames of profiling scopes as a Chrome trace when the app closes (developer builds)
+    // --update-hz N : fixed simulation rate (default 60)
+    // --frame-cap N : render at most N frames a second, for when vsync is off
+    // --no-vsync
+    // a bad value is a usage error, not an exception out of main
+    try
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string_view arg = argv[i];
+            if (parse_scene_option(argc, argv, i))
+            {
+                continue;
+            }
+            if (arg == "--no-shader-cache")
+            {
+                gUseShaderCache = false;
+            }
+            else if (arg == "--shader-benchmark")
+            {
+                const int programs = optional_count(argc, argv, i, 64, 1);
+                gRunOnceBenchmark  = [programs] { Benchmarks::RunShaderLibraryBenchmark(programs); };
+            }
+            else if (arg == "--uniform-benchmark")
+            {
+                const int sets    = optional_count(argc, argv, i, 5'000'000, 1);
+                gRunOnceBenchmark = [sets] { Benchmarks::RunUniformLookupBenchmark(sets); };
+            }
+            else if (arg == "--transform-benchmark")
+            {
+                const int quads   = optional_count(argc, argv, i, 100'000, 1);
+                gRunOnceBenchmark = [quads] { gExitCode = Benchmarks::RunTransformKernelBenchmark(quads) ? 0 : 1; };
+            }
+            else if (arg == "--vertex-format-benchmark")
+            {
+                const int vertices = optional_count(argc, argv, i, 1'000'000, 4);
+                gRunOnceBenchmark  = [vertices] { Benchmarks::RunVertexFormatBenchmark(vertices); };
+            }
+            else if (arg == "--stream-benchmark")
+            {
+                const int megabytes = optional_count(argc, argv, i, 64, 1);
+                gRunOnceBenchmark   = [megabytes] { Benchmarks::RunStreamBufferBenchmark(megabytes); };
+            }
+            else if (arg == "--mesh-benchmark")
+            {
+                const std::filesystem::path directory = next_is_value(argc, argv, i) ? argv[++i] : "Assets";
+                gRunOnceBenchmark                     = [directory] { Benchmarks::RunMeshLoadBenchmark(directory); };
+            }
+            else if (arg == "--file-benchmark")
+            {
+                const int file_count = optional_count(argc, argv, i, 4000, 1);
+                gRunOnceBenchmark    = [file_count] { Benchmarks::RunFileLoadBenchmark(file_count); };
+            }
+            else if (arg == "--reload-benchmark")
+            {
+                gRunOnceBenchmark = [] { Benchmarks::RunShaderReloadBenchmark(); };
+            }
+            else if (arg == "--cull-benchmark")
+            {
+                gRunOnceBenchmark = [] { Benchmarks::RunCullingBenchmark(); };
+            }
+            else if (arg == "--record-benchmark")
+            {
+                const int objects = optional_count(argc, argv, i, 100'000, 1);
+                gRunOnceBenchmark = [objects] { Benchmarks::RunCommandRecordingBenchmark(objects); };
+            }
+            else if (arg == "--queue-benchmark")
+            {
+                const int draws   = optional_count(argc, argv, i, 50'000, 1);
+                gRunOnceBenchmark = [draws] { Benchmarks::RunRenderQueueBenchmark(draws); };
+            }
+            else if (arg == "--atlas-benchmark")
+            {
+                const int images  = optional_count(argc, argv, i, 2000, 1);
+                gRunOnceBenchmark = [images] { Benchmarks::RunTextureAtlasBenchmark(images); };
+            }
+            else if (arg == "--resource-benchmark")
+            {
+                const int meshes  = optional_count(argc, argv, i, 1000, 4);
+                gRunOnceBenchmark = [meshes] { Benchmarks::RunResourceBenchmark(meshes); };
+            }
+            else if (arg == "--shape-benchmark")
+            {
+                const int shapes  = optional_count(argc, argv, i, 100'000, 1);
+                gRunOnceBenchmark = [shapes] { Benchmarks::RunShapeCacheBenchmark(shapes); };
+            }
+            else if (arg == "--update-hz" && i + 1 < argc)
+            {
+                gFrameScheduler.GetSettings().UpdateHz = std::max(1.0, static_cast<double>(parse_float_option(arg, argv[++i])));
+            }
+            else if (arg == "--frame-cap" && i + 1 < argc)
+            {
+                gFrameScheduler.GetSettings().FrameCapHz = std::max(0.0, static_cast<double>(parse_float_option(arg, argv[++i])));
+            }
+            else if (arg == "--no-vsync")
+            {
+                gUseVsync = false;
+            }
+            else if (arg == "--capture" && i + 1 < argc)
+            {
+                gCapturePath = argv[++i];
+            }
+            else if (arg == "--capture-frames" && i + 1 < argc)
+            {
+                gCaptureFrames = std::max(1, parse_int_option(arg, argv[++i]));
+            }
+            else if (arg == "--trace" && i + 1 < argc)
+            {
+#ifdef DEVELOPER_VERSION
+                gTracePath = argv[++i];
+#else
+                ++i;
+                std::cout << "--trace needs a developer build, the profiling scopes are compiled out\n";
+#endif
+            }
+        }
+    }
+    catch (const std::invalid_argument& e)
+    {
+        std::cout << e.what() << '\n';
+        return 1;
+    }
+    if (gScene != Scene::Face)
+    {
+        gUseVsync = false; // benchmarks want the real frame time, not the monitor's
+    }
+
 #ifdef DEVELOPER_VERSION
     std::cout << "Developer Version\n";
 #endif
@@ -240,30 +291,68 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[])
 
     glewInit();
 
-    // Vsync
-    constexpr int ADAPTIVE_SYNC = -1; //better sync
-    constexpr int VSYNC         = 1; //if adaptive sync is failed..
-    if (const auto result = SDL_GL_SetSwapInterval(ADAPTIVE_SYNC); result != 0)
+    apply_vsync();
+
+    ImGui::CreateContext();
+    ImGui::StyleColorsDark();
+    ImGui_ImplSDL2_InitForOpenGL(gWindow, gContext);
+#ifdef IS_WEBGL2
+    ImGui_ImplOpenGL3_Init("#version 300 es");
+#else
+    ImGui_ImplOpenGL3_Init("#version 330");
+#endif
+    if (gRunOnceBenchmark)
     {
-        SDL_GL_SetSwapInterval(VSYNC); //do classic vsync
+        // no scene behind it, and on the web the main loop would never let us quit
+        gRunOnceBenchmark();
     }
-    setup();
-#if !defined(__EMSCRIPTEN__)
-    while (!gIsDone) //web - sometime it kills infinite loop so we have to use another func
+    else
     {
-       main_loop();
-    }
+        if (gUseShaderCache)
+        {
+            OpenGL::EnableShaderCache("shader_cache"); // next to where we run from
+        }
+        if (!gCapturePath.empty())
+        {
+            OpenGL::StartCapture(gCapturePath, gCaptureFrames);
+        }
+        setup();
+        if (gUseShaderCache)
+        {
+            const auto& cache = OpenGL::GetShaderCacheStatistics();
+            std::cout << "shader cache hits: " << cache.Hits << " (" << cache.LoadMilliseconds << " ms) | misses: " << cache.Misses << " (" << cache.CompileMilliseconds
+                      << " ms) | rejected: " << cache.Rejected << '\n';
+        }
+#if !defined(__EMSCRIPTEN__)
+        while (!gIsDone) //web - sometime it kills infinite loop so we have to use another func
+        {
+           main_loop();
+        }
 #else
-    const bool simulate_infinte_loop = true;
-    const int match_browser_framerate = -1; //match vsync rate
-    emscripten_set_main_loop(main_loop, match_browser_framerate, simulate_infinte_loop);
+        const bool simulate_infinte_loop = true;
+        const int match_browser_framerate = -1; //match vsync rate
+        emscripten_set_main_loop(main_loop, match_browser_framerate, simulate_infinte_loop);
 #endif
 
+        OpenGL::StopCapture();
+        shutdown(); // gl resources have to go before the context
+    }
+#ifdef DEVELOPER_VERSION
+    if (!gTracePath.empty())
+    {
+        Profiling::WriteChromeTrace(gTracePath);
+        std::cout << "trace written to " << gTracePath.string() << '\n';
+    }
+    Profiling::Shutdown();
+#endif
+    ImGui_ImplOpenGL3_Shutdown();
+    ImGui_ImplSDL2_Shutdown();
+    ImGui::DestroyContext();
     SDL_GL_DeleteContext(gContext);
     SDL_DestroyWindow(gWindow);
     SDL_Quit();
 
-    return 0;
+    return gExitCode;
 
     
 }
@@ -272,78 +361,219 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[])
 
 void main_loop()
 {
-    SDL_Event event;
-    while (SDL_PollEvent(&event) != 0)  //loop for event
+    PROFILE_BEGIN_FRAME();
     {
-        switch (event.type)
+        PROFILE_SCOPE("events");
+        SDL_Event event;
+        while (SDL_PollEvent(&event) != 0)  //loop for event
         {
-            case SDL_WINDOWEVENT:
-                if (event.window.event == SDL_WINDOWEVENT_CLOSE)
-                {
-                    gIsDone = true;
-                }
-                if (event.window.event == SDL_WINDOWEVENT_RESIZED || event.window.event == SDL_WINDOWEVENT_SIZE_CHANGED)
-                {
-                    gWidth  = event.window.data1;
-                    gHeight = event.window.data2;
-                }
-                break;
-            case SDL_WINDOWEVENT_RESIZED:
-            case SDL_WINDOWEVENT_SIZE_CHANGED: 
+            ImGui_ImplSDL2_ProcessEvent(&event);
+            capture_input(event);
+            switch (event.type)
+            {
+                case SDL_WINDOWEVENT:
+                    if (event.window.event == SDL_WINDOWEVENT_CLOSE)
+                    {
+                        gIsDone = true;
+                    }
+                    if (event.window.event == SDL_WINDOWEVENT_RESIZED || event.window.event == SDL_WINDOWEVENT_SIZE_CHANGED)
+                    {
+                        gWidth  = event.window.data1;
+                        gHeight = event.window.data2;
+                    }
+                    break;
+                case SDL_WINDOWEVENT_RESIZED:
+                case SDL_WINDOWEVENT_SIZE_CHANGED: 
                 
-                break;
-            case SDL_QUIT: gIsDone = true; break;
+                    break;
+                case SDL_QUIT: gIsDone = true; break;
+                case SDL_KEYDOWN:
+                    if (ImGui::GetIO().WantCaptureKeyboard)
+                    {
+                        break;
+                    }
+                    switch (event.key.keysym.sym)
+                    {
+                        case SDLK_1:
+                            if (gScene == Scene::FacesBenchmark) // the other scenes don't draw faces
+                            {
+                                gBenchmarkFaces = 1'000;
+                            }
+                            break;
+                        case SDLK_2:
+                            if (gScene == Scene::FacesBenchmark)
+                            {
+                                gBenchmarkFaces = 10'000;
+                            }
+                            break;
+                        case SDLK_3:
+                            if (gScene == Scene::FacesBenchmark)
+                            {
+                                gBenchmarkFaces = 100'000;
+                            }
+                            break;
+                        case SDLK_i:
+                            gFaceMode = (gFaceMode == FaceMode::PerObject) ? FaceMode::Instanced : (gFaceMode == FaceMode::Instanced) ? FaceMode::Recorded : FaceMode::PerObject;
+                            break;
+                        case SDLK_c: gCulling = !gCulling; break;
+                        case SDLK_F1: gShowFramePacing = !gShowFramePacing; break;
+    #ifdef DEVELOPER_VERSION
+                        case SDLK_F2: gShowProfiler = !gShowProfiler; break;
+    #endif
+                        default: break;
+                    }
+                    break;
+
+                default: break;
+            }
+            //
+        }//while loop for event
+    }
 
-            default: break;
-        }
-        //
-    }//while loop for event
-
-    // game logic
-    // drawing with opengl
-    glViewport(0, 0, gWidth, gHeight); // param : (offset.x,offset.y,width,height) useful to set offset if game has two player and each has their own camera , feed latest-updated window sized so..
-    glClearColor(0.34f, 0.56f, 0.9f, 1.0f); // just 'set' window color
-    glClear(GL_COLOR_BUFFER_BIT); //actually clear
-
-    //to feed to the uModel and uToNDC
-    // 2/w 0 0
-    // 0 2/h 0
-    // 0  0  1
-    std::array<float, 9> to_ndc{ 
-        2.0f / static_cast<float>(gWidth), 
-        0.0f, 
-        0.0f, //column 0
-        0.0f, 
-        2.0f / static_cast<float>(gHeight),
-        0.0f, //column 1
-        0.0f,
-        0.0f,
-        1.0f //column 2
-    };
-
-    std::array<float, 9> model{
-        128.0f,
-        0.0f,
-        0.0f, // column 0
-        0.0f,
-        128.0f,
-        0.0f, // column 1
-        0.0f,
-        0.0f,
-        1.0f // column 2
-    };
-    //in shader there is uniformlocations so we can send uniform, and change by index,,check createshader!
-
-    // drawing
-    glUseProgram(gShader.Shader);//ask gl to use shader
-    glUniformMatrix3fv(gShader.UniformLocations.at());//bind it first
-    glBindVertexArray(gVertexArrayObject); //select which model we want to draw
-
-    glDrawElements(GL_TRIANGLES, gIndicesCount, GL_UNSIGNED_SHORT, nullptr); // drawing, param : (type of primitive model, how many indices, type of indices, offset(sometime need to draw part of this))
-
-    glUseProgram(0); //unselect
-    glBindVertexArray(0);
-
-    // swap framebuffers - double buffer, so when drawing is done, now it's time to show on screen, painter metaphor..
-    SDL_GL_SwapWindow(gWindow);
+    // game logic at a fixed rate, then drawing once (check FrameScheduler.hpp)
+    const bool rendered = gFrameScheduler.Tick(
+        [](double step_seconds)
+        {
+            PROFILE_SCOPE("update");
+            update_scene(step_seconds);
+        },
+        [](double alpha)
+        {
+            draw_frame(alpha);
+            draw_imgui();
+        });
+    if (!rendered)
+    {
+        PROFILE_END_FRAME();
+        return; // frame cap on the web : too early, keep what's on screen
+    }
+
+    {
+        // swap framebuffers - double buffer, so when drawing is done, now it's time to show on screen, painter metaphor..
+        PROFILE_SCOPE("swap");
+        SDL_GL_SwapWindow(gWindow);
+    }
+    PROFILE_END_FRAME();
+
+    report_frame_time();
+}
+
+void capture_input(const SDL_Event& event)
+{
+    if (!OpenGL::IsCapturing())
+    {
+        return;
+    }
+    switch (event.type)
+    {
+        case SDL_WINDOWEVENT: OpenGL::CaptureInput({ event.type, event.window.event, event.window.data1, event.window.data2 }); break;
+        case SDL_KEYDOWN: OpenGL::CaptureInput({ event.type, event.key.keysym.sym, 0, 0 }); break;
+        case SDL_QUIT: OpenGL::CaptureInput({ event.type, 0, 0, 0 }); break;
+        default: break; // mouse motion would be most of the file, nothing reacts to it
+    }
+}
+
+void report_frame_time()
+{
+    using namespace std::chrono;
+    const auto now = FrameReport::clock::now();
+    gFrameReport.AccumulatedMs += duration<double, std::milli>(now - gFrameReport.LastFrame).count();
+    gFrameReport.LastFrame = now;
+    ++gFrameReport.Frames;
+    if (gScene == Scene::Face || now - gFrameReport.LastPrint < seconds{ 1 })
+    {
+        return;
+    }
+
+    const double average_ms = gFrameReport.AccumulatedMs / gFrameReport.Frames;
+    std::cout << scene_label() << ": " << gFrameStats.Objects << " | draw calls: " << gFrameStats.DrawCalls << " | state calls issued: " << gFrameStats.StateCallsIssued
+              << " elided: " << gFrameStats.StateCallsElided << " | uniform bytes: " << gFrameStats.UniformBytes
+              << " fence waits: " << gFrameStats.FenceWaits << " | frame: " << average_ms << " ms (" << 1000.0 / average_ms << " fps)\n";
+    gFrameReport = FrameReport{};
+}
+
+void apply_vsync()
+{
+    if (!gUseVsync)
+    {
+        SDL_GL_SetSwapInterval(0);
+        return;
+    }
+    // Vsync
+    constexpr int ADAPTIVE_SYNC = -1; //better sync
+    constexpr int VSYNC         = 1; //if adaptive sync is failed..
+    if (const auto result = SDL_GL_SetSwapInterval(ADAPTIVE_SYNC); result != 0)
+    {
+        SDL_GL_SetSwapInterval(VSYNC); //do classic vsync
+    }
+}
+
+void draw_imgui()
+{
+    PROFILE_GPU_SCOPE("imgui");
+    ImGui_ImplOpenGL3_NewFrame();
+    ImGui_ImplSDL2_NewFrame();
+    ImGui::NewFrame();
+    if (gShowFramePacing)
+    {
+        draw_frame_pacing_window();
+    }
+#ifdef DEVELOPER_VERSION
+    if (gShowProfiler)
+    {
+        Profiling::DrawOverlay(&gShowProfiler);
+    }
+#endif
+    ImGui::Render();
+    ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+    // imgui calls gl directly, so the state cache can't trust what it thinks is bound
+    OpenGL::InvalidateState();
+}
+
+void draw_frame_pacing_window()
+{
+    const auto& stats    = gFrameScheduler.GetStatistics();
+    const auto& history  = gFrameScheduler.GetFrameTimeHistory();
+    auto&       settings = gFrameScheduler.GetSettings();
+
+    ImGui::SetNextWindowPos(ImVec2(10.0f, 10.0f), ImGuiCond_FirstUseEver);
+    ImGui::Begin("Frame Pacing (F1)", &gShowFramePacing, ImGuiWindowFlags_AlwaysAutoResize);
+    ImGui::PlotHistogram(
+        "##frame_ms", history.data(), static_cast<int>(history.size()), static_cast<int>(gFrameScheduler.GetHistoryOffset()), "frame ms", 0.0f, 50.0f, ImVec2(300.0f, 80.0f));
+    ImGui::Text(
+        "frame %.2f ms | p50 %.2f p95 %.2f p99 %.2f", stats.FrameMs, gFrameScheduler.FrameTimePercentile(50.0), gFrameScheduler.FrameTimePercentile(95.0),
+        gFrameScheduler.FrameTimePercentile(99.0));
+    ImGui::Text("update %.3f ms (%d steps) | render %.3f ms | cap wait %.3f ms", stats.UpdateMs, stats.Updates, stats.RenderMs, stats.WaitMs);
+    ImGui::Text("dropped steps %llu", static_cast<unsigned long long>(stats.DroppedSteps));
+    const auto label = scene_label();
+    ImGui::Text("%.*s: %d | draw calls: %d", static_cast<int>(label.size()), label.data(), gFrameStats.Objects, gFrameStats.DrawCalls);
+    if (gFrameStats.QueuedChanges > 0)
+    {
+        ImGui::Text("state changes: %d as recorded, %d sorted", gFrameStats.QueuedChanges, gFrameStats.SortedChanges);
+    }
+    const auto gpu = OpenGL::GetResourceCounts();
+    ImGui::Text(
+        "gpu objects: %d buffers (%.1f MB, %.1f MB pooled) | %d vertex arrays | %d programs", gpu.Buffers, static_cast<double>(gpu.BufferCapacity) / (1024.0 * 1024.0),
+        static_cast<double>(gpu.PooledBytes) / (1024.0 * 1024.0), gpu.VertexArrays, gpu.Programs);
+
+    ImGui::Separator();
+    float update_hz = static_cast<float>(settings.UpdateHz);
+    if (ImGui::SliderFloat("update hz", &update_hz, 10.0f, 240.0f, "%.0f"))
+    {
+        settings.UpdateHz = static_cast<double>(update_hz);
+    }
+    ImGui::SliderInt("max catch-up steps", &settings.MaxCatchUpSteps, 1, 20);
+    float frame_cap = static_cast<float>(settings.FrameCapHz);
+    if (ImGui::SliderFloat("frame cap (0 = off)", &frame_cap, 0.0f, 500.0f, "%.0f"))
+    {
+        settings.FrameCapHz = static_cast<double>(frame_cap);
+    }
+#if !defined(__EMSCRIPTEN__)
+    // the browser always paces us to the display
+    if (ImGui::Checkbox("vsync", &gUseVsync))
+    {
+        apply_vsync();
+    }
+#endif
+    ImGui::End();
 }